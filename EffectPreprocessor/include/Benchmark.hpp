@@ -0,0 +1,38 @@
+#pragma once
+#include <filesystem>
+#include "WeaveUtils/GlobalUtils.hpp"
+#include "WeaveUtils/DynamicCollections.hpp"
+
+namespace Weave::Effects
+{
+    class ShaderLibBuilder;
+}
+
+/**
+ * @brief Effect source built by the benchmark.
+ */
+struct BenchmarkCase
+{
+    Weave::string name;
+    Weave::string path;
+    Weave::string src;
+};
+
+/**
+ * @brief Writes synthetic effects to the given directory and adds them to the benchmark corpus.
+ * Starting from a baseline effect, each series scales one of the number of variant flags, modes,
+ * helper functions or include depth while holding the others constant.
+ * @param dir: The directory the generated sources and their includes are written to.
+ * @param cases[out]: The corpus the generated effects are appended to.
+ */
+void GetSyntheticBenchmarkCases(const std::filesystem::path& dir, Weave::Vector<BenchmarkCase>& cases);
+
+/**
+ * @brief Builds each effect in the corpus the given number of times with profiling enabled and
+ * logs throughput, allocations per variant and time spent in each build stage. Allocations are
+ * only counted in builds with WFXC_COUNT_ALLOCS defined.
+ * @param builder: A configured library builder. Cleared between runs.
+ * @param cases: The benchmark corpus.
+ * @param runs: The number of times each effect is built.
+ */
+void RunBenchmark(Weave::Effects::ShaderLibBuilder& builder, const Weave::IDynamicArray<BenchmarkCase>& cases, Weave::uint runs);
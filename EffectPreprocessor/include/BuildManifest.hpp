@@ -0,0 +1,102 @@
+#pragma once
+#include <filesystem>
+#include <unordered_map>
+#include "WeaveUtils/GlobalUtils.hpp"
+#include "WeaveUtils/DynamicCollections.hpp"
+#include "WeaveUtils/Hash.hpp"
+#include "WeaveEffects/ShaderData.hpp"
+#include "WeaveEffects/ShaderLibImage.hpp"
+
+/**
+ * @brief Source file a repo was built from and the files it included, with the content hashes
+ * they had at the time.
+ */
+struct ManifestRepo
+{
+    Weave::string name;
+    Weave::string path;
+    Weave::Hash128 srcHash;
+    Weave::UniqueVector<std::pair<Weave::string, Weave::Hash128>> includes;
+};
+
+/**
+ * @brief Records the inputs of each repo in a library alongside a flat image of the library, so
+ * later builds of the same output can copy repos whose source and includes are unchanged instead
+ * of rebuilding them. Stored next to the output as "<output>.manifest".
+ */
+class BuildManifest
+{
+public:
+    MAKE_IMMOVABLE(BuildManifest)
+
+    BuildManifest();
+
+    /**
+     * @brief Returns the manifest path used for the given output library.
+     */
+    static std::filesystem::path GetManifestPath(const std::filesystem::path& output);
+
+    /**
+     * @brief Loads the manifest written for an earlier build. Missing, corrupt or outdated
+     * manifests, and manifests built with a different configuration, are ignored.
+     * @param path: The manifest path.
+     * @param configKey: Describes the build settings affecting the library. Must match the key
+     * the manifest was saved with.
+     * @return True if the manifest was loaded.
+     */
+    bool TryLoad(const std::filesystem::path& path, Weave::string_view configKey);
+
+    /**
+     * @brief Finds an unchanged repo from the loaded manifest. Repos are unchanged if their name,
+     * path and source match and every file they included still has the same contents.
+     * @return The index of the repo in the previous image, or -1 if it must be rebuilt.
+     */
+    Weave::uint TryGetRepo(Weave::string_view name, Weave::string_view path, const Weave::Hash128& srcHash);
+
+    /**
+     * @brief Returns the library image stored in the loaded manifest.
+     */
+    const Weave::Effects::ShaderLibImage& GetImage() const;
+
+    /**
+     * @brief Records a repo built from source for the next manifest.
+     * @param includes: The files included by the repo.
+     */
+    void AddRepo(Weave::string_view name, Weave::string_view path, const Weave::Hash128& srcHash,
+        const Weave::IDynamicArray<Weave::string>& includes);
+
+    /**
+     * @brief Records a repo copied from the loaded manifest for the next manifest.
+     * @param prevIndex: The index returned by TryGetRepo().
+     */
+    void AddPrevRepo(Weave::uint prevIndex);
+
+    /**
+     * @brief Writes the recorded repos and a flat image of the library to the given path, then
+     * starts a new manifest. The repos in the library must match the recorded repos in order.
+     * @throws EffectParseException If the repo count doesn't match.
+     */
+    void Save(const std::filesystem::path& path, Weave::string_view configKey,
+        const Weave::Effects::ShaderLibDef::Handle& lib);
+
+    /**
+     * @brief Discards the loaded manifest and any recorded repos.
+     */
+    void Clear();
+
+private:
+    Weave::UniqueVector<ManifestRepo> prevRepos;
+    Weave::Vector<Weave::byte> prevImageBuf;
+    Weave::Effects::ShaderLibImage prevImage;
+
+    Weave::UniqueVector<ManifestRepo> nextRepos;
+    // Include path -> content hash, shared by repos checked during the same run
+    std::unordered_map<Weave::string, Weave::Hash128> fileHashes;
+    Weave::Vector<Weave::byte> writeBuf;
+
+    /**
+     * @brief Returns the content hash of the given file, or a null hash if it can't be read.
+     * Hashes are cached for the lifetime of the manifest.
+     */
+    const Weave::Hash128& GetFileHash(const Weave::string& path);
+};
@@ -0,0 +1,9 @@
+#pragma once
+
+/**
+ * @brief Builds a built-in effect through IShaderCompiler with the reflection-only backend and
+ * verifies the registered metadata. The effect is built twice with different thread counts,
+ * and both libraries must be identical. Doesn't require the Windows SDK.
+ * @throws EffectParseException If any check fails.
+ */
+void RunCompilerCheck();
@@ -41,16 +41,111 @@ OPTIONS:
                       Sets the target shader feature level (e.g., '5_0', '6_0').
                       [Default: '5_0']
 
+    --threads <count>
+                      Number of threads used to build shader variants and
+                      the shaders within them in parallel. Use 0 for all
+                      available hardware threads. Output is identical for
+                      any thread count.
+                      [Default: 1]
+
+    --jobs <count>
+                      Number of input files built at the same time, each with
+                      its own builder. The --threads variant threads are split
+                      evenly between jobs, with at least one per job. Use 0
+                      for all available hardware threads. Merged output is
+                      identical for any job count. Without --merge, inputs
+                      that would be written to the same output file are
+                      rejected. Ignored when profiling.
+                      [Default: 1]
+
+    --cache-dir <path>
+                      Caches precompiled shaders in the given directory. Shaders
+                      whose generated source and compiler settings are unchanged
+                      are loaded from the cache instead of being recompiled. The
+                      directory is created if it doesn't exist.
+                      [Default: Disabled]
+
+    --compiler <d3d11|reflect>
+                      Selects the shader compiler backend.
+                      - 'd3d11': Compiles with the D3D11 shader compiler.
+                        Requires Windows.
+                      - 'reflect': Emits placeholder bytecode and derives
+                        metadata from the parsed source without compiling.
+                        Output can't be loaded by a renderer. Intended for
+                        profiling and testing the pipeline without a GPU
+                        toolchain.
+                      [Default: 'd3d11' on Windows, 'reflect' elsewhere]
+
+    --full-preprocess
+                      Runs the preprocessor over the whole source for every
+                      variant. By default, includes are loaded once and variants
+                      that only differ in flags or modes the source never tests
+                      reuse an earlier variant's output and compiled shaders.
+                      Output is identical either way.
+
+    --incremental
+                      Saves a manifest next to each output library recording the
+                      contents of every input and the files it includes. Later
+                      runs with the same settings copy inputs whose source and
+                      includes are unchanged from the previous build instead of
+                      rebuilding them. Manifests are named '<output>.manifest'.
+                      [Default: Disabled]
+
+    --profile <path>
+                      Records the time spent in each build stage (preprocessing,
+                      deduplication, block analysis, parsing, HLSL generation,
+                      compilation and registration) for every variant, along
+                      with block, token, symbol and generated byte counts,
+                      and shader fingerprint and registry hit/miss counts.
+                      A summary table is logged and a Chrome trace is
+                      written to <path>, which can be opened in
+                      chrome://tracing or Perfetto.
+                      [Default: Disabled]
+
+    --benchmark <runs>
+                      Builds each input file and a generated corpus of synthetic
+                      effects <runs> times instead of writing libraries. The
+                      synthetic effects scale the number of flags, modes,
+                      functions and include depth. Reports variants/s, MB/s and
+                      allocations per variant for each input, followed by the
+                      time and throughput of each build stage. Allocations are
+                      only counted when wfxc is built with WFXC_COUNT_ALLOCS
+                      defined. Input files are optional in this mode.
+                      [Default: Disabled]
+
+    --check-compiler
+                      Builds a built-in effect with the 'reflect' compiler
+                      backend, once on one thread and once on all threads, and
+                      checks the reflected IO layouts, constant buffers,
+                      resource slots and thread group sizes, and that both
+                      libraries are identical. Runs on any platform. Input files
+                      aren't needed and no libraries are written.
+
 -m, --merge           Merge all processed input files into a single output library
-                      file specified by --output. If not set (default), each
-                      input file produces a separate output file.
+                      file specified by --output. Each file is built on its own
+                      and copied into the library in input order. If not set
+                      (default), each input file produces a separate output file.
 
 -h, --header          Output the library as a C++ header file (.hpp) containing
-                      a 'constexpr unsigned char' array, instead of a raw
+                      a 'constexpr uint64_t' array, instead of a raw
                       binary file (.bin). The C++ variable name is generated
                       based on the output filename (e.g., 's_FX_MyLibrary').
                       [Default: Outputs binary .bin file]
 
+    --flat            Output the library in a flat image layout instead of the
+                      default serialized format. Flat libraries are used in place
+                      without deserialization, either memory mapped from a .bin
+                      file or directly from a header array (-h). Load with
+                      ShaderLibImage or MappedFile instead of GetDeserializedLibDef.
+                      Name lookup tables are generated ahead of time, so loading
+                      a flat library builds no runtime maps.
+                      [Default: Disabled]
+
+    --compress        LZ4 compresses shader bytecode in the output library.
+                      Binaries are decompressed individually the first time a
+                      shader using them is created. Implies --flat.
+                      [Default: Disabled]
+
 -d, --debug           Enable debug information during shader compilation. This
                       may include shader symbols for debugging tools but can
                       increase file size and potentially impact runtime performance.
@@ -72,6 +167,20 @@ EXAMPLES:
     # Compile a single file with debugging enabled to a specific output file
     wfxc --input test.wfx --output test_debug.bin --debug
 
+    # Rebuild a merged library, only recompiling inputs that changed since the
+    # last incremental build
+    wfxc --input "src_shaders/*.wfx" --output libs/shader_bundle.bin --merge --incremental
+
+    # Compile all .wfx files in 'src_shaders/' into separate libraries, building
+    # up to 8 files at a time
+    wfxc --input "src_shaders/*.wfx" --output libs/ --jobs 8
+
+    # Benchmark the built-in shaders and the synthetic corpus over 5 runs
+    wfxc --input DefaultShaders.rpfx --benchmark 5 --compiler reflect
+
+    # Check the compiler backend pipeline without the Windows SDK
+    wfxc --check-compiler
+
 EXIT CODES:
      0: Success
      1: Unknown error occurred
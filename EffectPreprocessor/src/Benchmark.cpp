@@ -0,0 +1,347 @@
+#include <atomic>
+#include <cstdlib>
+#include <format>
+#include <fstream>
+#include <new>
+#include <set>
+#include <sstream>
+#include "WeaveEffects/EffectParseException.hpp"
+#include "WeaveUtils/Logger.hpp"
+#include "WeaveUtils/Stopwatch.hpp"
+#include "WeaveEffects/ShaderLibBuilder.hpp"
+#include "WeaveEffects/ShaderLibBuilder/BuildProfiler.hpp"
+#include "Benchmark.hpp"
+
+namespace fs = std::filesystem;
+
+using namespace Weave;
+using namespace Weave::Effects;
+
+//-----------------------------------------------------------------------------
+// Allocation Counting
+//-----------------------------------------------------------------------------
+
+/*
+ * Replacing the global allocation functions affects every allocation made by wfxc, benchmarking
+ * or not, so allocation counting is only compiled in when WFXC_COUNT_ALLOCS is defined.
+ */
+#ifdef WFXC_COUNT_ALLOCS
+static constexpr bool s_IsCountingAllocs = true;
+
+// Number of calls to global operator new made by the process
+static std::atomic<ulong> s_AllocCount(0);
+
+/*
+ * Global allocation functions are replaced to count heap allocations made while building. The
+ * remaining forms of new and delete are implemented by the standard library in terms of these.
+ */
+void* operator new(size_t size)
+{
+    s_AllocCount.fetch_add(1, std::memory_order_relaxed);
+    void* pMem = std::malloc(size > 0 ? size : 1);
+
+    if (pMem == nullptr)
+        throw std::bad_alloc();
+
+    return pMem;
+}
+
+void operator delete(void* pMem) noexcept { std::free(pMem); }
+
+static ulong GetAllocCount() { return s_AllocCount.load(std::memory_order_relaxed); }
+#else
+static constexpr bool s_IsCountingAllocs = false;
+
+static ulong GetAllocCount() { return 0; }
+#endif
+
+//-----------------------------------------------------------------------------
+// Synthetic Corpus
+//-----------------------------------------------------------------------------
+
+/**
+ * @brief Size parameters of a generated effect.
+ */
+struct SyntheticParams
+{
+    uint flagCount;
+    uint modeCount;
+    uint funcCount;
+    uint includeDepth;
+
+    auto operator<=>(const SyntheticParams&) const = default;
+};
+
+// Every series starts from and returns to the same baseline
+static constexpr SyntheticParams s_SynthBaseline = { 2, 2, 16, 1 };
+
+static constexpr uint s_SynthFlagCounts[] = { 0, 2, 4, 6 };
+static constexpr uint s_SynthModeCounts[] = { 0, 2, 8, 32 };
+static constexpr uint s_SynthFuncCounts[] = { 4, 16, 64, 256 };
+static constexpr uint s_SynthIncludeDepths[] = { 0, 1, 4, 16 };
+
+/**
+ * @brief Writes a helper function whose body depends on a variant flag and mode, and that calls
+ * the previous helper, if any.
+ */
+static void WriteSyntheticFunc(std::ostream& dst, const SyntheticParams& params, string_view prefix, uint index)
+{
+    dst << "float " << prefix << "Func" << index << "(float x)\n{\n";
+
+    if (params.flagCount > 0)
+        dst << "#ifdef FLAG_" << (index % params.flagCount) << "\n\tx = x * 2.0f + 1.0f;\n#endif\n";
+
+    if (params.modeCount > 1)
+        dst << "#if defined(MODE_" << (index % params.modeCount) << ")\n\tx = sin(x);\n#endif\n";
+
+    if (index > 0)
+        dst << "\treturn " << prefix << "Func" << (index - 1) << "(x) * 0.5f + " << index << ".0f;\n}\n\n";
+    else
+        dst << "\treturn x * 0.5f;\n}\n\n";
+}
+
+/**
+ * @brief Writes a synthetic effect and its include chain to disk and returns it as a benchmark case.
+ */
+static BenchmarkCase GetSyntheticCase(const fs::path& dir, const SyntheticParams& params)
+{
+    BenchmarkCase benchCase;
+    benchCase.name = std::format("Synth_F{}_M{}_N{}_I{}",
+        params.flagCount, params.modeCount, params.funcCount, params.includeDepth);
+
+    // Each include defines a helper and includes the next level
+    for (uint i = 0; i < params.includeDepth; i++)
+    {
+        const fs::path includePath = dir / std::format("{}_Inc{}.hlsli", benchCase.name, i);
+        std::ofstream includeFile(includePath, std::ios::binary);
+        FX_CHECK_MSG(includeFile.is_open(), "Failed to write benchmark include: {}", includePath.string());
+
+        includeFile << "#ifndef INC_" << i << "\n#define INC_" << i << "\n\n";
+
+        if ((i + 1) < params.includeDepth)
+            includeFile << "#include \"" << benchCase.name << "_Inc" << (i + 1) << ".hlsli\"\n\n";
+
+        WriteSyntheticFunc(includeFile, params, std::format("Inc{}", i), 0);
+        includeFile << "#endif\n";
+    }
+
+    std::ostringstream src;
+
+    if (params.flagCount > 0)
+    {
+        src << "#pragma shader flags(";
+
+        for (uint i = 0; i < params.flagCount; i++)
+            src << (i > 0 ? ", " : "") << "FLAG_" << i;
+
+        src << ")\n";
+    }
+
+    if (params.modeCount > 0)
+    {
+        src << "#pragma shader modes(";
+
+        for (uint i = 0; i < params.modeCount; i++)
+            src << (i > 0 ? ", " : "") << "MODE_" << i;
+
+        src << ")\n";
+    }
+
+    if (params.includeDepth > 0)
+        src << "#include \"" << benchCase.name << "_Inc0.hlsli\"\n";
+
+    src << "\nfloat4 Tint;\nfloat2 Scale;\n\n";
+
+    for (uint i = 0; i < params.funcCount; i++)
+        WriteSyntheticFunc(src, params, "", i);
+
+    const uint lastFunc = std::max(params.funcCount, 1u) - 1;
+    string includeCalls;
+
+    for (uint i = 0; i < params.includeDepth; i++)
+        includeCalls += std::format(" + Inc{}Func0(v)", i);
+
+    src << "vertex VS_Synth\n{\n"
+        "\tfloat4 VS_Synth(float2 pos : Position) : SV_Position\n\t{\n"
+        "\t\treturn float4(pos * Scale, 0.0f, 1.0f);\n\t}\n}\n\n";
+
+    src << "pixel PS_Synth\n{\n"
+        "\tfloat4 PS_Synth(float4 pos : SV_Position) : SV_Target\n\t{\n"
+        "\t\tconst float v = pos.x;\n";
+
+    if (params.funcCount > 0)
+        src << "\t\treturn Tint * (Func" << lastFunc << "(v)" << includeCalls << ");\n\t}\n}\n\n";
+    else
+        src << "\t\treturn Tint * (v" << includeCalls << ");\n\t}\n}\n\n";
+
+    src << "effect Synth\n{\n\tVertex = VS_Synth;\n\tPixel = PS_Synth;\n}\n";
+
+    const fs::path srcPath = dir / (benchCase.name + ".wfx");
+    benchCase.path = srcPath.string();
+    benchCase.src = src.str();
+
+    std::ofstream srcFile(srcPath, std::ios::binary);
+    FX_CHECK_MSG(srcFile.is_open(), "Failed to write benchmark source: {}", benchCase.path);
+    srcFile << benchCase.src;
+
+    return benchCase;
+}
+
+void GetSyntheticBenchmarkCases(const fs::path& dir, Vector<BenchmarkCase>& cases)
+{
+    fs::create_directories(dir);
+    std::set<SyntheticParams> paramSet;
+    Vector<SyntheticParams> paramList;
+
+    const auto AddParams = [&](const SyntheticParams& params)
+    {
+        if (paramSet.emplace(params).second)
+            paramList.EmplaceBack(params);
+    };
+
+    for (uint count : s_SynthFlagCounts)
+        AddParams({ count, s_SynthBaseline.modeCount, s_SynthBaseline.funcCount, s_SynthBaseline.includeDepth });
+
+    for (uint count : s_SynthModeCounts)
+        AddParams({ s_SynthBaseline.flagCount, count, s_SynthBaseline.funcCount, s_SynthBaseline.includeDepth });
+
+    for (uint count : s_SynthFuncCounts)
+        AddParams({ s_SynthBaseline.flagCount, s_SynthBaseline.modeCount, count, s_SynthBaseline.includeDepth });
+
+    for (uint depth : s_SynthIncludeDepths)
+        AddParams({ s_SynthBaseline.flagCount, s_SynthBaseline.modeCount, s_SynthBaseline.funcCount, depth });
+
+    for (const SyntheticParams& params : paramList)
+        cases.EmplaceBack(GetSyntheticCase(dir, params));
+}
+
+//-----------------------------------------------------------------------------
+// Benchmark Runner
+//-----------------------------------------------------------------------------
+
+/**
+ * @brief Returns a rate per second, or zero if no time elapsed.
+ */
+static double GetRate(double value, slong timeNS) { return (timeNS > 0) ? (value / GetTimeNStoS(timeNS)) : 0.0; }
+
+/**
+ * @brief Logs corpus-wide time and throughput for each build stage.
+ */
+static void LogStageThroughput(const BuildStageTotals (&stages)[(uint)BuildStages::Count])
+{
+    constexpr double mb = 1024.0 * 1024.0;
+    const auto GetStage = [&](BuildStages stage) -> const BuildStageTotals& { return stages[(uint)stage]; };
+
+    const BuildStageTotals& preproc = GetStage(BuildStages::Preprocess);
+    const BuildStageTotals& analyze = GetStage(BuildStages::Analyze);
+    const BuildStageTotals& parse = GetStage(BuildStages::Parse);
+    const BuildStageTotals& generate = GetStage(BuildStages::Generate);
+    const BuildStageTotals& compile = GetStage(BuildStages::Compile);
+    const BuildStageTotals& commit = GetStage(BuildStages::Commit);
+
+    const string rates[(uint)BuildStages::Count]
+    {
+        std::format("{:.2f} MB/s output", GetRate(preproc.counters[0] / mb, preproc.timeNS)),
+        string(),
+        std::format("{:.2f} MB/s, {:.0f} blocks/s", GetRate(analyze.counters[1] / mb, analyze.timeNS),
+            GetRate((double)analyze.counters[0], analyze.timeNS)),
+        std::format("{:.0f} tokens/s, {:.0f} symbols/s", GetRate((double)parse.counters[0], parse.timeNS),
+            GetRate((double)parse.counters[1], parse.timeNS)),
+        std::format("{:.2f} MB/s HLSL", GetRate(generate.counters[0] / mb, generate.timeNS)),
+        std::format("{:.2f} MB/s bytecode", GetRate(compile.counters[0] / mb, compile.timeNS)),
+        std::format("{:.0f} registry lookups/s", GetRate((double)(commit.counters[0] + commit.counters[1]), commit.timeNS))
+    };
+
+    WV_LOG_INFO() << std::format("  {:<11}{:>8}{:>12}  {}", "Stage", "Calls", "Total ms", "Throughput");
+
+    for (uint i = 0; i < (uint)BuildStages::Count; i++)
+    {
+        const BuildStageTotals& stage = stages[i];
+
+        if (stage.count > 0)
+        {
+            WV_LOG_INFO() << std::format("  {:<11}{:>8}{:>12.2f}  {}",
+                BuildProfiler::GetStageName((BuildStages)i), stage.count, GetTimeNStoMS(stage.timeNS), rates[i]);
+        }
+    }
+}
+
+void RunBenchmark(ShaderLibBuilder& builder, const IDynamicArray<BenchmarkCase>& cases, uint runs)
+{
+    FX_CHECK_MSG(runs > 0, "Benchmark run count must be greater than zero");
+    FX_CHECK_MSG(!cases.IsEmpty(), "No benchmark inputs");
+
+    struct CaseResult
+    {
+        uint variantCount;
+        slong timeNS;
+        ulong allocCount;
+    };
+
+    Vector<CaseResult> results;
+    BuildStageTotals stages[(uint)BuildStages::Count] = {};
+    Stopwatch timer;
+    builder.SetProfiling(true);
+
+    for (const BenchmarkCase& benchCase : cases)
+    {
+        CaseResult& result = results.EmplaceBack(CaseResult{});
+        WV_LOG_INFO() << "Benchmarking: " << benchCase.name;
+
+        for (uint run = 0; run < runs; run++)
+        {
+            builder.Clear();
+            builder.ClearProfile();
+
+            const ulong allocStart = GetAllocCount();
+            timer.Restart();
+            builder.AddRepo(benchCase.name, benchCase.path, benchCase.src);
+            timer.Stop();
+
+            result.allocCount += GetAllocCount() - allocStart;
+            result.timeNS += timer.GetElapsedNS();
+            result.variantCount = (uint)(*builder.GetDefinition().pRepos)[0].variants.GetLength();
+
+            // Stage totals are reset before each run
+            for (uint i = 0; i < (uint)BuildStages::Count; i++)
+            {
+                const BuildStageTotals runStage = builder.GetProfiler()->GetStageTotals((BuildStages)i);
+                BuildStageTotals& stage = stages[i];
+                stage.count += runStage.count;
+                stage.timeNS += runStage.timeNS;
+                stage.maxNS = std::max(stage.maxNS, runStage.maxNS);
+
+                for (uint j = 0; j < g_BuildCounterCount; j++)
+                    stage.counters[j] += runStage.counters[j];
+            }
+        }
+    }
+
+    builder.Clear();
+    builder.SetProfiling(false);
+
+    constexpr double mb = 1024.0 * 1024.0;
+    WV_LOG_INFO() << "Benchmark results (" << runs << " runs, " << builder.GetThreadCount() << " threads):";
+    WV_LOG_INFO() << std::format("  {:<28}{:>9}{:>10}{:>12}{:>12}{:>10}{:>16}",
+        "Input", "Variants", "Src KB", "ms/run", "Variants/s", "MB/s", "Allocs/variant");
+
+    for (uint i = 0; i < (uint)cases.GetLength(); i++)
+    {
+        const BenchmarkCase& benchCase = cases[i];
+        const CaseResult& result = results[i];
+        const double variantRuns = (double)result.variantCount * runs;
+
+        const string allocs = s_IsCountingAllocs ? 
+            std::format("{:.1f}", (variantRuns > 0) ? (result.allocCount / variantRuns) : 0.0) : string("-");
+
+        WV_LOG_INFO() << std::format("  {:<28}{:>9}{:>10.1f}{:>12.3f}{:>12.1f}{:>10.3f}{:>16}",
+            benchCase.name, result.variantCount, benchCase.src.size() / 1024.0,
+            GetTimeNStoMS(result.timeNS) / runs, GetRate(variantRuns, result.timeNS),
+            GetRate(((double)benchCase.src.size() * runs) / mb, result.timeNS), allocs);
+    }
+
+    if (!s_IsCountingAllocs)
+        WV_LOG_INFO() << "Allocation counts require building wfxc with WFXC_COUNT_ALLOCS defined";
+
+    LogStageThroughput(stages);
+}
@@ -0,0 +1,324 @@
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include "WeaveEffects/EffectParseException.hpp"
+#include "WeaveUtils/Logger.hpp"
+#include "BuildManifest.hpp"
+
+namespace fs = std::filesystem;
+
+using namespace Weave;
+using namespace Weave::Effects;
+
+/**
+ * @brief Fixed size header at the start of every manifest. Followed by the configuration key,
+ * the repo records and the library image.
+ */
+struct ManifestHeader
+{
+    uint magic;
+    uint version;
+    uint repoCount;
+    uint configLength;
+    ulong imageSize;
+    // Hash of everything following the header
+    Hash128 checksum;
+};
+
+// "WFXM"
+static constexpr uint s_ManifestMagic = 0x4D584657u;
+// Incremented when the manifest layout changes
+static constexpr uint s_ManifestVersion = 1u;
+
+//-----------------------------------------------------------------------------
+// Serialization Helpers
+//-----------------------------------------------------------------------------
+
+static void WriteBytes(Vector<byte>& dst, const void* pSrc, size_t size)
+{
+    const size_t start = dst.GetLength();
+    dst.Resize(start + size);
+
+    if (size > 0)
+        std::memcpy(dst.GetData() + start, pSrc, size);
+}
+
+template<typename T> requires std::is_trivially_copyable_v<T>
+static void WriteValue(Vector<byte>& dst, const T& value) { WriteBytes(dst, &value, sizeof(T)); }
+
+static void WriteString(Vector<byte>& dst, string_view str)
+{
+    WriteValue(dst, (uint)str.size());
+    WriteBytes(dst, str.data(), str.size());
+}
+
+/**
+ * @brief Bounds checked sequential reader over a loaded manifest. Reads past the end of the data
+ * fail and leave the reader in a failed state instead of throwing.
+ */
+class ManifestReader
+{
+public:
+    explicit ManifestReader(string_view data) :
+        data(data),
+        pos(0),
+        isValid(true)
+    { }
+
+    bool GetIsValid() const { return isValid; }
+
+    string_view ReadBytes(size_t size)
+    {
+        if (!isValid || size > (data.size() - pos))
+        {
+            isValid = false;
+            return {};
+        }
+
+        const string_view bytes = data.substr(pos, size);
+        pos += size;
+        return bytes;
+    }
+
+    template<typename T> requires std::is_trivially_copyable_v<T>
+    T ReadValue()
+    {
+        T value = {};
+        const string_view bytes = ReadBytes(sizeof(T));
+
+        if (isValid)
+            std::memcpy(&value, bytes.data(), sizeof(T));
+
+        return value;
+    }
+
+    string_view ReadString() { return ReadBytes(ReadValue<uint>()); }
+
+private:
+    string_view data;
+    size_t pos;
+    bool isValid;
+};
+
+//-----------------------------------------------------------------------------
+// BuildManifest
+//-----------------------------------------------------------------------------
+
+BuildManifest::BuildManifest() = default;
+
+fs::path BuildManifest::GetManifestPath(const fs::path& output)
+{
+    fs::path manifestPath = output;
+    manifestPath += ".manifest";
+    return manifestPath;
+}
+
+bool BuildManifest::TryLoad(const fs::path& path, string_view configKey)
+{
+    Clear();
+
+    std::ifstream file(path, std::ios::binary);
+
+    if (!file.is_open())
+        return false;
+
+    std::stringstream fileBuf;
+    fileBuf << file.rdbuf();
+    const string fileData = fileBuf.str();
+
+    ManifestReader reader(fileData);
+    const ManifestHeader header = reader.ReadValue<ManifestHeader>();
+    const string_view body = string_view(fileData).substr(std::min(fileData.size(), sizeof(ManifestHeader)));
+
+    if (!reader.GetIsValid() || header.magic != s_ManifestMagic || header.version != s_ManifestVersion ||
+        GetHash128(body) != header.checksum)
+    {
+        WV_LOG_WARN() << "Ignoring invalid build manifest: " << path;
+        return false;
+    }
+
+    if (reader.ReadBytes(header.configLength) != configKey)
+    {
+        WV_LOG_INFO() << "Build settings changed. Ignoring build manifest: " << path;
+        return false;
+    }
+
+    prevRepos.Reserve(header.repoCount);
+
+    for (uint i = 0; i < header.repoCount && reader.GetIsValid(); i++)
+    {
+        ManifestRepo& repo = prevRepos.EmplaceBack();
+        repo.name = reader.ReadString();
+        repo.path = reader.ReadString();
+        repo.srcHash = reader.ReadValue<Hash128>();
+
+        const uint includeCount = reader.ReadValue<uint>();
+
+        for (uint j = 0; j < includeCount && reader.GetIsValid(); j++)
+        {
+            const string_view includePath = reader.ReadString();
+            repo.includes.EmplaceBack(string(includePath), reader.ReadValue<Hash128>());
+        }
+    }
+
+    // Copied to its own buffer to satisfy image alignment
+    const string_view imageData = reader.ReadBytes(header.imageSize);
+
+    if (reader.GetIsValid())
+    {
+        prevImageBuf.Resize(imageData.size());
+        std::memcpy(prevImageBuf.GetData(), imageData.data(), imageData.size());
+
+        try
+        {
+            prevImage = ShaderLibImage(string_view(reinterpret_cast<const char*>(prevImageBuf.GetData()), prevImageBuf.GetLength()));
+
+            if (prevImage.GetRepoCount() == prevRepos.GetLength())
+                return true;
+        }
+        catch (const EffectParseException&)
+        { }
+    }
+
+    WV_LOG_WARN() << "Ignoring invalid build manifest: " << path;
+    Clear();
+    return false;
+}
+
+uint BuildManifest::TryGetRepo(string_view name, string_view path, const Hash128& srcHash)
+{
+    for (uint i = 0; i < prevRepos.GetLength(); i++)
+    {
+        const ManifestRepo& repo = prevRepos[i];
+
+        if (repo.name != name || repo.path != path)
+            continue;
+
+        if (repo.srcHash != srcHash)
+            return -1;
+
+        for (const auto& [includePath, includeHash] : repo.includes)
+        {
+            if (GetFileHash(includePath) != includeHash)
+            {
+                WV_LOG_INFO() << "Include changed: " << includePath;
+                return -1;
+            }
+        }
+
+        return i;
+    }
+
+    return -1;
+}
+
+const ShaderLibImage& BuildManifest::GetImage() const { return prevImage; }
+
+void BuildManifest::AddRepo(string_view name, string_view path, const Hash128& srcHash,
+    const IDynamicArray<string>& includes)
+{
+    ManifestRepo& repo = nextRepos.EmplaceBack();
+    repo.name = name;
+    repo.path = path;
+    repo.srcHash = srcHash;
+    repo.includes.Reserve(includes.GetLength());
+
+    for (const string& includePath : includes)
+        repo.includes.EmplaceBack(includePath, GetFileHash(includePath));
+}
+
+void BuildManifest::AddPrevRepo(uint prevIndex)
+{
+    const ManifestRepo& prev = prevRepos[prevIndex];
+    ManifestRepo& repo = nextRepos.EmplaceBack();
+    repo.name = prev.name;
+    repo.path = prev.path;
+    repo.srcHash = prev.srcHash;
+    repo.includes.Reserve(prev.includes.GetLength());
+
+    for (const auto& include : prev.includes)
+        repo.includes.EmplaceBack(include);
+}
+
+void BuildManifest::Save(const fs::path& path, string_view configKey, const ShaderLibDef::Handle& lib)
+{
+    FX_CHECK_MSG(lib.pRepos != nullptr && lib.pRepos->GetLength() == nextRepos.GetLength(),
+        "Build manifest repos do not match the library");
+
+    // Stored after the repo records
+    static thread_local Vector<byte> imageBuf;
+    imageBuf.Clear();
+    WriteShaderLibImage(lib, imageBuf);
+
+    writeBuf.Clear();
+    WriteValue(writeBuf, ManifestHeader{});
+    WriteBytes(writeBuf, configKey.data(), configKey.size());
+
+    for (const ManifestRepo& repo : nextRepos)
+    {
+        WriteString(writeBuf, repo.name);
+        WriteString(writeBuf, repo.path);
+        WriteValue(writeBuf, repo.srcHash);
+        WriteValue(writeBuf, (uint)repo.includes.GetLength());
+
+        for (const auto& [includePath, includeHash] : repo.includes)
+        {
+            WriteString(writeBuf, includePath);
+            WriteValue(writeBuf, includeHash);
+        }
+    }
+
+    WriteBytes(writeBuf, imageBuf.GetData(), imageBuf.GetLength());
+
+    const string_view body(reinterpret_cast<const char*>(writeBuf.GetData()) + sizeof(ManifestHeader),
+        writeBuf.GetLength() - sizeof(ManifestHeader));
+    const ManifestHeader header
+    {
+        .magic = s_ManifestMagic,
+        .version = s_ManifestVersion,
+        .repoCount = (uint)nextRepos.GetLength(),
+        .configLength = (uint)configKey.size(),
+        .imageSize = (ulong)imageBuf.GetLength(),
+        .checksum = GetHash128(body)
+    };
+    std::memcpy(writeBuf.GetData(), &header, sizeof(header));
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file.write(reinterpret_cast<const char*>(writeBuf.GetData()), writeBuf.GetLength());
+    file.flush();
+
+    // A missing manifest only disables incremental builds, so failures aren't fatal
+    if (file.good())
+        WV_LOG_INFO() << "Wrote build manifest: " << path;
+    else
+        WV_LOG_WARN() << "Failed to write build manifest: " << path;
+
+    nextRepos.Clear();
+}
+
+void BuildManifest::Clear()
+{
+    prevRepos.Clear();
+    prevImageBuf.Clear();
+    prevImage = ShaderLibImage();
+    nextRepos.Clear();
+}
+
+const Hash128& BuildManifest::GetFileHash(const string& path)
+{
+    const auto [it, isNew] = fileHashes.try_emplace(path, Hash128{});
+
+    if (isNew)
+    {
+        std::ifstream file(path, std::ios::binary);
+
+        if (file.is_open())
+        {
+            std::stringstream fileBuf;
+            fileBuf << file.rdbuf();
+            it->second = GetHash128(fileBuf.view());
+        }
+    }
+
+    return it->second;
+}
@@ -0,0 +1,161 @@
+#include <cstring>
+#include <memory>
+#include "WeaveEffects/EffectParseException.hpp"
+#include "WeaveUtils/Logger.hpp"
+#include "WeaveEffects/ShaderLibBuilder.hpp"
+#include "WeaveEffects/ShaderLibImage.hpp"
+#include "WeaveEffects/ShaderLibMap.hpp"
+#include "WeaveEffects/ShaderLibBuilder/ShaderCompiler.hpp"
+#include "CompilerCheck.hpp"
+
+using namespace Weave;
+using namespace Weave::Effects;
+
+/**
+ * @brief Effect covering IO signatures, loose globals, resources of each register class and
+ * compute thread group sizes.
+ */
+static constexpr string_view s_CheckEffectSrc = R"WFX(
+float2 Scale;
+float2 Offset;
+
+vertex VS_Check
+{
+    float4 VS_Check(float2 pos : Position) : SV_Position
+    {
+        return float4(pos * Scale + Offset, 0.0f, 1.0f);
+    }
+}
+
+pixel PS_Check
+{
+    Texture2D tex;
+    SamplerState samp;
+
+    float4 PS_Check(float4 pos : SV_Position) : SV_Target
+    {
+        return tex.Sample(samp, pos.xy * Scale);
+    }
+}
+
+compute CS_Check
+{
+    RWTexture2D<float4> dst;
+
+    [numthreads(8, 4, 1)]
+    void CS_Check(uint3 id : SV_DispatchThreadID)
+    {
+        dst[id.xy] = float4(Scale, Offset);
+    }
+}
+
+effect Check
+{
+    Vertex = VS_Check;
+    Pixel = PS_Check;
+}
+)WFX";
+
+/**
+ * @brief Builds the check effect with the reflection-only backend and writes it as a flat image.
+ */
+static void GetCheckImage(uint threadCount, Vector<byte>& image)
+{
+    ShaderLibBuilder builder;
+    builder.SetThreadCount(threadCount);
+    builder.SetCompiler(std::unique_ptr<IShaderCompiler>(new ShaderCompilerReflect()));
+
+    const IShaderCompiler& compiler = builder.GetCompiler();
+    FX_CHECK_MSG(!compiler.GetCompilerVersion().empty(), "Compiler check: backend has no version string");
+
+    builder.AddRepo("CompilerCheck", "CompilerCheck.wfx", s_CheckEffectSrc);
+    WriteShaderLibImage(builder.GetDefinition(), image);
+}
+
+/**
+ * @brief Returns the default variant of the shader with the given name.
+ */
+static ShaderDefHandle GetCheckShader(const ShaderLibMap& lib, string_view name)
+{
+    uint nameID;
+    FX_CHECK_MSG(lib.GetStringMap().TryGetStringID(name, nameID), "Compiler check: {} missing", name);
+
+    const uint vID = lib.TryGetDefaultShaderVariant(nameID);
+    const uint shaderID = lib.TryGetShaderID(nameID, vID);
+    FX_CHECK_MSG(shaderID != -1, "Compiler check: {} has no default variant", name);
+
+    return lib.GetShader(shaderID);
+}
+
+/**
+ * @brief Checks the name, type and slot of a resource in a shader's resource group.
+ */
+static void CheckResource(const ResourceGroupHandle& resources, uint index, string_view name, ShaderTypes type, uint slot)
+{
+    FX_CHECK_MSG(index < resources.GetLength(), "Compiler check: resource {} missing", name);
+    const ResourceDef& res = resources[index];
+
+    FX_CHECK_MSG(resources.GetStringMap().GetString(res.stringID) == name && res.GetHasFlags(type) && res.slot == slot,
+        "Compiler check: resource {} has an unexpected name, type or slot", name);
+}
+
+void RunCompilerCheck()
+{
+    Vector<byte> image, parallelImage;
+    GetCheckImage(1, image);
+    GetCheckImage(0, parallelImage);
+
+    FX_CHECK_MSG(image.GetLength() == parallelImage.GetLength() &&
+        memcmp(image.GetData(), parallelImage.GetData(), image.GetLength()) == 0,
+        "Compiler check: output differs between thread counts");
+
+    const ShaderLibImage libImage(string_view(reinterpret_cast<const char*>(image.GetData()), image.GetLength()));
+    const ShaderLibMap lib(libImage);
+
+    // Vertex IO signatures and loose globals
+    {
+        const ShaderDefHandle vs = GetCheckShader(lib, "VS_Check");
+        FX_CHECK_MSG(vs.GetStage() == ShadeStages::Vertex, "Compiler check: VS_Check has the wrong stage");
+
+        const std::optional<IOLayoutHandle> inLayout = vs.GetInLayout();
+        FX_CHECK_MSG(inLayout.has_value() && inLayout->GetLength() == 1, "Compiler check: VS_Check input layout mismatch");
+        FX_CHECK_MSG(inLayout->GetStringMap().GetString((*inLayout)[0].semanticID) == "Position" &&
+            (*inLayout)[0].componentCount == 2, "Compiler check: VS_Check input element mismatch");
+
+        const std::optional<IOLayoutHandle> outLayout = vs.GetOutLayout();
+        FX_CHECK_MSG(outLayout.has_value() && outLayout->GetLength() == 1 && (*outLayout)[0].componentCount == 4,
+            "Compiler check: VS_Check output layout mismatch");
+
+        const std::optional<ConstBufGroupHandle> cbufs = vs.GetConstantBuffers();
+        FX_CHECK_MSG(cbufs.has_value() && cbufs->GetLength() == 1, "Compiler check: VS_Check constant buffer mismatch");
+
+        const ConstBufDefHandle globals = (*cbufs)[0];
+        FX_CHECK_MSG(globals.GetStringMap().GetString(globals.GetNameID()) == "_EffectGlobals" &&
+            globals.GetLength() == 2 && globals.GetSize() == 16, "Compiler check: _EffectGlobals layout mismatch");
+        FX_CHECK_MSG(globals[0].offset == 0 && globals[0].size == 8 && globals[1].offset == 8 && globals[1].size == 8,
+            "Compiler check: _EffectGlobals packing mismatch");
+    }
+
+    // Texture and sampler slots are assigned per register class
+    {
+        const ShaderDefHandle ps = GetCheckShader(lib, "PS_Check");
+        const std::optional<ResourceGroupHandle> resources = ps.GetResources();
+        FX_CHECK_MSG(resources.has_value() && resources->GetLength() == 2, "Compiler check: PS_Check resource mismatch");
+
+        CheckResource(*resources, 0, "tex", ShaderTypes::Texture2D, 0);
+        CheckResource(*resources, 1, "samp", ShaderTypes::Sampler, 0);
+    }
+
+    // Compute thread groups and UAVs
+    {
+        const ShaderDefHandle cs = GetCheckShader(lib, "CS_Check");
+        const tvec3<uint> groupSize = cs.GetThreadGroupSize();
+        FX_CHECK_MSG(groupSize.x == 8 && groupSize.y == 4 && groupSize.z == 1, "Compiler check: CS_Check thread group mismatch");
+
+        const std::optional<ResourceGroupHandle> resources = cs.GetResources();
+        FX_CHECK_MSG(resources.has_value() && resources->GetLength() == 1, "Compiler check: CS_Check resource mismatch");
+        CheckResource(*resources, 0, "dst", ShaderTypes::RWTexture2D, 0);
+    }
+
+    WV_LOG_INFO() << "Compiler check passed";
+}
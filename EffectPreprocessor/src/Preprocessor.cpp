@@ -3,12 +3,22 @@
 #include <fstream>
 #include <filesystem>
 #include <unordered_map>
+#include <charconv>
+#include <array>
+#include <thread>
 #include "WeaveEffects/EffectParseException.hpp"
 #include "WeaveUtils/Logger.hpp"
 #include "WeaveUtils/GenericMain.hpp"
 #include "WeaveUtils/Stopwatch.hpp"
+#include "WeaveUtils/WorkerPool.hpp"
 #include "WeaveEffects/ShaderLibBuilder.hpp"
+#include "WeaveEffects/ShaderLibImage.hpp"
+#include "WeaveEffects/ShaderLibBuilder/ShaderCompiler.hpp"
+#include "WeaveEffects/ShaderLibBuilder/BuildProfiler.hpp"
 #include "FXHelpText.hpp"
+#include "Benchmark.hpp"
+#include "CompilerCheck.hpp"
+#include "BuildManifest.hpp"
 
 namespace fs = std::filesystem;
 
@@ -27,8 +37,30 @@ static bool isDebugging = false;
 static bool isHeaderLib = false;
 // If true, merges all input files into a single output library file.
 static bool isMerging = false;
+// If true, outputs libraries in the flat image layout that can be used in place without deserialization.
+static bool isFlatLib = false;
+// If true, shader bytecode in flat libraries is LZ4 compressed.
+static bool isCompressing = false;
 // Specifies the target shader feature level (e.g., "5_0").
 static string featureLevel;
+// Number of threads used to build variants. Zero uses all hardware threads.
+static uint threadCount = 1;
+// Number of input files built concurrently. Zero uses all hardware threads.
+static uint jobCount = 1;
+// Directory used to cache precompiled shaders between runs. Disabled if empty.
+static string cacheDir;
+// Name of the shader compiler backend. Uses the platform default if empty.
+static string compilerName;
+// Path of the Chrome trace written with build stage timings. Profiling is disabled if empty.
+static string profilePath;
+// Number of times each input is built in benchmark mode. Benchmarking is disabled if zero.
+static uint benchmarkRuns = 0;
+// If true, the compiler backend check is run instead of building inputs.
+static bool isCheckingCompiler = false;
+// If true, every variant is preprocessed from scratch instead of reusing equivalent variants.
+static bool isFullPreprocess = false;
+// If true, repos with unchanged sources and includes are copied from the previous build's manifest.
+static bool isIncrementalBuild = false;
 // Specifies the output directory or file path.
 static string outputDir;
 // Stores the set of input file paths to process.
@@ -79,6 +111,25 @@ static void SetStringParam(const IDynamicArray<string_view>& args, int& pos, str
     param = args[pos];
 }
 
+/**
+ * @brief Helper to read the next argument as an unsigned integer value for an option.
+ * @param args The array of command-line arguments.
+ * @param pos[in,out] The current position index within the args array. Will be incremented.
+ * @param param[out] The variable to store the parsed argument value.
+ * @throws EffectParseException If no argument follows, or the argument is not an unsigned integer.
+ */
+static void SetUIntParam(const IDynamicArray<string_view>& args, int& pos, uint& param)
+{
+    string value;
+    SetStringParam(args, pos, value);
+
+    const char* pEnd = value.data() + value.size();
+    const auto [pLast, err] = std::from_chars(value.data(), pEnd, param);
+
+    FX_CHECK_MSG(err == std::errc() && pLast == pEnd,
+        "Expected unsigned integer after option '{}'. Found: '{}'", args[pos - 1], value);
+}
+
 //-----------------------------------------------------------------------------
 // Command-line Option Handlers
 //-----------------------------------------------------------------------------
@@ -95,9 +146,42 @@ static void SetDebug(const IDynamicArray<string_view>& args, int& pos) { isDebug
 // Sets the global flag to enable merging of inputs.
 static void SetMerge(const IDynamicArray<string_view>& args, int& pos) { isMerging = true; }
 
+// Sets the global flag to enable flat library image output.
+static void SetFlatLib(const IDynamicArray<string_view>& args, int& pos) { isFlatLib = true; }
+
+// Sets the global flags to enable compressed flat library output.
+static void SetCompress(const IDynamicArray<string_view>& args, int& pos) { isFlatLib = true; isCompressing = true; }
+
+// Sets the global flag to run the compiler backend check.
+static void SetCheckCompiler(const IDynamicArray<string_view>& args, int& pos) { isCheckingCompiler = true; }
+
+// Sets the global flag to disable incremental variant preprocessing.
+static void SetFullPreprocess(const IDynamicArray<string_view>& args, int& pos) { isFullPreprocess = true; }
+
+// Sets the global flag to enable incremental builds using build manifests.
+static void SetIncrementalBuild(const IDynamicArray<string_view>& args, int& pos) { isIncrementalBuild = true; }
+
 // Sets the global string for the target feature level using SetStringParam.
 static void SetFeatureLevel(const IDynamicArray<string_view>& args, int& pos) { SetStringParam(args, pos, featureLevel); }
 
+// Sets the number of threads used to build variants using SetUIntParam.
+static void SetThreads(const IDynamicArray<string_view>& args, int& pos) { SetUIntParam(args, pos, threadCount); }
+
+// Sets the number of input files built concurrently using SetUIntParam.
+static void SetJobs(const IDynamicArray<string_view>& args, int& pos) { SetUIntParam(args, pos, jobCount); }
+
+// Sets the global string for the shader cache directory using SetStringParam.
+static void SetCacheDir(const IDynamicArray<string_view>& args, int& pos) { SetStringParam(args, pos, cacheDir); }
+
+// Sets the global string for the compiler backend name using SetStringParam.
+static void SetCompilerName(const IDynamicArray<string_view>& args, int& pos) { SetStringParam(args, pos, compilerName); }
+
+// Sets the global string for the build profile trace path using SetStringParam.
+static void SetProfilePath(const IDynamicArray<string_view>& args, int& pos) { SetStringParam(args, pos, profilePath); }
+
+// Sets the number of benchmark runs using SetUIntParam.
+static void SetBenchmarkRuns(const IDynamicArray<string_view>& args, int& pos) { SetUIntParam(args, pos, benchmarkRuns); }
+
 // Sets the global string for the output directory/file using SetStringParam.
 static void SetOutput(const IDynamicArray<string_view>& args, int& pos) { SetStringParam(args, pos, outputDir); }
 
@@ -154,7 +238,18 @@ static const std::unordered_map<string_view, OptionHandlerFunc> s_OptionMap
     { "debug", SetDebug },
     { "header", SetHeaderLib },
     { "merge", SetMerge },
+    { "flat", SetFlatLib },
+    { "compress", SetCompress },
     { "feature-level", SetFeatureLevel },
+    { "threads", SetThreads },
+    { "jobs", SetJobs },
+    { "cache-dir", SetCacheDir },
+    { "compiler", SetCompilerName },
+    { "full-preprocess", SetFullPreprocess },
+    { "incremental", SetIncrementalBuild },
+    { "profile", SetProfilePath },
+    { "benchmark", SetBenchmarkRuns },
+    { "check-compiler", SetCheckCompiler },
     { "input", SetInput },
     { "output", SetOutput }
 };
@@ -164,49 +259,133 @@ static const std::unordered_map<string_view, OptionHandlerFunc> s_OptionMap
 //-----------------------------------------------------------------------------
 
 /**
- * @brief Converts binary data from a stringstream into a C++ header file format
- * (constexpr uint64_t array). Assumes little endian encoding.
- * @param name The base name for the C++ variable (e.g., "MyLibrary").
- * @param binStream[in,out] The stringstream containing the binary data. It will be cleared
- * and overwritten with the header content.
+ * @brief Output stream buffer that formats the bytes written to it as the body of a C++ uint64_t
+ * array initializer and forwards the text to another stream in fixed size blocks. Bytes are
+ * packed into little endian words and formatted with a byte -> hex digit lookup table, so
+ * memory use is constant regardless of the size of the data.
  */
-static void ConvertBinaryToHeader(string_view name, std::stringstream& binStream)
+class HexArrayStreamBuf : public std::streambuf
 {
-    static string binaryData;
-    binaryData.clear();
-    binaryData.append(binStream.view());
-    binStream.str({});
-    binStream.clear();
+public:
+    explicit HexArrayStreamBuf(std::ostream& dst) :
+        dst(dst),
+        textLength(0),
+        word(0),
+        wordBytes(0),
+        wordCount(0)
+    { }
+
+    /**
+     * @brief Writes any partial trailing word, zero padded, and flushes pending text to the
+     * destination stream.
+     */
+    void Finish()
+    {
+        if (wordBytes > 0)
+            PutWord();
 
-    static string varName;
-    varName.clear();
-    varName.append("s_FX_");
-    varName.append(name);
+        FlushText();
+    }
 
-    const size_t packedSize = (binaryData.size() + 7) / 8;
-    binStream << "#include <cstdint>\n// Generated by WFX Preprocessor\n";
-    binStream << "constexpr uint64_t " << varName << "[" << packedSize << "] = {\n";
+protected:
+    int_type overflow(int_type ch) override
+    {
+        if (!traits_type::eq_int_type(ch, traits_type::eof()))
+            PutByte((byte)traits_type::to_char_type(ch));
 
-    for (size_t i = 0; i < (packedSize - 1); i++)
+        return traits_type::not_eof(ch);
+    }
+
+    std::streamsize xsputn(const char* pSrc, std::streamsize count) override
     {
-        uint64_t value;
-        memcpy(&value, &binaryData[8 * i], sizeof(uint64_t));
+        for (std::streamsize i = 0; i < count; i++)
+            PutByte((byte)pSrc[i]);
+
+        return count;
+    }
+
+private:
+    // Number of words written per line
+    static constexpr uint s_WordsPerLine = 8;
+    // Longest text emitted per word: "0x" + 16 digits + ",\n"
+    static constexpr uint s_MaxWordText = 20;
+
+    // Two lowercase hex digits for each byte value
+    static constexpr std::array<char, 512> s_HexTable = []()
+    {
+        constexpr char digits[] = "0123456789abcdef";
+        std::array<char, 512> table = {};
+
+        for (uint i = 0; i < 256; i++)
+        {
+            table[2 * i] = digits[i >> 4];
+            table[2 * i + 1] = digits[i & 0xF];
+        }
+
+        return table;
+    }();
+
+    std::ostream& dst;
+    std::array<char, 64 * 1024> text;
+    size_t textLength;
+    ulong word;
+    uint wordBytes;
+    size_t wordCount;
 
-        binStream << "0x" << std::hex << value << ",";
+    void PutByte(byte value)
+    {
+        word |= (ulong)value << (8 * wordBytes);
 
-        if (i > 0 && i % 5 == 0)
-            binStream << std::endl;
+        if (++wordBytes == 8)
+            PutWord();
     }
 
-    const size_t trailingStart = 8 * (packedSize - 1);
-    ulong lastValue = 0;
+    void PutWord()
+    {
+        if ((textLength + s_MaxWordText) > text.size())
+            FlushText();
 
-    for (size_t i = trailingStart; i < binaryData.size(); i++)
-        lastValue |= ((ulong)binaryData[i] << (8 * (i - trailingStart)));
+        char* pText = &text[textLength];
+        *pText++ = '0';
+        *pText++ = 'x';
 
-    binStream << "0x" << std::hex << lastValue << std::endl;
-    binStream << "};";
-}
+        // Leading zeroes are omitted, keeping at least one digit
+        int byteIndex = 7;
+
+        while (byteIndex > 0 && ((word >> (8 * byteIndex)) & 0xFF) == 0)
+            byteIndex--;
+
+        const uint topByte = (uint)(word >> (8 * byteIndex)) & 0xFF;
+
+        if (topByte >= 0x10)
+            *pText++ = s_HexTable[2 * topByte];
+
+        *pText++ = s_HexTable[2 * topByte + 1];
+
+        for (int i = byteIndex - 1; i >= 0; i--)
+        {
+            const uint value = (uint)(word >> (8 * i)) & 0xFF;
+            *pText++ = s_HexTable[2 * value];
+            *pText++ = s_HexTable[2 * value + 1];
+        }
+
+        *pText++ = ',';
+        wordCount++;
+
+        if (wordCount % s_WordsPerLine == 0)
+            *pText++ = '\n';
+
+        textLength = pText - text.data();
+        word = 0;
+        wordBytes = 0;
+    }
+
+    void FlushText()
+    {
+        dst.write(text.data(), textLength);
+        textLength = 0;
+    }
+};
 
 /**
  * @brief Reads the entire content of a specified file into a stringstream.
@@ -258,50 +437,163 @@ static void ValidateOutputDir(const fs::path& outputPath)
         "Output path specifies an existing directory, but a file is expected: {}", outputPath.string());
 }
 
+//-----------------------------------------------------------------------------
+// Core Library Processing Logic
+//-----------------------------------------------------------------------------
+
 /**
- * @brief Writes the content of a stringstream to the specified output file.
- * @param outputPath: The path to the output file.
- * @param ss: The stringstream containing the data to write.
- * @throws EffectParseException If the output file cannot be opened for writing.
+ * @brief Logs the stored and uncompressed shader bytecode size of a flat library, and the time
+ * taken to decompress its compressed binaries.
+ * @param imageData: The flat library image.
  */
-static void WriteBinary(const fs::path& outputPath, const std::stringstream& ss)
+static void LogBinaryStats(string_view imageData)
 {
-    ValidateOutputDir(outputPath); // Ensure parent directory exists
+    static thread_local Vector<byte> decodeBuf;
+    const ShaderLibImage image(imageData);
+    Stopwatch decodeTimer;
+    size_t rawSize = 0;
+    size_t storedSize = 0;
+    size_t decodedSize = 0;
+    uint compressedCount = 0;
+
+    for (uint i = 0; i < image.GetBinCount(); i++)
+    {
+        rawSize += image.GetBinRawSize(i);
+        storedSize += image.GetBin(i).size();
 
-    std::ofstream dstFile(outputPath, std::ios::binary);
-    FX_CHECK_MSG(dstFile.is_open(), "Failed to open output file for writing: {}", outputPath.string());
+        if (image.GetIsBinCompressed(i))
+        {
+            decodeTimer.Start();
+            image.GetDecompressedBin(i, decodeBuf);
+            decodeTimer.Stop();
+
+            decodedSize += decodeBuf.GetLength();
+            compressedCount++;
+        }
+    }
 
-    dstFile << ss.rdbuf(); // Write the stringstream buffer to the file
+    WV_LOG_INFO() << "    Bytecode:  " << storedSize << " of " << rawSize << " bytes stored ("
+        << compressedCount << " of " << image.GetBinCount() << " binaries compressed)";
+
+    if (decodedSize > 0)
+    {
+        const double decodeS = decodeTimer.GetElapsedS();
+        const double mbPerS = (decodeS > 0) ? (decodedSize / (1024.0 * 1024.0)) / decodeS : 0.0;
+        WV_LOG_INFO() << "    Decode:    " << decodeTimer.GetElapsedMS() << " ms (" << mbPerS << " MB/s)";
+    }
 }
 
-//-----------------------------------------------------------------------------
-// Core Library Processing Logic
-//-----------------------------------------------------------------------------
+/**
+ * @brief Writes the library in the selected format to the given stream.
+ * @param shaderLib: The library definition, used for serialized output.
+ * @param imageData: The flat library image, used for flat output.
+ * @param dst: The stream the library is written to.
+ */
+static void WriteLibraryData(const ShaderLibDef::Handle& shaderLib, string_view imageData, std::ostream& dst)
+{
+    if (isFlatLib)
+        dst.write(imageData.data(), imageData.size());
+    else
+    {
+        // Archives may buffer output until they're destroyed
+        Serializer libWriter(dst);
+        libWriter(shaderLib);
+    }
+}
+
+/**
+ * @brief Returns a key describing the build settings that affect the contents of a library.
+ * Manifests are only reused by builds with the same key.
+ * @param libBuilder: The configured library builder.
+ */
+static string GetBuildConfigKey(const ShaderLibBuilder& libBuilder)
+{
+    string key(libBuilder.GetCompiler().GetCompilerVersion());
+    key.push_back('\0');
+    key.append(featureLevel);
+    key.push_back('\0');
+    key.push_back(isDebugging ? '1' : '0');
+
+    return key;
+}
 
 /**
- * @brief Finalizes the shader library, serializes it, optionally converts to a header,
- * and writes it to the specified output file.
+ * @brief Adds an input file to the library builder. In incremental builds, inputs whose source
+ * and includes are unchanged since the manifest was written are copied from the previous build
+ * instead of being rebuilt.
+ * @param libBuilder: The library builder the input is added to.
+ * @param manifest: The manifest of the library the input is written to.
+ * @param name: The repo name.
+ * @param path: The path of the input file.
+ * @param src: The contents of the input file.
+ */
+static void AddInputRepo(ShaderLibBuilder& libBuilder, BuildManifest& manifest, string_view name, string_view path, string_view src)
+{
+    if (!isIncrementalBuild)
+    {
+        libBuilder.AddRepo(name, path, src);
+        return;
+    }
+
+    const Hash128 srcHash = GetHash128(src);
+    const uint prevIndex = manifest.TryGetRepo(name, path, srcHash);
+
+    if (prevIndex != -1)
+    {
+        WV_LOG_INFO() << "Input and includes unchanged. Reusing previous build of: " << path;
+        libBuilder.AddRepo(manifest.GetImage(), prevIndex);
+        manifest.AddPrevRepo(prevIndex);
+    }
+    else
+    {
+        libBuilder.AddRepo(name, path, src);
+        manifest.AddRepo(name, path, srcHash, libBuilder.GetRepoIncludes());
+    }
+}
+
+/**
+ * @brief Finalizes the shader library and streams it to the specified output file, either as
+ * binary or as a C++ header (constexpr uint64_t array, little endian).
  * @param name: The base name for the library (used for header variable naming).
  * @param libBuilder: The ShaderLibBuilder instance containing the compiled library data.
- * @param streamBuf: A reusable stringstream buffer for serialization and writing.
  * @param output: The path to the output file.
+ * @param manifest: The manifest recording the repos in the library. Saved next to the output in
+ * incremental builds.
+ * @throws EffectParseException If the output file cannot be opened or written.
  */
-static void WriteLibrary(string_view name, ShaderLibBuilder& libBuilder, std::stringstream& streamBuf, const fs::path& output)
+static void WriteLibrary(string_view name, ShaderLibBuilder& libBuilder, const fs::path& output, BuildManifest& manifest)
 {
     ShaderLibDef::Handle shaderLib = libBuilder.GetDefinition();
-    streamBuf.str({});
-    streamBuf.clear();
+    static thread_local Vector<byte> imageBuf;
+    imageBuf.Clear();
+
+    // Flat images are written to memory first, as section offsets are only known at the end
+    if (isFlatLib)
+        WriteShaderLibImage(shaderLib, imageBuf, isCompressing);
 
-    // Serialize the library definition into the stringstream buffer
-    Serializer libWriter(streamBuf);
-    libWriter(shaderLib);
+    const string_view imageData(reinterpret_cast<const char*>(imageBuf.GetData()), imageBuf.GetLength());
+    ValidateOutputDir(output);
+
+    std::ofstream dstFile(output, std::ios::binary);
+    FX_CHECK_MSG(dstFile.is_open(), "Failed to open output file for writing: {}", output.string());
 
-    // Convert serialized binary data to a C++ header if requested
     if (isHeaderLib)
-        ConvertBinaryToHeader(name, streamBuf);
+    {
+        dstFile << "#include <cstdint>\n// Generated by WFX Preprocessor\n";
+        dstFile << "constexpr uint64_t s_FX_" << name << "[] = {\n";
+
+        HexArrayStreamBuf hexBuf(dstFile);
+        std::ostream hexStream(&hexBuf);
+        WriteLibraryData(shaderLib, imageData, hexStream);
+        hexBuf.Finish();
+
+        dstFile << "\n};";
+    }
+    else
+        WriteLibraryData(shaderLib, imageData, dstFile);
 
-    // Write the final data (binary or header text) to the output file
-    WriteBinary(output, streamBuf);
+    dstFile.flush();
+    FX_CHECK_MSG(dstFile.good(), "Failed to write output file: {}", output.string());
 
     // Get combined variant count
     uint vCount = 0;
@@ -319,6 +611,9 @@ static void WriteLibrary(string_view name, ShaderLibBuilder& libBuilder, std::st
     WV_LOG_INFO() << "    Constants: " << (shaderLib.regHandle.pConstants ? shaderLib.regHandle.pConstants->GetLength() : 0);
     WV_LOG_INFO() << "    Resources: " << (shaderLib.regHandle.pResources ? shaderLib.regHandle.pResources->GetLength() : 0);
 
+    if (isFlatLib)
+        LogBinaryStats(imageData);
+
     if (shaderLib.pPlatform) 
     {
         WV_LOG_INFO() << "  Platform Info:";
@@ -328,9 +623,289 @@ static void WriteLibrary(string_view name, ShaderLibBuilder& libBuilder, std::st
     else
         WV_LOG_WARN() << "  Platform info not available in ShaderLibDef.";
 
+    if (isIncrementalBuild)
+        manifest.Save(BuildManifest::GetManifestPath(output), GetBuildConfigKey(libBuilder), shaderLib);
+
     libBuilder.Clear();
 }
 
+/**
+ * @brief Logs a summary of recorded build stage timings and writes them to a Chrome trace file
+ * that can be opened in chrome://tracing or Perfetto.
+ * @param profiler: The profiler used to record the build.
+ * @param tracePath: The path of the trace JSON file.
+ * @throws EffectParseException If the trace file cannot be opened.
+ */
+static void WriteProfile(const BuildProfiler& profiler, const fs::path& tracePath)
+{
+    profiler.LogSummary();
+    ValidateOutputDir(tracePath);
+
+    std::ofstream traceStream(tracePath, std::ios::binary);
+    FX_CHECK_MSG(traceStream.is_open(), "Failed to open profile trace file: {}", tracePath.string());
+
+    profiler.WriteChromeTrace(traceStream);
+    WV_LOG_INFO() << "Wrote build profile trace: " << tracePath;
+}
+
+/**
+ * @brief Benchmarks the builder over the input files and a generated synthetic corpus instead of
+ * writing libraries. Synthetic effects are written to a temporary directory.
+ * @param libBuilder: The configured library builder.
+ */
+static void BenchmarkLibrary(ShaderLibBuilder& libBuilder)
+{
+    Vector<BenchmarkCase> cases;
+    std::stringstream streamBuf;
+
+    for (const string& inputFileStr : inputFiles)
+    {
+        const fs::path inFile(inputFileStr);
+        GetInput(inFile, streamBuf);
+        cases.EmplaceBack(BenchmarkCase{ inFile.stem().string(), inFile.string(), streamBuf.str() });
+    }
+
+    const fs::path synthDir = fs::temp_directory_path() / "wfxc_benchmark";
+    WV_LOG_INFO() << "Writing synthetic benchmark effects to: " << synthDir;
+    GetSyntheticBenchmarkCases(synthDir, cases);
+
+    RunBenchmark(libBuilder, cases, benchmarkRuns);
+}
+
+/**
+ * @brief Applies the configured build settings to a library builder.
+ * @param libBuilder: The builder to configure.
+ * @param builderThreads: The number of threads the builder uses to build variants.
+ * @throws EffectParseException If the compiler name is not recognized.
+ */
+static void ConfigureBuilder(ShaderLibBuilder& libBuilder, uint builderThreads)
+{
+    libBuilder.SetFeatureLevel(featureLevel);
+    libBuilder.SetDebug(isDebugging);
+    libBuilder.SetThreadCount(builderThreads);
+    libBuilder.SetIncrementalPreprocessing(!isFullPreprocess);
+
+    if (compilerName == "d3d11")
+    {
+#ifdef _WIN32
+        libBuilder.SetCompiler(unique_ptr<IShaderCompiler>(new ShaderCompilerD3D11()));
+#else
+        FX_THROW("The 'd3d11' compiler is only available on Windows.");
+#endif
+    }
+    else if (compilerName == "reflect")
+        libBuilder.SetCompiler(unique_ptr<IShaderCompiler>(new ShaderCompilerReflect()));
+    else
+        FX_CHECK_MSG(compilerName.empty(), "Unrecognized compiler '{}'. Expected 'd3d11' or 'reflect'.", compilerName);
+
+    if (!profilePath.empty())
+        libBuilder.SetProfiling(true);
+
+    if (!cacheDir.empty())
+        libBuilder.SetCacheDir(cacheDir);
+}
+
+/**
+ * @brief Returns the path of the library written for an input file when not merging.
+ * @param inFile: The input file path.
+ * @param outPath: The output directory or file, or an empty path to write next to the input.
+ */
+static fs::path GetInputOutputPath(const fs::path& inFile, const fs::path& outPath)
+{
+    fs::path currentOutFile;
+
+    if (outputDir.empty()) 
+    {
+        // No output dir specified, place output next to input
+        currentOutFile = inFile;
+    }
+    else 
+    {
+        // Output dir specified
+        if (fs::is_directory(outPath)) 
+        {
+            // Write into the directory using the input filename
+            currentOutFile = outPath / inFile.filename();
+        }
+        else 
+        {
+            // Output path is a file (only allowed for single input implicitly)
+            currentOutFile = outPath;
+        }
+    }
+
+    // Set the correct output file extension
+    if (isHeaderLib)
+        currentOutFile.replace_extension(".hpp");
+    else
+        currentOutFile.replace_extension(".bin");
+
+    return currentOutFile;
+}
+
+/**
+ * @brief Builds an input file and writes it to its own library.
+ * @param libBuilder: The library builder used to build the input. Cleared after writing.
+ * @param manifest: The manifest used for incremental builds.
+ * @param inFile: The input file path.
+ * @param outPath: The configured output path.
+ * @param configKey: The build config key used to load manifests.
+ * @param streamBuf: Buffer used to read the input.
+ */
+static void WriteInputLibrary(ShaderLibBuilder& libBuilder, BuildManifest& manifest, const fs::path& inFile,
+    const fs::path& outPath, const string& configKey, std::stringstream& streamBuf)
+{
+    WV_LOG_INFO() << "Processing input file: " << inFile;
+
+    // Read input file content into the buffer
+    GetInput(inFile, streamBuf);
+
+    const string baseName = inFile.stem().string(); // Base name for library/variable naming
+    const string inputPathString = inFile.string(); // Full path string for builder context
+    const fs::path currentOutFile = GetInputOutputPath(inFile, outPath);
+    WV_LOG_INFO() << "Output path for this file: " << currentOutFile;
+
+    if (isIncrementalBuild)
+        manifest.TryLoad(BuildManifest::GetManifestPath(currentOutFile), configKey);
+
+    AddInputRepo(libBuilder, manifest, baseName, inputPathString, streamBuf.view());
+    WriteLibrary(baseName, libBuilder, currentOutFile, manifest);
+}
+
+/**
+ * @brief Builds and writes each input file to its own library on a worker pool. Each job uses
+ * its own builder and manifest. Inputs must have distinct output paths.
+ * @param inputs: The input files.
+ * @param outPath: The configured output path.
+ * @param configKey: The build config key used to load manifests.
+ * @param jobPool: The pool used to run jobs.
+ * @param jobThreads: The number of variant threads used by each job.
+ */
+static void WriteInputLibrariesParallel(const IDynamicArray<fs::path>& inputs, const fs::path& outPath,
+    const string& configKey, WorkerPool& jobPool, uint jobThreads)
+{
+    jobPool.ParallelFor((uint)inputs.GetLength(), [&](uint index)
+    {
+        ShaderLibBuilder libBuilder;
+        BuildManifest manifest;
+        std::stringstream streamBuf;
+
+        ConfigureBuilder(libBuilder, jobThreads);
+        WriteInputLibrary(libBuilder, manifest, inputs[index], outPath, configKey, streamBuf);
+    });
+}
+
+/**
+ * @brief Input file built separately for a merged library
+ */
+struct MergeInput
+{
+    string name;
+    string path;
+    string src;
+    Hash128 srcHash;
+    // Index of the unchanged repo in the manifest, or -1 if built
+    uint prevIndex;
+    // Flat image of the input built on its own
+    Vector<byte> image;
+    UniqueVector<string> includes;
+};
+
+/**
+ * @brief Builds a merge input on its own and writes it to a flat image. The builder is cleared
+ * afterward.
+ * @param inputBuilder: The configured builder used to build the input.
+ * @param input: The input to build.
+ */
+static void BuildMergeInput(ShaderLibBuilder& inputBuilder, MergeInput& input)
+{
+    WV_LOG_INFO() << "Processing input file: " << input.path;
+
+    inputBuilder.AddRepo(input.name, input.path, input.src);
+    WriteShaderLibImage(inputBuilder.GetDefinition(), input.image);
+
+    const IDynamicArray<string>& includes = inputBuilder.GetRepoIncludes();
+    input.includes.Reserve(includes.GetLength());
+
+    for (const string& includePath : includes)
+        input.includes.EmplaceBack(includePath);
+
+    inputBuilder.Clear();
+}
+
+/**
+ * @brief Builds each input file on its own, then adds the results to the merged library in input
+ * order. Resource IDs are remapped as each repo is added. Inputs take the same path with or
+ * without a job pool, so the merged library is identical for any job count. In incremental
+ * builds, unchanged inputs are copied from the manifest instead of being built.
+ * @param mergeBuilder: The builder for the merged library.
+ * @param inputBuilder: The builder used for inputs when not using a job pool.
+ * @param manifest: The manifest of the merged library.
+ * @param inputs: The input files.
+ * @param pJobPool: The pool used to run jobs, or null to build inputs one at a time.
+ * @param jobThreads: The number of variant threads used by each job.
+ */
+static void AddInputRepos(ShaderLibBuilder& mergeBuilder, ShaderLibBuilder& inputBuilder, BuildManifest& manifest, 
+    const IDynamicArray<fs::path>& inputs, WorkerPool* pJobPool, uint jobThreads)
+{
+    UniqueVector<MergeInput> mergeInputs;
+    UniqueVector<uint> buildIndices;
+    std::stringstream streamBuf;
+    mergeInputs.Reserve(inputs.GetLength());
+
+    // Manifests aren't thread safe, so reused inputs are found before the parallel build
+    for (const fs::path& inFile : inputs)
+    {
+        GetInput(inFile, streamBuf);
+
+        MergeInput& input = mergeInputs.EmplaceBack();
+        input.name = inFile.stem().string();
+        input.path = inFile.string();
+        input.src = streamBuf.str();
+        input.srcHash = isIncrementalBuild ? GetHash128(input.src) : Hash128{};
+        input.prevIndex = isIncrementalBuild ? manifest.TryGetRepo(input.name, input.path, input.srcHash) : -1;
+
+        if (input.prevIndex == -1)
+            buildIndices.EmplaceBack((uint)mergeInputs.GetLength() - 1);
+    }
+
+    if (pJobPool != nullptr)
+    {
+        pJobPool->ParallelFor((uint)buildIndices.GetLength(), [&](uint index)
+        {
+            ShaderLibBuilder jobBuilder;
+            ConfigureBuilder(jobBuilder, jobThreads);
+            BuildMergeInput(jobBuilder, mergeInputs[buildIndices[index]]);
+        });
+    }
+    else
+    {
+        for (const uint index : buildIndices)
+            BuildMergeInput(inputBuilder, mergeInputs[index]);
+    }
+
+    for (MergeInput& input : mergeInputs)
+    {
+        if (input.prevIndex != -1)
+        {
+            WV_LOG_INFO() << "Input and includes unchanged. Reusing previous build of: " << input.path;
+            mergeBuilder.AddRepo(manifest.GetImage(), input.prevIndex);
+            manifest.AddPrevRepo(input.prevIndex);
+        }
+        else
+        {
+            const ShaderLibImage image(string_view(reinterpret_cast<const char*>(input.image.GetData()), input.image.GetLength()));
+            mergeBuilder.AddRepo(image, 0);
+
+            if (isIncrementalBuild)
+                manifest.AddRepo(input.name, input.path, input.srcHash, input.includes);
+        }
+
+        // Built images are only needed until they're copied into the merged library
+        input.image = Vector<byte>();
+    }
+}
+
 /**
  * @brief Main function to create the shader library/libraries based on parsed options.
  * Handles reading inputs, configuring the builder, processing files, and writing outputs.
@@ -338,6 +913,12 @@ static void WriteLibrary(string_view name, ShaderLibBuilder& libBuilder, std::st
  */
 static void CreateLibrary()
 {
+    if (isCheckingCompiler)
+    {
+        RunCompilerCheck();
+        return;
+    }
+
     ShaderLibBuilder libBuilder;
     std::stringstream streamBuf;
 
@@ -349,8 +930,21 @@ static void CreateLibrary()
     }
 
     // Configure the library builder
-    libBuilder.SetFeatureLevel(featureLevel);
-    libBuilder.SetDebug(isDebugging);
+    ConfigureBuilder(libBuilder, threadCount);
+    WV_LOG_INFO() << "Variant build threads: " << libBuilder.GetThreadCount();
+    WV_LOG_INFO() << "Shader compiler: " << libBuilder.GetCompiler().GetCompilerVersion();
+
+    if (!profilePath.empty())
+        WV_LOG_INFO() << "Profiling build to: " << fs::absolute(profilePath);
+
+    if (!cacheDir.empty())
+        WV_LOG_INFO() << "Using shader cache: " << fs::absolute(cacheDir);
+
+    if (benchmarkRuns > 0)
+    {
+        BenchmarkLibrary(libBuilder);
+        return;
+    }
 
     fs::path outPath;
 
@@ -379,79 +973,98 @@ static void CreateLibrary()
     else if (isMerging && inputFiles.size() > 1) 
         FX_THROW("Output file (--output <filepath>) must be specified when merging multiple input files.");
 
-    Stopwatch timer;
-    timer.Start();
+    if (isMerging)
+    {
+        if (outPath.empty())
+            FX_THROW("Output path (--output <filepath>) is required when merging.");
+        
+        // Set the correct extension for the merged file
+        if (isHeaderLib)
+            outPath.replace_extension(".hpp");
+        else
+            outPath.replace_extension(".bin");
+    }
+
+    Vector<fs::path> inputs;
+    inputs.Reserve(inputFiles.size());
 
-    // Process each input file
     for (const string& inputFileStr : inputFiles)
+        inputs.EmplaceBack(inputFileStr);
+
+    if (!isMerging)
     {
-        fs::path inFile(inputFileStr);
-        WV_LOG_INFO() << "Processing input file: " << inFile;
+        // Multiple inputs are written into the output directory, even if it doesn't exist yet
+        if (!outPath.empty() && inputs.GetLength() > 1)
+            fs::create_directories(outPath);
 
-        // Read input file content into the buffer
-        GetInput(inFile, streamBuf);
+        // Inputs with the same name from different directories would overwrite each other
+        std::unordered_map<string, string> outputInputs;
 
-        string baseName = inFile.stem().string(); // Base name for library/variable naming
-        string inputPathString = inFile.string(); // Full path string for builder context
+        for (const fs::path& inFile : inputs)
+        {
+            const string outFile = GetInputOutputPath(inFile, outPath).lexically_normal().string();
+            const auto [it, isNew] = outputInputs.try_emplace(outFile, inFile.string());
+            FX_CHECK_MSG(isNew, "Inputs '{}' and '{}' would both be written to '{}'. Use --merge or separate runs.", 
+                it->second, inFile.string(), outFile);
+        }
+    }
 
-        // Preprocess and add to library builder
-        libBuilder.AddRepo(baseName, inputPathString, streamBuf.view());
+    // Profiles of concurrent builds would overlap, so profiling builds inputs one at a time
+    const bool isParallel = (jobCount != 1) && (inputs.GetLength() > 1) && profilePath.empty();
+    unique_ptr<WorkerPool> pJobPool;
+    uint jobThreads = threadCount;
 
-        // If not merging, write out a separate library file for each input
-        if (!isMerging)
-        {
-            fs::path currentOutFile;
+    if (isParallel)
+    {
+        pJobPool.reset(new WorkerPool((jobCount > 0) ? std::min(jobCount, (uint)inputs.GetLength()) : 0));
 
-            if (outputDir.empty()) 
-            {
-                // No output dir specified, place output next to input
-                currentOutFile = inFile;
-            }
-            else 
-            {
-                // Output dir specified
-                if (fs::is_directory(outPath)) 
-                {
-                    // Write into the directory using the input filename
-                    currentOutFile = outPath / inFile.filename();
-                }
-                else 
-                {
-                    // Output path is a file (only allowed for single input implicitly)
-                    currentOutFile = outPath;
-                }
-            }
+        // Variant threads are split between jobs, so the total stays within --threads
+        const uint jobs = pJobPool->GetThreadCount();
+        const uint totalThreads = (threadCount > 0) ? threadCount : std::max(1u, std::thread::hardware_concurrency());
+        jobThreads = std::max(1u, totalThreads / jobs);
 
-            // Set the correct output file extension
-            if (isHeaderLib)
-                currentOutFile.replace_extension(".hpp");
-            else
-                currentOutFile.replace_extension(".bin");
-           
-            WV_LOG_INFO() << "Output path for this file: " << currentOutFile;
-            WriteLibrary(baseName, libBuilder, streamBuf, currentOutFile);
-        }
+        WV_LOG_INFO() << "Input build jobs: " << jobs << ", variant threads per job: " << jobThreads;
     }
+    else if (jobCount != 1 && !profilePath.empty())
+        WV_LOG_WARN() << "Profiling builds inputs one at a time. Ignoring --jobs.";
+
+    BuildManifest manifest;
+    const string configKey = isIncrementalBuild ? GetBuildConfigKey(libBuilder) : string();
+
+    if (isIncrementalBuild && isMerging)
+        manifest.TryLoad(BuildManifest::GetManifestPath(outPath), configKey);
+
+    Stopwatch timer;
+    timer.Start();
 
-    // If merging, write the single combined library after processing all inputs
     if (isMerging)
     {
-        if (outPath.empty())
-            FX_THROW("Output path (--output <filepath>) is required when merging.");
-        
-        // Set the correct extension for the merged file
-        if (isHeaderLib)
-            outPath.replace_extension(".hpp");
-        else
-            outPath.replace_extension(".bin");
-
+        // Inputs are built on their own and copied into the combined library, even when built 
+        // one at a time, so the result is the same for any --jobs. The configured builder builds 
+        // serial inputs and keeps the profile.
+        ShaderLibBuilder mergeBuilder;
+        ConfigureBuilder(mergeBuilder, 1);
+        AddInputRepos(mergeBuilder, libBuilder, manifest, inputs, pJobPool.get(), jobThreads);
+
+        // Write the single combined library after processing all inputs
         string mergedName = outPath.stem().string(); // Use output filename stem for name
         WV_LOG_INFO() << "Writing merged library: " << outPath;
-        WriteLibrary(mergedName, libBuilder, streamBuf, outPath);
+        WriteLibrary(mergedName, mergeBuilder, outPath, manifest);
+    }
+    // If not merging, write out a separate library file for each input
+    else if (isParallel)
+        WriteInputLibrariesParallel(inputs, outPath, configKey, *pJobPool, jobThreads);
+    else
+    {
+        for (const fs::path& inFile : inputs)
+            WriteInputLibrary(libBuilder, manifest, inFile, outPath, configKey, streamBuf);
     }
 
     timer.Stop();
     WV_LOG_INFO() << "Total processing time: " << timer.GetElapsedMS() << " ms";
+
+    if (!profilePath.empty())
+        WriteProfile(*libBuilder.GetProfiler(), profilePath);
 }
 
 /**
@@ -505,7 +1118,7 @@ static void HandleOptions(const IDynamicArray<string_view>& args)
         }
     }
 
-    if (!shouldShowHelp)
+    if (!shouldShowHelp && benchmarkRuns == 0 && !isCheckingCompiler)
         FX_CHECK_MSG(!inputFiles.empty(), "No input files specified. Use --input <file> or --input <*.ext>.");
 }
 
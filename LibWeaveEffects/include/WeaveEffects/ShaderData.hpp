@@ -3,6 +3,7 @@
 #include "WeaveEffects/EffectParseException.hpp"
 #include "WeaveUtils/StringIDMap.hpp"
 #include "WeaveUtils/VectorSpan.hpp"
+#include "WeaveUtils/Span.hpp"
 #include "WeaveEffects/ShaderLibBuilder/ShaderParser/SymbolEnums.hpp"
 #include "WeaveEffects/ShaderLibBuilder/ShaderParser/ShaderTypeInfo.hpp"
 
@@ -21,6 +22,16 @@ namespace Weave::Effects
 	/// </summary>
 	using IDSpan = const VectorSpan<Vector<uint>>;
 
+	/// <summary>
+	/// Non-owning view of raw bytes in a loaded library
+	/// </summary>
+	using ByteView = const Span<byte>;
+
+	/// <summary>
+	/// Non-owning view of uint IDs in a loaded library
+	/// </summary>
+	using IDView = const Span<uint>;
+
 	template <typename T>
 	class SpanVector
 	{
@@ -73,7 +73,7 @@ namespace Weave::Effects
 
 	private:
 		const ShaderRegistryMap* pMap;
-		IDSpan layout;
+		IDView layout;
 	};
 
 	/// <summary>
@@ -103,7 +103,7 @@ namespace Weave::Effects
 
 	private:
 		const ShaderRegistryMap* pMap;
-		IDSpan layout;
+		IDView layout;
 	};
 
 	/// <summary>
@@ -133,7 +133,7 @@ namespace Weave::Effects
 
 	private:
 		const ShaderRegistryMap* pMap;
-		IDSpan layout;
+		IDView layout;
 	};
 
 	/// <summary>
@@ -159,7 +159,7 @@ namespace Weave::Effects
 		/// <summary>
 		/// Returns precompiled platform-specific bytecode
 		/// </summary>
-		ByteSpan GetBinSrc() const;
+		ByteView GetBinSrc() const;
 
 		/// <summary>
 		/// Identifies the shading stage defined by the shader
@@ -226,7 +226,7 @@ namespace Weave::Effects
 		/// <summary>
 		/// Returns shaders for the given pass
 		/// </summary>
-		IDSpan GetPass(int pass) const;
+		IDView GetPass(int pass) const;
 
 		/// <summary>
 		/// Returns the number of shaders used by the given pass
@@ -246,6 +246,6 @@ namespace Weave::Effects
 	private:
 		EffectDef def;
 		const ShaderRegistryMap* pMap;
-		IDSpan passes;
+		IDView passes;
 	};
 }
\ No newline at end of file
@@ -1,19 +1,29 @@
 #pragma once
 #include <unordered_map>
 #include <memory>
+#include "WeaveUtils/Hash.hpp"
+#include "WeaveUtils/StringArena.hpp"
 #include "WeaveEffects/ShaderLibBuilder/ShaderEntrypoint.hpp"
 #include "WeaveEffects/ShaderDataSerialization.hpp"
 
+namespace Weave
+{
+	class WorkerPool;
+}
+
 namespace Weave::Effects
 {
 	using std::unique_ptr;
 
 	class VariantPreprocessor;
-	class BlockAnalyzer;
-	class SymbolTable;
-	class ShaderGenerator;
+	class VariantBuilder;
 	class ShaderRegistryBuilder;
-	class ScopeHandle;
+	class ShaderCache;
+	class PreprocessorCache;
+	class IShaderCompiler;
+	class BuildProfiler;
+	class ShaderLibImage;
+	class ShaderRegistryMap;
 
 	/// <summary>
 	/// Generates preprocessed, precompiled shader and effect variants with corresponding
@@ -34,6 +44,19 @@ namespace Weave::Effects
 		/// </summary>
 		void AddRepo(string_view name, string_view libPath, string_view libSrc);
 
+		/// <summary>
+		/// Copies a previously built repo and the resources it references from a library image
+		/// instead of rebuilding it from source. The image must have been built for the same
+		/// platform. Invalidates definition handles.
+		/// </summary>
+		void AddRepo(const ShaderLibImage& image, uint repoIndex);
+
+		/// <summary>
+		/// Returns the sorted paths of the files included by the last repo built from source.
+		/// Empty if the last repo was copied from an image.
+		/// </summary>
+		const IDynamicArray<string>& GetRepoIncludes() const;
+
 		/// <summary>
 		/// Sets target graphics API
 		/// </summary>
@@ -49,6 +72,61 @@ namespace Weave::Effects
 		/// </summary>
 		void SetDebug(bool isDebugging);
 
+		/// <summary>
+		/// Sets the number of threads used to build variants in parallel. Zero uses all 
+		/// hardware threads. Output is identical regardless of thread count.
+		/// </summary>
+		void SetThreadCount(uint threadCount);
+
+		/// <summary>
+		/// Returns the number of threads used to build variants
+		/// </summary>
+		uint GetThreadCount() const;
+
+		/// <summary>
+		/// Enables caching of precompiled shaders in the given directory. Shaders with unchanged
+		/// source and compiler configuration are loaded from the cache instead of recompiled.
+		/// An empty path disables the cache.
+		/// </summary>
+		void SetCacheDir(string_view cacheDir);
+
+		/// <summary>
+		/// Enables/disables sharing preprocessor results between variants. When enabled, includes 
+		/// are loaded once, and variants that only differ in flags or modes their source never
+		/// tests reuse the output of an earlier variant instead of being preprocessed again.
+		/// Such variants are also mapped onto the earlier variant without being compiled.
+		/// Output is identical either way. Enabled by default.
+		/// </summary>
+		void SetIncrementalPreprocessing(bool isIncremental);
+
+		/// <summary>
+		/// Enables/disables recording per-stage and per-variant timings and counters for
+		/// subsequent builds. Disabled by default.
+		/// </summary>
+		void SetProfiling(bool isProfiling);
+
+		/// <summary>
+		/// Returns the profiler recording builds, or null if profiling is disabled
+		/// </summary>
+		const BuildProfiler* GetProfiler() const;
+
+		/// <summary>
+		/// Discards the events recorded by the profiler, if profiling is enabled
+		/// </summary>
+		void ClearProfile();
+
+		/// <summary>
+		/// Sets the backend used to precompile and reflect shaders. Defaults to D3D11 on Windows 
+		/// and the reflection-only stand-in elsewhere. Shouldn't be changed between repos added
+		/// to the same library.
+		/// </summary>
+		void SetCompiler(unique_ptr<IShaderCompiler>&& pCompiler);
+
+		/// <summary>
+		/// Returns the backend used to precompile and reflect shaders
+		/// </summary>
+		const IShaderCompiler& GetCompiler() const;
+
 		/// <summary>
 		/// Returns a serializable library handle containing all preprocessed source 
 		/// data and their variants added via AddRepo().
@@ -56,91 +134,129 @@ namespace Weave::Effects
 		ShaderLibDef::Handle GetDefinition() const;
 
 		/// <summary>
-		/// Resets the builder for reuse. Invalidates definition handles.
+		/// Resets the builder for reuse. Invalidates definition handles. Recorded profile events are 
+		/// kept, so a profile can span several libraries built in turn.
 		/// </summary>
 		void Clear();
 
 	private:
-		struct PassBlock
-		{
-			uint nameID;
-			uint shaderStart;
-			uint shaderCount;
-		};
-
-		struct EffectBlock
-		{
-			uint nameID;
-			uint passStart;
-			uint passCount;
-		};
-
-		struct VariantSrcBuf
+		struct VariantSrcRef
 		{
-			string libText;
-			uint vID;
+			uint configID;
+			string_view src;
 		};
 
 		PlatformDef platform;
 		UniqueVector<VariantRepoDef> repos;
 		bool isDebugging;
 
-		// Parsing, code gen and reflection
 		unique_ptr<ShaderRegistryBuilder> pShaderRegistry;
-		unique_ptr<VariantPreprocessor> pVariantGen;
+		unique_ptr<IShaderCompiler> pCompiler;
+		// Optional persistent bytecode cache
+		unique_ptr<ShaderCache> pShaderCache;
+		// Optional include and variant output cache shared by variant builders
+		unique_ptr<PreprocessorCache> pPreprocCache;
+		// Optional stage timings and counters shared by variant builders
+		unique_ptr<BuildProfiler> pProfiler;
 
-		unique_ptr<BlockAnalyzer> pAnalyzer;
-		unique_ptr<SymbolTable> pTable;
-		unique_ptr<ShaderGenerator> pShaderGen;
+		// Per-thread variant parsing, code gen and compilation
+		unique_ptr<WorkerPool> pWorkerPool;
+		UniqueVector<unique_ptr<VariantBuilder>> variantBuilders;
+		// Index of the duplicated variant for each builder in a batch, -1 if unique
+		UniqueVector<sint> batchDuplicates;
+		// ConfigID of the variant assigned to each builder in a batch
+		UniqueVector<uint> batchConfigIDs;
+		// Builder and shader index pairs of every shader generated in a batch
+		UniqueVector<std::pair<uint, uint>> batchShaders;
+		// Builder and shader index pairs of batch shaders with new fingerprints
+		UniqueVector<std::pair<uint, uint>> batchCompiles;
 
-		// Variant buffers
-		VariantSrcBuf libBufs[4];
-		uint libBufIndex;
-		string hlslBuf;
+		// ConfigID pairs of variants skipped in the current repo and the earlier variants 
+		// producing identical output
+		UniqueVector<std::pair<uint, uint>> variantEquivIDs;
 
-		// Shader mains
-		UniqueVector<ShaderEntrypoint> entrypoints;
-		// nameID -> shaderID
-		std::unordered_map<uint, uint> epNameShaderIDMap;
+		// Preprocessed source of each unique variant in the current repo. Blocks are kept 
+		// between repos.
+		StringArena variantSrcArena;
+		// Source hash -> first variant in the current repo with that source
+		std::unordered_map<Hash128, VariantSrcRef> variantSrcMap;
+		// Deduplication statistics for the current repo
+		uint variantHits;
+		uint variantCollisions;
 
-		// Effect buffers
-		UniqueVector<EffectBlock> effectBlocks;
-		UniqueVector<PassBlock> effectPasses;
-		UniqueVector<uint> effectShaders;
+		// Generated source and compiler settings fingerprint -> shaderID of the first shader in
+		// the current repo with that fingerprint, -1 until it's committed
+		std::unordered_map<Hash128, uint> shaderSrcMap;
+		// Shader fingerprint statistics for the current repo
+		uint shaderSrcHits;
+		uint shaderSrcLookups;
+
+		// Files included by the last repo built from source
+		UniqueVector<string> repoIncludes;
+		// Source image ID -> registry ID of resources copied from the current image
+		std::unordered_map<uint, uint> importIDMap;
+		// Source image string ID -> registry string ID
+		std::unordered_map<uint, uint> importStringMap;
 
 		/// <summary>
 		/// Initializes the library variants and corresponding flags
 		/// </summary>
-		void InitVariants(VariantRepoDef& lib);
+		void InitVariants(VariantRepoDef& lib, const VariantPreprocessor& variantGen);
+
+		/// <summary>
+		/// Checks previous variants in the repo for source identical to the given variant and returns 
+		/// the configID of the match, or -1 if the variant is unique. Unique variants are indexed by 
+		/// source hash, and hash matches are confirmed by comparing sources.
+		/// </summary>
+		sint GetDuplicateVariant(uint configID, string_view libText);
+
+		/// <summary>
+		/// Indexes the fingerprints of shaders generated in the current batch and adds those not 
+		/// seen before in the repo to the batch compile list. Only the first shader with a given 
+		/// fingerprint is compiled.
+		/// </summary>
+		void GetUniqueShaders(uint batchCount);
+
+		/// <summary>
+		/// Assigns shaders in the builder the IDs of committed shaders with the same fingerprint
+		/// </summary>
+		void SetDuplicateShaderIDs(VariantBuilder& builder);
+
+		/// <summary>
+		/// Records the IDs of shaders committed by the builder under their fingerprints
+		/// </summary>
+		void IndexShaderIDs(const VariantBuilder& builder);
 
 		/// <summary>
-		/// Identifies shaders in the source and buffers their entrypoint symbols
+		/// Registers a variant built by the given builder, or copies the mappings of the variant
+		/// it duplicates
 		/// </summary>
-		void GetEntryPoints();
+		void CommitVariant(VariantRepoDef& lib, VariantBuilder& builder, uint vID, sint duplicateID);
 
 		/// <summary>
-		/// Identifies effects and passes defined
+		/// Copies the mappings of a registered variant to another variant in the same repo
 		/// </summary>
-		void GetEffects();
+		void CopyVariant(VariantRepoDef& lib, uint configID, uint srcID);
 
 		/// <summary>
-		/// Adds an effect pass to the buffer to be later converted into a definition
+		/// Collects the include paths recorded by each variant builder for the current repo
 		/// </summary>
-		void AddPass(const ScopeHandle& effectScope, string_view name);
+		void UpdateRepoIncludes(uint builderCount);
 
 		/// <summary>
-		/// Generates shader definitions for every shader in a variant
+		/// Adds the resource with the given ID in the source registry, and any resources it
+		/// references, to the library registry and returns its new ID. IDs of -1 are preserved.
 		/// </summary>
-		void GetShaderDefs(string_view libPath, DynamicArray<ShaderVariantDef>& variants, uint resID);
+		uint ImportResource(const ShaderRegistryMap& src, uint id);
 
 		/// <summary>
-		/// Generates effect definitions for every effect in a variant
+		/// Adds a string from the source registry to the library and returns its new ID
 		/// </summary>
-		void GetEffectDefs(DynamicArray<EffectVariantDef>& effects, uint resID);
+		uint ImportString(const ShaderRegistryMap& src, uint stringID);
 
 		/// <summary>
-		/// Resets tables for next variant
+		/// Resets the variant and shader deduplication indices
 		/// </summary>
-		void ClearVariant();
+		void ClearDuplicateIndex();
 	};
 }
\ No newline at end of file
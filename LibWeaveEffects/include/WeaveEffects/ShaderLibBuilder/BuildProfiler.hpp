@@ -0,0 +1,151 @@
+#pragma once
+#include <mutex>
+#include <ostream>
+#include <thread>
+#include <unordered_map>
+#include "WeaveUtils/GlobalUtils.hpp"
+#include "WeaveUtils/DynamicCollections.hpp"
+#include "WeaveUtils/Stopwatch.hpp"
+
+namespace Weave::Effects
+{
+	/// <summary>
+	/// Library build pipeline stages timed by BuildProfiler
+	/// </summary>
+	enum class BuildStages : uint
+	{
+		Preprocess,
+		Dedupe,
+		Analyze,
+		Parse,
+		Generate,
+		Compile,
+		Commit,
+		Count
+	};
+
+	/// <summary>
+	/// Number of counters recorded per stage event
+	/// </summary>
+	constexpr uint g_BuildCounterCount = 2;
+
+	/// <summary>
+	/// Timed span of a single pipeline stage for one variant
+	/// </summary>
+	struct BuildEvent
+	{
+		BuildStages stage;
+		uint repoID;
+		uint configID;
+		uint threadID;
+		slong startNS;
+		slong durationNS;
+		// Stage-specific counters. See BuildProfiler::GetCounterName().
+		ulong counters[g_BuildCounterCount];
+	};
+
+	/// <summary>
+	/// Sum of all events recorded for a stage
+	/// </summary>
+	struct BuildStageTotals
+	{
+		uint count;
+		slong timeNS;
+		slong maxNS;
+		ulong counters[g_BuildCounterCount];
+	};
+
+	/// <summary>
+	/// Records per-stage and per-variant timings and counters for library builds. Events can be
+	/// written as a Chrome trace or logged as a summary table. Safe to use from multiple threads.
+	/// </summary>
+	class BuildProfiler
+	{
+	public:
+		/// <summary>
+		/// Times a stage from construction to destruction and records it with the counters set in
+		/// between. Does nothing if the profiler is null.
+		/// </summary>
+		class Scope
+		{
+		public:
+			MAKE_IMMOVABLE(Scope)
+
+			Scope(BuildProfiler* pProfiler, BuildStages stage, uint configID);
+
+			~Scope();
+
+			/// <summary>
+			/// Sets the value of the given stage counter
+			/// </summary>
+			void SetCounter(uint index, ulong value) { event.counters[index] = value; }
+
+			/// <summary>
+			/// Adds to the value of the given stage counter
+			/// </summary>
+			void AddCounter(uint index, ulong value) { event.counters[index] += value; }
+
+		private:
+			BuildProfiler* pProfiler;
+			BuildEvent event;
+		};
+
+		MAKE_IMMOVABLE(BuildProfiler)
+
+		BuildProfiler();
+
+		/// <summary>
+		/// Starts a new repo. Events recorded afterward are attributed to it.
+		/// </summary>
+		void BeginRepo(string_view name);
+
+		/// <summary>
+		/// Returns the time elapsed since the profiler was created or cleared
+		/// </summary>
+		slong GetTimeNS() const;
+
+		/// <summary>
+		/// Records a finished stage event, assigning the calling thread's ID
+		/// </summary>
+		void AddEvent(const BuildEvent& event);
+
+		/// <summary>
+		/// Returns the combined time and counters of every event recorded for the given stage
+		/// </summary>
+		BuildStageTotals GetStageTotals(BuildStages stage) const;
+
+		/// <summary>
+		/// Returns the name of the given stage
+		/// </summary>
+		static string_view GetStageName(BuildStages stage);
+
+		/// <summary>
+		/// Returns the name of a counter recorded for the given stage, or an empty string if
+		/// the stage doesn't use it
+		/// </summary>
+		static string_view GetCounterName(BuildStages stage, uint index);
+
+		/// <summary>
+		/// Writes recorded events in Chrome trace event JSON format
+		/// </summary>
+		void WriteChromeTrace(std::ostream& dst) const;
+
+		/// <summary>
+		/// Logs total time and counters for each stage, followed by the slowest variants
+		/// </summary>
+		void LogSummary() const;
+
+		/// <summary>
+		/// Removes all recorded events and repos and restarts the clock
+		/// </summary>
+		void Clear();
+
+	private:
+		mutable std::mutex mutex;
+		Stopwatch::TimePoint startTime;
+		UniqueVector<string> repoNames;
+		UniqueVector<BuildEvent> events;
+		// Thread -> compact ID used in traces
+		std::unordered_map<std::thread::id, uint> threadIDs;
+	};
+}
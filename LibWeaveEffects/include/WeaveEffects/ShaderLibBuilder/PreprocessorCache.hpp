@@ -0,0 +1,98 @@
+#pragma once
+#include <bitset>
+#include <mutex>
+#include <unordered_map>
+#include "WeaveEffects/ShaderLibBuilder/VariantPreprocessor.hpp"
+
+namespace Weave::Effects
+{
+	/// <summary>
+	/// Variant flags and modes that can affect the output of a preprocessor pass. Modes are
+	/// indexed from 1, since the default mode doesn't define a macro.
+	/// </summary>
+	struct VariantMacroDeps
+	{
+		uint flagMask;
+		std::bitset<g_VariantModeLimit> modeMask;
+	};
+
+	/// <summary>
+	/// Shares preprocessor results between variants of the same source. Include files are loaded
+	/// from disk once, and the output of each preprocessor pass is stored with the variant flags
+	/// and modes it depends on, so variants that only differ in unused flags or modes reuse it
+	/// without running the preprocessor again. Safe to use from multiple threads.
+	/// </summary>
+	class PreprocessorCache
+	{
+	public:
+		MAKE_IMMOVABLE(PreprocessorCache)
+
+		PreprocessorCache();
+
+		/// <summary>
+		/// Copies the contents of the file at the given path into the buffer, loading it on first
+		/// use. Returns false if the file can't be opened.
+		/// </summary>
+		bool TryGetFile(const string& path, string& dst);
+
+		/// <summary>
+		/// Appends the output of a previous pass equivalent to the given variant to the source
+		/// buffer and returns true if one exists
+		/// </summary>
+		bool TryGetVariant(uint flagID, uint modeID, string& dst, Vector<ShaderEntrypoint>& entrypoints);
+
+		/// <summary>
+		/// Writes the flags and mode of a previous pass equivalent to the given variant and returns 
+		/// true if one exists
+		/// </summary>
+		bool TryGetEquivalent(uint flagID, uint modeID, uint& equivFlagID, uint& equivModeID) const;
+
+		/// <summary>
+		/// Stores the output of a preprocessor pass with the variant macros it depends on
+		/// </summary>
+		void AddVariant(uint flagID, uint modeID, const VariantMacroDeps& deps, string_view src,
+			const IDynamicArray<ShaderEntrypoint>& entrypoints);
+
+		/// <summary>
+		/// Returns the number of variants reused since the last reset
+		/// </summary>
+		uint GetHitCount() const;
+
+		/// <summary>
+		/// Clears stored variants. Cached files are kept.
+		/// </summary>
+		void ClearVariants();
+
+		/// <summary>
+		/// Clears stored variants and cached files
+		/// </summary>
+		void Clear();
+
+	private:
+		struct VariantRef
+		{
+			uint flagID;
+			uint modeID;
+			VariantMacroDeps deps;
+			uint srcStart;
+			uint srcLength;
+			uint epStart;
+			uint epCount;
+		};
+
+		mutable std::mutex cacheMutex;
+		// Path -> file contents
+		std::unordered_map<string, string> fileMap;
+
+		UniqueVector<VariantRef> variants;
+		string srcBuf;
+		UniqueVector<ShaderEntrypoint> epBuf;
+		uint hitCount;
+
+		/// <summary>
+		/// Returns true if a variant with the given flags and modes evaluates every variant macro
+		/// tested by the stored pass the same way
+		/// </summary>
+		static bool GetIsEquivalent(const VariantRef& ref, uint flagID, uint modeID);
+	};
+}
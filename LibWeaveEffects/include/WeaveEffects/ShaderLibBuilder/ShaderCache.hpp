@@ -0,0 +1,78 @@
+#pragma once
+#include <atomic>
+#include <filesystem>
+#include "WeaveUtils/Hash.hpp"
+#include "WeaveEffects/ShaderData.hpp"
+
+namespace Weave::Effects
+{
+	/// <summary>
+	/// Content-addressed on-disk cache of precompiled shader bytecode. Entries are keyed by a hash
+	/// of the generated source and every compiler input that affects the output. Safe to use
+	/// from multiple threads.
+	/// </summary>
+	class ShaderCache
+	{
+	public:
+		MAKE_IMMOVABLE(ShaderCache)
+
+		/// <summary>
+		/// Initializes a cache stored in the given directory, creating it if necessary
+		/// </summary>
+		explicit ShaderCache(string_view cacheDir);
+
+		/// <summary>
+		/// Returns the directory used to store cached bytecode
+		/// </summary>
+		const std::filesystem::path& GetCacheDir() const;
+
+		/// <summary>
+		/// Calculates the cache key for a shader compiled with the given configuration
+		/// </summary>
+		static Hash128 GetKey(
+			string_view srcFile,
+			string_view srcText,
+			ShadeStages stage,
+			string_view mainName,
+			string_view featureLevel,
+			bool isDebugging,
+			string_view compilerVersion
+		);
+
+		/// <summary>
+		/// Appends cached bytecode for the given key to the buffer and returns true if an entry
+		/// exists. Missing or corrupt entries return false.
+		/// </summary>
+		bool TryGetShader(const Hash128& key, Vector<byte>& byteCode);
+
+		/// <summary>
+		/// Writes bytecode to the cache under the given key. Failures are logged and ignored.
+		/// </summary>
+		void AddShader(const Hash128& key, const IDynamicArray<byte>& byteCode);
+
+		/// <summary>
+		/// Returns the number of successful lookups since the last reset
+		/// </summary>
+		uint GetHitCount() const;
+
+		/// <summary>
+		/// Returns the number of failed lookups since the last reset
+		/// </summary>
+		uint GetMissCount() const;
+
+		/// <summary>
+		/// Resets hit and miss counters
+		/// </summary>
+		void ResetStats();
+
+	private:
+		std::filesystem::path cacheDir;
+		std::atomic<uint> hitCount;
+		std::atomic<uint> missCount;
+
+		/// <summary>
+		/// Returns the path of the cache entry for the given key
+		/// </summary>
+		std::filesystem::path GetEntryPath(const Hash128& key) const;
+	};
+}
@@ -4,6 +4,122 @@
 
 namespace Weave::Effects
 { 
+	class SymbolTable;
+
+	/// <summary>
+	/// Generated HLSL for a single shader along with the parsed variant it was generated from
+	/// </summary>
+	struct ShaderSourceDesc
+	{
+		string_view srcFile;
+		string_view srcText;
+		string_view mainName;
+		ShadeStages stage;
+
+		/// <summary>
+		/// Parsed variant source. Optional for backends that only need the HLSL.
+		/// </summary>
+		const SymbolTable* pTable;
+
+		/// <summary>
+		/// SymbolID of the entrypoint function in pTable
+		/// </summary>
+		int mainID;
+	};
+
+	/// <summary>
+	/// Interface for backends that precompile generated HLSL and register the resulting bytecode
+	/// with its reflected metadata
+	/// </summary>
+	class IShaderCompiler
+	{
+	public:
+		virtual ~IShaderCompiler() = default;
+
+		/// <summary>
+		/// Returns a string identifying the compiler and its version. Bytecode from different
+		/// versions is never interchangeable.
+		/// </summary>
+		virtual string_view GetCompilerVersion() const = 0;
+
+		/// <summary>
+		/// Precompiles the given shader and appends the bytecode to the buffer without registering
+		/// it. Safe to call concurrently from multiple threads.
+		/// </summary>
+		virtual void GetPrecompShader(
+			const ShaderSourceDesc& src,
+			string_view featureLevel,
+			Vector<byte>& byteCode,
+			bool isDebugging = false
+		) const = 0;
+
+		/// <summary>
+		/// Adds bytecode precompiled with GetPrecompShader() to the registry and generates metadata 
+		/// for resources required by the shader
+		/// </summary>
+		virtual uint GetShaderDef(
+			string_view srcFile,
+			const IDynamicArray<byte>& byteCode,
+			ShadeStages stage,
+			string_view mainName,
+			ShaderRegistryBuilder& builder
+		) const = 0;
+	};
+
+#ifdef _WIN32
+	/// <summary>
+	/// Compiles and reflects shaders with the D3D11 shader compiler. Requires Windows.
+	/// </summary>
+	class ShaderCompilerD3D11 : public IShaderCompiler
+	{
+	public:
+		string_view GetCompilerVersion() const override;
+
+		void GetPrecompShader(
+			const ShaderSourceDesc& src,
+			string_view featureLevel,
+			Vector<byte>& byteCode,
+			bool isDebugging = false
+		) const override;
+
+		uint GetShaderDef(
+			string_view srcFile,
+			const IDynamicArray<byte>& byteCode,
+			ShadeStages stage,
+			string_view mainName,
+			ShaderRegistryBuilder& builder
+		) const override;
+	};
+#endif
+
+	/// <summary>
+	/// Platform independent stand-in for a native compiler. Emits deterministic placeholder 
+	/// bytecode and derives IO layouts, constant buffers and resources from the parsed source
+	/// instead of compiled output. Intended for headless builds, profiling and regression 
+	/// testing of the library pipeline. Libraries built this way can't be loaded by a renderer.
+	/// </summary>
+	class ShaderCompilerReflect : public IShaderCompiler
+	{
+	public:
+		string_view GetCompilerVersion() const override;
+
+		void GetPrecompShader(
+			const ShaderSourceDesc& src,
+			string_view featureLevel,
+			Vector<byte>& byteCode,
+			bool isDebugging = false
+		) const override;
+
+		uint GetShaderDef(
+			string_view srcFile,
+			const IDynamicArray<byte>& byteCode,
+			ShadeStages stage,
+			string_view mainName,
+			ShaderRegistryBuilder& builder
+		) const override;
+	};
+
+#ifdef _WIN32
 	/// <summary>
 	/// Precompiles the given HLSL source for D3D11 and generates metadata for resources required by the shader
 	/// </summary>
@@ -18,7 +134,35 @@ namespace Weave::Effects
 	);
 
 	/// <summary>
-	/// Returns the name of the compiler used for D3D11
+	/// Precompiles the given HLSL source for D3D11 and appends the bytecode to the given buffer without
+	/// registering it. Safe to call concurrently from multiple threads.
+	/// </summary>
+	void GetPrecompShaderD3D11(
+		string_view srcFile,
+		string_view srcText,
+		string_view featureLevel,
+		ShadeStages stage,
+		string_view mainName,
+		Vector<byte>& byteCode,
+		bool isDebugging = false
+	);
+
+	/// <summary>
+	/// Adds bytecode precompiled with GetPrecompShaderD3D11() to the registry and generates metadata 
+	/// for resources required by the shader
+	/// </summary>
+	uint GetShaderDefD3D11(
+		string_view srcFile,
+		const IDynamicArray<byte>& byteCode,
+		ShadeStages stage,
+		string_view mainName,
+		ShaderRegistryBuilder& builder
+	);
+
+	/// <summary>
+	/// Returns the name and file version of the compiler used for D3D11, 
+	/// e.g. d3dcompiler_47.dll 10.0.22621.3233
 	/// </summary>
 	string_view GetCompilerVersionD3D11();
+#endif
 }
\ No newline at end of file
@@ -1,4 +1,5 @@
 #pragma once
+#include <unordered_map>
 #include "SymbolTable.hpp"
 #include "WeaveUtils/TextBlock.hpp"
 
@@ -23,6 +24,22 @@ namespace Weave::Effects
 		int GetLastBlock() const;
 	};
 
+	/// <summary>
+	/// Source range of a function or struct definition that is only emitted if it's reachable
+	/// from the entrypoint
+	/// </summary>
+	struct DefinitionRange
+	{
+		int blockStart;
+		int blockCount;
+
+		/// <summary>
+		/// Next definition with the same name, -1 if last
+		/// </summary>
+		int next;
+		bool isReachable;
+	};
+
 	/// <summary>
 	/// Generates HLSL from a library file
 	/// </summary>
@@ -41,6 +58,12 @@ namespace Weave::Effects
 		string globalVarDefBuf;
 		UniqueVector<SourceMask> sourceMasks;
 
+		UniqueVector<DefinitionRange> defRanges;
+		std::unordered_map<string_view, int> defNameMap;
+		// Definition owning each block, -1 if unowned, -2 if masked
+		UniqueVector<int> blockDefs;
+		UniqueVector<int> defQueue;
+
 		/// <summary>
 		/// Writes a copy of the source with masking applied
 		/// </summary>
@@ -64,6 +87,24 @@ namespace Weave::Effects
 		/// </summary>
 		void GenerateGlobalCBuffer(const SymbolTable& table, const IDynamicArray<LexBlock>& srcBlocks);
 
+		/// <summary>
+		/// Masks out function and struct definitions visible to the entrypoint that can't be reached 
+		/// from it. Everything else left unmasked is treated as a root, and definitions are reached
+		/// transitively through identifiers referenced in emitted source.
+		/// </summary>
+		void MaskUnreachableDefinitions(const SymbolTable& table, const IDynamicArray<LexBlock>& srcBlocks, 
+			const ShaderEntrypoint& main);
+
+		/// <summary>
+		/// Adds the function and struct definitions declared directly in the given scope
+		/// </summary>
+		void AddScopeDefinitions(ScopeHandle scope, const IDynamicArray<LexBlock>& srcBlocks, const int main);
+
+		/// <summary>
+		/// Marks definitions named by identifiers in the given text as reachable and queues them
+		/// </summary>
+		void AddReferences(string_view text);
+
 		/// <summary>
 		/// Masks out a scope along with its declaring symbol. Masks content of the scope unless
 		/// otherwise indicated.
@@ -1,10 +1,9 @@
 #pragma once
-#include <forward_list>
-#include <list>
-#include <unordered_map>
+#include <iterator>
 #include "SymbolEnums.hpp"
 #include "ShaderTypeInfo.hpp"
 #include "WeaveUtils/Span.hpp"
+#include "WeaveUtils/StringArena.hpp"
 
 namespace Weave::Effects
 {
@@ -16,9 +15,193 @@ namespace Weave::Effects
     struct ScopeData;
     struct AttributeData;
 
-    using IDList = std::list<int>;
-    using NameIndexMap = std::unordered_map<string_view, int>;
-    using FuncOverloadMap = std::unordered_map<string_view, IDList>;
+    /// <summary>
+    /// Node in a singly linked list of IDs stored in a shared pool
+    /// </summary>
+    struct IDListNode
+    {
+        int id;
+        int next;
+    };
+
+    /// <summary>
+    /// Read-only list of IDs allocated from a ScopeBuilder's node pool. Most recently added 
+    /// IDs come first.
+    /// </summary>
+    class IDList
+    {
+    public:
+        class Iterator
+        {
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = int;
+            using difference_type = ptrdiff_t;
+            using pointer = const int*;
+            using reference = const int&;
+
+            Iterator() : pNodes(nullptr), index(-1) { }
+
+            Iterator(const IDynamicArray<IDListNode>* pNodes, int index) : pNodes(pNodes), index(index) { }
+
+            reference operator*() const { return (*pNodes)[index].id; }
+
+            Iterator& operator++() { index = (*pNodes)[index].next; return *this; }
+
+            Iterator operator++(int) { Iterator last = *this; ++(*this); return last; }
+
+            bool operator==(const Iterator& rhs) const { return index == rhs.index; }
+
+        private:
+            const IDynamicArray<IDListNode>* pNodes;
+            int index;
+        };
+
+        IDList() : pNodes(nullptr), head(-1), length(0) { }
+
+        explicit IDList(const IDynamicArray<IDListNode>& nodes) : pNodes(&nodes), head(-1), length(0) { }
+
+        /// <summary>
+        /// Returns the most recently added ID
+        /// </summary>
+        int GetFront() const { return (*pNodes)[head].id; }
+
+        size_t GetLength() const { return length; }
+
+        bool IsEmpty() const { return length == 0; }
+
+        Iterator begin() const { return Iterator(pNodes, head); }
+
+        Iterator end() const { return Iterator(pNodes, -1); }
+
+    private:
+        friend class ScopeBuilder;
+
+        const IDynamicArray<IDListNode>* pNodes;
+        int head;
+        int length;
+    };
+
+    /// <summary>
+    /// Flat open addressing table interning names to sequential integer IDs. Cleared in constant 
+    /// time by advancing a generation counter instead of resetting slots.
+    /// </summary>
+    class NameIDTable
+    {
+    public:
+        MAKE_MOVE_ONLY(NameIDTable)
+
+        NameIDTable();
+
+        /// <summary>
+        /// Returns the ID of the given name, or -1 if it hasn't been added
+        /// </summary>
+        int TryGetID(string_view name) const;
+
+        /// <summary>
+        /// Returns the ID of the given name, adding it if it doesn't exist
+        /// </summary>
+        int GetOrAddID(string_view name);
+
+        void Clear();
+
+    private:
+        struct Slot
+        {
+            string_view name;
+            ulong hash;
+            int id;
+            uint generation;
+        };
+
+        UniqueArray<Slot> slots;
+        uint count;
+        uint generation;
+
+        /// <summary>
+        /// Returns the index of the slot holding the name or the empty slot it would be added to
+        /// </summary>
+        uint FindSlot(const ulong hash, string_view name) const;
+
+        void Grow();
+    };
+
+    /// <summary>
+    /// Binding of an interned name to a value within a scope
+    /// </summary>
+    struct ScopeBinding
+    {
+        int nameID;
+        int scopeID;
+        int value;
+
+        /// <summary>
+        /// Next binding of the same name in any scope, -1 if last
+        /// </summary>
+        int next;
+
+        /// <summary>
+        /// Next binding of the same name in an enclosing open scope, -1 if last
+        /// </summary>
+        int nextActive;
+
+        /// <summary>
+        /// Next binding in the same scope, -1 if last
+        /// </summary>
+        int nextInScope;
+    };
+
+    /// <summary>
+    /// Maps interned names within scopes to integer values. Each name keeps a stack of its bindings 
+    /// in open scopes, so resolving a name from the innermost scope takes a single lookup regardless 
+    /// of nesting depth. Bindings in closed scopes remain reachable through each name's binding list.
+    /// </summary>
+    class ScopeNameTable
+    {
+    public:
+        MAKE_MOVE_ONLY(ScopeNameTable)
+
+        ScopeNameTable();
+
+        /// <summary>
+        /// Returns the value of the name in the given scope, or -1 if it doesn't exist
+        /// </summary>
+        int TryGetValue(const int scopeID, const int nameID) const;
+
+        /// <summary>
+        /// Returns the value bound to the name in the innermost open scope declaring it, or -1 if 
+        /// no open scope does
+        /// </summary>
+        int TryGetActiveValue(const int nameID) const;
+
+        /// <summary>
+        /// Returns the index of the most recent binding of the name in any scope, or -1 if none exist
+        /// </summary>
+        int GetFirstBinding(const int nameID) const;
+
+        const ScopeBinding& GetBinding(const int index) const;
+
+        /// <summary>
+        /// Adds a name to the innermost open scope. Returns false without adding if it already exists.
+        /// </summary>
+        bool TryAdd(const int scopeID, const int nameID, const int value);
+
+        /// <summary>
+        /// Removes the bindings of the innermost open scope from their name stacks
+        /// </summary>
+        void PopScope(const int scopeID);
+
+        void Clear();
+
+    private:
+        UniqueVector<ScopeBinding> bindings;
+        // Name ID -> most recent binding
+        UniqueVector<int> nameHeads;
+        // Name ID -> innermost binding in an open scope
+        UniqueVector<int> activeHeads;
+        // Scope ID -> most recent binding in the scope
+        UniqueVector<int> scopeHeads;
+    };
 
     /// <summary>
     /// Stores a collection of symbols and tokens owned by scoping objects
@@ -26,7 +209,8 @@ namespace Weave::Effects
     class ScopeBuilder
     {
     public:
-        MAKE_MOVE_ONLY(ScopeBuilder)
+        // Overload lists reference the builder's node pool
+        MAKE_IMMOVABLE(ScopeBuilder)
 
         ScopeBuilder();
 
@@ -194,12 +378,29 @@ namespace Weave::Effects
         void Clear();
 
     private:
+        UniqueVector<ScopeData> scopes;
+
         /// <summary>
-        /// Lookup tables for each symbol in each scope, parallel with scopes vector
+        /// Symbol and function names interned for scope lookups
+        /// </summary>
+        NameIDTable nameIDs;
+
+        /// <summary>
+        /// Symbol IDs by name and scope
+        /// </summary>
+        ScopeNameTable scopeSymbolTable;
+
+        /// <summary>
+        /// Function overload list indices by name and scope
+        /// </summary>
+        ScopeNameTable funcOverloadTable;
+        UniqueVector<IDList> funcOverloads;
+        UniqueVector<IDListNode> overloadNodes;
+
+        /// <summary>
+        /// Symbols in each scope, parallel with scopes vector. Lists beyond the scope count are 
+        /// retained between clears for reuse.
         /// </summary>
-        UniqueVector<ScopeData> scopes;
-        UniqueVector<NameIndexMap> scopeSymbolMaps;
-        UniqueVector<FuncOverloadMap> funcOverloadMaps;
         UniqueVector<UniqueVector<int>> scopeSymbolLists;
 
         UniqueVector<TokenNode> tokens;
@@ -211,7 +412,7 @@ namespace Weave::Effects
         UniqueVector<AttributeData> attributes;
 
         UniqueVector<int> deferredSymbolBuf;
-        std::forward_list<string> generatedText;
+        StringArena generatedText;
 
         int topScope;
         int pendingScopeSymbol;
@@ -221,5 +422,11 @@ namespace Weave::Effects
         void AddScope(const int symbolID, const int blockStart = 0, const int blockCount = 0);
 
         void AddFuncToOverloadTable(const string_view name, const int symbolID);
+
+        /// <summary>
+        /// Returns the value bound to the name in the innermost scope enclosing the top scope, 
+        /// or -1 if none exists
+        /// </summary>
+        int TryResolveName(const ScopeNameTable& table, string_view name, int top) const;
     };
 }
\ No newline at end of file
@@ -161,6 +161,12 @@ namespace Weave::Effects
         /// </summary>
         int parentScope;
 
+        /// <summary>
+        /// Index of the last scope nested within this scope. Scopes still open when 
+        /// parsing extend to the end of the scope list.
+        /// </summary>
+        int lastChildScope;
+
         /// <summary>
         /// Index of the first block in the body of the scope, the opening '{'
         /// bracket.
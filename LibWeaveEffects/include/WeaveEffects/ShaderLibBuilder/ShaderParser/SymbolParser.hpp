@@ -1,5 +1,6 @@
 #pragma once
 #include <queue>
+#include <unordered_map>
 #include <tuple>
 #include <memory>
 #include "SymbolData.hpp"
@@ -15,6 +16,46 @@ namespace Weave::Effects
     using std::tuple;
     using std::unique_ptr;
 
+    /// <summary>
+    /// Result of a cached pattern match. Block indices are relative to the start of the match.
+    /// </summary>
+    struct MatchCacheEntry
+    {
+        TokenTypes startFlags;
+
+        /// <summary>
+        /// Range of blocks read by the matcher, and the offset of their types in the cache
+        /// </summary>
+        int readStart;
+        int readCount;
+        int typeStart;
+
+        /// <summary>
+        /// Number of blocks matched, -1 on failure
+        /// </summary>
+        int length;
+
+        int groupStart;
+        int groupCount;
+        int subGroupCount;
+        int capStart;
+        int capCount;
+
+        /// <summary>
+        /// Next entry with the same start block, -1 if last
+        /// </summary>
+        int next;
+    };
+
+    /// <summary>
+    /// Most recent cached match for a start block type and flags, and the length of its chain
+    /// </summary>
+    struct MatchCacheChain
+    {
+        int head;
+        int length;
+    };
+
     /// <summary>
     /// A reusable shader parser for identifying symbols and tokens from a set of preprocessed LexBlocks
     /// </summary>
@@ -51,6 +92,24 @@ namespace Weave::Effects
 
         std::stringstream textBuf;
 
+        /// <summary>
+        /// Range of blocks read by the pattern matcher since the last reset
+        /// </summary>
+        int readStart;
+        int readEnd;
+
+        /// <summary>
+        /// Individual pattern matches from previous declarations and variants. Matching only reads 
+        /// block types, so a match can be replayed anywhere the same types occupy the range it read. 
+        /// Only the most recent entries for each start block are checked, and the whole cache is 
+        /// reset once it reaches a fixed size.
+        /// </summary>
+        UniqueVector<MatchCacheEntry> matchCache;
+        UniqueVector<LexBlockTypes> matchCacheTypes;
+        UniqueVector<CaptureGroup> matchCacheGroups;
+        UniqueVector<CaptureBlock> matchCacheCaptures;
+        std::unordered_map<ulong, MatchCacheChain> matchCacheHeads;
+
         /// <summary>
         /// Parses relevant symbols and tokens from source
         /// </summary>
@@ -81,17 +140,39 @@ namespace Weave::Effects
 
         /// <summary>
         /// Attempts to match a LexBlock at the given index with a matching pattern that uses the given
-        /// token flags
+        /// token flags. Reuses cached matches where possible.
         /// </summary>
         int TryMatchPatternType(const int start, const TokenTypes startFlags);
 
+        /// <summary>
+        /// Matches a LexBlock at the given index against each root pattern that uses the given token
+        /// flags
+        /// </summary>
+        int MatchPatternType(const int start, const TokenTypes startFlags);
+
         int GetDirectiveEnd(int start, const int dir);
 
+        /// <summary>
+        /// Restores the captures and length of a previous match with the same start flags over the
+        /// same block types. Returns false if there isn't one.
+        /// </summary>
+        bool TryGetCachedMatch(const int start, const TokenTypes startFlags, int& length);
+
+        /// <summary>
+        /// Caches the result of the last match attempt using the range of blocks it read
+        /// </summary>
+        void CacheMatch(const int start, const TokenTypes startFlags, const int length);
+
         /// <summary>
         /// Clears previous matches
         /// </summary>
         void ClearMatchBuffers();
 
+        /// <summary>
+        /// Clears matches cached from previous declarations and variants
+        /// </summary>
+        void ClearMatchCache();
+
         /// <summary>
         /// Captures all symbols and tokens indicated in the capture groups
         /// </summary>
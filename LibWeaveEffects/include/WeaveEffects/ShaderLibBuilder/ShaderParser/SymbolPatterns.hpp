@@ -349,6 +349,54 @@ namespace Weave::Effects
 		void ReversePattern();
 	};
 
+	/// <summary>
+	/// Block types a root MatchNode can start a forward match on. Computed once from the pattern 
+	/// tree so roots that can't match a block are skipped without attempting a match.
+	/// </summary>
+	class MatchStartSet
+	{
+	public:
+		/// <summary>
+		/// Initializes a set that accepts any block
+		/// </summary>
+		MatchStartSet();
+
+		/// <summary>
+		/// Computes the start set for the given root node
+		/// </summary>
+		explicit MatchStartSet(const MatchNode& root);
+
+		/// <summary>
+		/// Returns false if a match starting on a block of the given type is impossible
+		/// </summary>
+		bool GetCanStartWith(LexBlockTypes type) const;
+
+	private:
+		static constexpr uint MaxTypes = 16;
+
+		/// <summary>
+		/// Block qualifier types that can match the first block. A block is accepted if all of 
+		/// its flags are included in any one of them.
+		/// </summary>
+		LexBlockTypes types[MaxTypes];
+		uint count;
+		bool isAny;
+
+		void AddType(LexBlockTypes type);
+
+		/// <summary>
+		/// Adds the types the node can start on and returns true if it can match without 
+		/// consuming the first block
+		/// </summary>
+		bool AddNode(const MatchNode& node);
+
+		/// <summary>
+		/// Adds the types the pattern can start on and returns true if it can match without 
+		/// consuming the first block
+		/// </summary>
+		bool AddPattern(const MatchPattern& pattern, bool isOptional);
+	};
+
 	/// <summary>
 	/// Groups a set of match nodes based on the type of keyword in the first block
 	/// </summary>
@@ -367,6 +415,11 @@ namespace Weave::Effects
 		/// </summary>
 		DynamicArray<MatchNode> rootNodes;
 
+		/// <summary>
+		/// Start sets for each root node, in parallel
+		/// </summary>
+		DynamicArray<MatchStartSet> rootStarts;
+
 		MatchNodeGroup() = default;
 
 		MatchNodeGroup(
@@ -1,10 +1,11 @@
 #pragma once
-#include <unordered_set>
-#include <functional>
+#include <mutex>
+#include <atomic>
 #include "WeaveEffects/ShaderData.hpp"
 #include "WeaveUtils/StringIDBuilder.hpp"
 #include "WeaveUtils/VectorSpan.hpp"
 #include "WeaveUtils/ObjectPool.hpp"
+#include "WeaveUtils/Hash.hpp"
 
 namespace Weave::Effects
 {
@@ -28,60 +29,14 @@ namespace Weave::Effects
 	};
 
 	/// <summary>
-	/// A wrapper for hashing heterogeneous types
-	/// </summary>
-	class HashHandle
-	{
-	public:
-		using HashFunc = std::function<size_t(const HashHandle&)>;
-		using IsEqFunc = std::function<bool(const HashHandle&, const HashHandle&)>;
-
-		HashHandle();
-
-		HashHandle(const uint id, const HashFunc& getHash, const IsEqFunc& getIsEq);
-
-		uint GetID() const;
-
-		uint GetIndex() const;
-
-		ResourceType GetType() const;
-
-		size_t GetHash() const;
-
-		bool operator==(const HashHandle& rhs) const;
-
-	private:
-		const HashFunc* pGetHash;
-		const IsEqFunc* pGetIsEqual;
-		uint id;
-	};
-}
-
-namespace std
-{
-	using HashHandle = Weave::Effects::HashHandle;
-
-	/// <summary>
-	/// HashHandle std::hash specialization for unordered_set
-	/// </summary>
-	template<>
-	struct hash<HashHandle>
-	{
-		size_t operator()(const HashHandle& handle) const noexcept { return handle.GetHash(); }
-	};
-}
-
-namespace Weave::Effects
-{
-	/// <summary>
-	/// Builds a set of unique shaders, effects and supporting resources and assigns each a unique uint32_t ID
+	/// Builds a set of unique shaders, effects and supporting resources and assigns each a unique uint32_t ID.
+	/// GetOrAdd functions and temporary buffers are thread safe. IDs are assigned in the order values are 
+	/// first added, so callers needing deterministic IDs must still add them in a fixed order. Getters and 
+	/// definition handles must not be used while values are being added from other threads.
 	/// </summary>
 	class ShaderRegistryBuilder
 	{
 	public:
-		using HashFunc = HashHandle::HashFunc;
-		using IsEqFunc = HashHandle::IsEqFunc;
-
 		MAKE_IMMOVABLE(ShaderRegistryBuilder)
 
 		ShaderRegistryBuilder();
@@ -191,7 +146,8 @@ namespace Weave::Effects
 
 	private:
 		/// <summary>
-		/// Vector template that allows hashing members with HashHandles
+		/// Vector template that indexes its members by value in an open addressing hash table. 
+		/// Each table has its own lock, so adding values of different types never contends.
 		/// </summary>
 		template<typename VecT, ResourceType typeEnum>
 		class HashableVector : public VecT
@@ -201,21 +157,36 @@ namespace Weave::Effects
 			using const_reference = typename VecT::const_reference;
 			static constexpr ResourceType ResType = typeEnum;
 
-			HashableVector()
+			HashableVector() :
+				slots(s_MinSlots)
+			{ }
+
+			/// <summary>
+			/// Returns the ID of the member equal to the given value, adding it if it doesn't
+			/// exist. Sets isNew to true if the value was added.
+			/// </summary>
+			template<typename T>
+			uint GetOrAdd(const T& value, bool& isNew)
 			{
-				GetIsMemberEq = [this](const HashHandle& lhs, const HashHandle& rhs) -> bool
-				{
-					return this->at(lhs.GetIndex()) == this->at(rhs.GetIndex());
-				};
-				GetMemberHash = [this](const HashHandle& handle) -> size_t
-				{
-					return std::hash<value_type>{}(this->at(handle.GetIndex()));
-				};
-			}
+				const size_t hash = GetValueHash(value);
+				std::lock_guard lock(tableMutex);
+
+				// Keeps the load factor at or below 3/4
+				if (4 * (this->GetLength() + 1) > 3 * slots.GetLength())
+					Grow();
 
-			const HashFunc& GetHashFunc() const { return GetMemberHash; }
+				Slot& slot = slots[FindSlot(hash, value)];
+				isNew = (slot.index == -1);
+
+				if (isNew)
+				{
+					const uint index = (uint)this->GetLength();
+					this->Add(value);
+					slot = { hash, index };
+				}
 
-			const IsEqFunc& GetEqFunc() const { return GetIsMemberEq; }
+				return SetResourceType(slot.index, typeEnum);
+			}
 
 			const_reference GetValue(const uint id) const
 			{
@@ -225,19 +196,92 @@ namespace Weave::Effects
 					FX_THROW("Resource type ID mismatch");
 			}
 
+			void Clear()
+			{
+				VecT::Clear();
+
+				for (Slot& slot : slots)
+					slot.index = -1;
+			}
+
 		private:
-			HashFunc GetMemberHash;
-			IsEqFunc GetIsMemberEq;
+			static constexpr uint s_MinSlots = 64;
+
+			struct Slot
+			{
+				size_t hash = 0;
+				// Member index, -1 if empty
+				uint index = (uint)-1;
+			};
+
+			UniqueArray<Slot> slots;
+			std::mutex tableMutex;
+
+			/// <summary>
+			/// Spans are hashed as raw bytes rather than combining per-element hashes
+			/// </summary>
+			template<typename T>
+			static size_t GetValueHash(const T& value)
+			{
+				if constexpr (requires { GetHash64(value); })
+					return (size_t)GetHash64(value);
+				else if constexpr (requires { value.GetHash(); })
+					return value.GetHash();
+				else
+					return std::hash<T>{}(value);
+			}
+
+			template<typename T>
+			bool GetIsEqual(uint index, const T& value) const
+			{
+				if constexpr (requires { value.GetLength(); })
+					return GetIsArrDataEqual(this->at(index), value);
+				else
+					return this->at(index) == value;
+			}
+
+			/// <summary>
+			/// Returns the index of the slot holding the value or the empty slot it would be added to
+			/// </summary>
+			template<typename T>
+			uint FindSlot(const size_t hash, const T& value) const
+			{
+				const uint mask = (uint)slots.GetLength() - 1;
+				uint i = (uint)hash & mask;
+
+				while (slots[i].index != -1 && (slots[i].hash != hash || !GetIsEqual(slots[i].index, value)))
+					i = (i + 1) & mask;
+
+				return i;
+			}
+
+			void Grow()
+			{
+				UniqueArray<Slot> oldSlots(std::move(slots));
+				slots = UniqueArray<Slot>(2 * oldSlots.GetLength());
+				const uint mask = (uint)slots.GetLength() - 1;
+
+				for (const Slot& slot : oldSlots)
+				{
+					if (slot.index != -1)
+					{
+						uint i = (uint)slot.hash & mask;
+
+						while (slots[i].index != -1)
+							i = (i + 1) & mask;
+
+						slots[i] = slot;
+					}
+				}
+			}
 		};
 
 		ObjectPool<Vector<uint>> idBufPool;
 		ObjectPool<Vector<byte>> byteCodePool;
+		std::mutex poolMutex;
 
 		StringIDBuilder stringIDs;
-		std::unordered_set<HashHandle> resourceSet;
-
-		UniqueVector<uint> idBuffer;
-		UniqueVector<byte> byteBuffer;
+		std::mutex stringMutex;
 
 		HashableVector<UniqueVector<ConstDef>, ResourceType::Constant> constants;
 		HashableVector<UniqueVector<ConstBufDef>, ResourceType::ConstantBuffer> cbufDefs;
@@ -250,34 +294,20 @@ namespace Weave::Effects
 		HashableVector<SpanVector<uint>, ResourceType::IDGroups> idGroups;
 		HashableVector<SpanVector<byte>, ResourceType::ByteCode> binSpans;
 
-		int resCount;
-		int uniqueResCount;
+		std::atomic<int> resCount;
+		std::atomic<int> uniqueResCount;
 
 		template<typename T, typename VecT, ResourceType type>
 		uint GetOrAddValue(const T& newValue, HashableVector<VecT, type>& values)
 		{
-			const uint index = (uint)values.GetLength();
-			const uint newID = SetResourceType(index, type);
-
-			// Temporarily store new value in vector to ensure valid handle
-			values.Add(newValue);
-			// Create handle and search set
-			HashHandle handle(newID, values.GetHashFunc(), values.GetEqFunc());
-			const auto& it = resourceSet.find(handle);
+			bool isNew;
+			const uint id = values.GetOrAdd(newValue, isNew);
 			resCount++;
 
-			if (it != resourceSet.end())
-			{
-				// Value already existed, remove from vector and return existing ID
-				values.RemoveBack();
-				return it->GetID();
-			}
-			else
-			{
+			if (isNew)
 				uniqueResCount++;
-				resourceSet.emplace(handle);
-				return handle.GetID();
-			}
+
+			return id;
 		}
 	};
 }
\ No newline at end of file
@@ -1,9 +1,12 @@
 #pragma once
+#include <span>
+#include <mutex>
 #include "WeaveEffects/ShaderData.hpp"
 
 namespace Weave::Effects
 {
 	class VariantDefHandle;
+	class ShaderLibImage;
 
 	/// <summary>
 	/// Read-only interface for deduplicated shader resources
@@ -13,9 +16,11 @@ namespace Weave::Effects
 	public:
 		MAKE_NO_COPY(ShaderRegistryMap)
 
-		ShaderRegistryMap(const StringIDMapDef& strDef, const ShaderRegistryDef& def);
-
-		ShaderRegistryMap(StringIDMapDef&& strDef, ShaderRegistryDef&& def);
+		/// <summary>
+		/// Initializes a map over the registry stored in a library image. Data is accessed in
+		/// place and must outlive the map.
+		/// </summary>
+		ShaderRegistryMap(const ShaderLibImage& image);
 
 		/// <summary>
 		/// Returns string ID lookup map
@@ -41,9 +46,13 @@ namespace Weave::Effects
 
 		const ShaderDef& GetShader(uint shaderID) const;
 
-		ByteSpan GetByteCode(uint byteCodeID) const;
+		/// <summary>
+		/// Returns the shader binary with the given ID. Compressed binaries are decompressed on
+		/// first access and cached for the lifetime of the map.
+		/// </summary>
+		ByteView GetByteCode(uint byteCodeID) const;
 
-		IDSpan GetIDGroup(uint groupID) const;
+		IDView GetIDGroup(uint groupID) const;
 
 		const ResourceDef& GetResource(const uint resID) const;
 
@@ -54,8 +63,25 @@ namespace Weave::Effects
 		const ConstDef& GetConstant(const uint constID) const;
 
 	private:
-		std::unique_ptr<ShaderRegistryDef> pRegDef;
+		std::span<const ConstDef> constants;
+		std::span<const ConstBufDef> cbufDefs;
+		std::span<const IOElementDef> ioElements;
+		std::span<const ResourceDef> resources;
+		std::span<const ShaderDef> shaders;
+		std::span<const EffectDef> effects;
+		// Alternating start and length of each group in idData
+		std::span<const uint> idSpans;
+		std::span<const uint> idData;
+		// Alternating start and length of each binary in binData
+		std::span<const uint> binSpans;
+		std::span<const byte> binData;
+		// Uncompressed size of each binary
+		std::span<const uint> binRawSizes;
 		StringIDMap stringMap;
 
+		// Lazily decompressed binaries, indexed like binRawSizes
+		mutable UniqueArray<Vector<byte>> decodedBins;
+		mutable std::mutex decodeMutex;
+
 	};
 }
\ No newline at end of file
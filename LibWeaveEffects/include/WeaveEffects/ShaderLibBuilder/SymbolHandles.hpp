@@ -1,6 +1,5 @@
 #pragma once
 #include <optional>
-#include <list>
 #include <string_view>
 #include "ShaderParser/SymbolEnums.hpp"
 #include "ShaderParser/ShaderTypeInfo.hpp"
@@ -13,10 +12,10 @@ namespace Weave::Effects
 	class VarHandle;
 	class SymbolHandle;
 	class ScopeHandle;
+	class IDList;
 
 	using std::string_view;
 	using std::optional;
-	using IDList = std::list<int>;
 
 	/// <summary>
 	/// Wrapper providing an interface to tokens 
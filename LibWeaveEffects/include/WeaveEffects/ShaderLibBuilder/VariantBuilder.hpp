@@ -0,0 +1,213 @@
+#pragma once
+#include <unordered_map>
+#include <memory>
+#include "WeaveUtils/StringIDBuilder.hpp"
+#include "WeaveUtils/Hash.hpp"
+#include "WeaveEffects/ShaderLibBuilder/ShaderEntrypoint.hpp"
+#include "WeaveEffects/ShaderData.hpp"
+
+namespace Weave::Effects
+{
+	using std::unique_ptr;
+
+	class VariantPreprocessor;
+	class BlockAnalyzer;
+	class SymbolTable;
+	class ShaderRegistryBuilder;
+	class ShaderCache;
+	class PreprocessorCache;
+	class IShaderCompiler;
+	class ScopeHandle;
+	class BuildProfiler;
+
+	/// <summary>
+	/// Preprocesses, parses and precompiles a single library variant without modifying the shared
+	/// registry. Separate builders can process different variants concurrently. Results are added to
+	/// the registry afterward with Commit(), in variant order, to keep registry IDs deterministic.
+	/// </summary>
+	class VariantBuilder
+	{
+	public:
+		MAKE_MOVE_ONLY(VariantBuilder)
+
+		VariantBuilder();
+
+		~VariantBuilder();
+
+		/// <summary>
+		/// Initializes the builder to the given effect source
+		/// </summary>
+		void SetSrc(string_view libPath, string_view libSrc);
+
+		/// <summary>
+		/// Copies variant flags and modes from another builder initialized to the same source
+		/// </summary>
+		void SetVariantConfig(const VariantBuilder& other);
+
+		/// <summary>
+		/// Sets the profiler used to record stage timings and counters. Null disables profiling.
+		/// </summary>
+		void SetProfiler(BuildProfiler* pProfiler);
+
+		/// <summary>
+		/// Returns the preprocessor used to generate variants
+		/// </summary>
+		const VariantPreprocessor& GetPreprocessor() const;
+
+		/// <summary>
+		/// Generates the preprocessed source for the given variant. Output is reused from 
+		/// equivalent variants when a cache is given.
+		/// </summary>
+		void Preprocess(uint configID, PreprocessorCache* pCache = nullptr);
+
+		/// <summary>
+		/// Returns the configID of the last variant preprocessed
+		/// </summary>
+		uint GetConfigID() const;
+
+		/// <summary>
+		/// Returns the preprocessed source of the current variant
+		/// </summary>
+		string_view GetVariantSrc() const;
+
+		/// <summary>
+		/// Parses the preprocessed variant and identifies its shaders and effects
+		/// </summary>
+		void Parse();
+
+		/// <summary>
+		/// Returns the number of shaders in the parsed variant
+		/// </summary>
+		uint GetShaderCount() const;
+
+		/// <summary>
+		/// Generates HLSL for the shader at the given index and fingerprints it together with the
+		/// compiler settings. Different shaders of the same variant can be generated concurrently 
+		/// once it's parsed.
+		/// </summary>
+		void GenerateShader(uint index, const IShaderCompiler& compiler, string_view featureLevel, bool isDebugging);
+
+		/// <summary>
+		/// Returns the fingerprint of the generated source and compiler settings of the given shader. 
+		/// Shaders with equal fingerprints compile to the same shader definition.
+		/// </summary>
+		const Hash128& GetShaderKey(uint index) const;
+
+		/// <summary>
+		/// Precompiles the generated source of the shader at the given index. Bytecode is reused from 
+		/// the cache when one is given.
+		/// </summary>
+		void CompileShader(uint index, const IShaderCompiler& compiler, string_view featureLevel, bool isDebugging, 
+			ShaderCache* pCache = nullptr);
+
+		/// <summary>
+		/// Sets the registry ID of a shader identical to one already committed. Shaders with 
+		/// an ID set before Commit() are neither compiled nor registered again.
+		/// </summary>
+		void SetShaderID(uint index, uint shaderID);
+
+		/// <summary>
+		/// Returns the registry ID of the given shader after Commit(), -1 before
+		/// </summary>
+		uint GetShaderID(uint index) const;
+
+		/// <summary>
+		/// Adds the shaders and effects of the built variant to the registry and writes their
+		/// IDs to the given variant definition. Uses the same compiler the variant was built with.
+		/// </summary>
+		void Commit(const IShaderCompiler& compiler, ShaderRegistryBuilder& registry, VariantDef& variant, uint vID);
+
+		/// <summary>
+		/// Resets variant buffers for the next variant
+		/// </summary>
+		void ClearVariant();
+
+		/// <summary>
+		/// Resets the builder to its initial state
+		/// </summary>
+		void Clear();
+
+	private:
+		struct PassBlock
+		{
+			uint nameID;
+			uint shaderStart;
+			uint shaderCount;
+		};
+
+		struct EffectBlock
+		{
+			uint nameID;
+			uint passStart;
+			uint passCount;
+		};
+
+		string_view libPath;
+		uint configID;
+		// Optional stage profiler shared by variant builders
+		BuildProfiler* pProfiler;
+
+		// Parsing and code gen
+		unique_ptr<VariantPreprocessor> pVariantGen;
+		unique_ptr<BlockAnalyzer> pAnalyzer;
+		unique_ptr<SymbolTable> pTable;
+
+		// Variant buffers
+		string libText;
+
+		// Variant-local string IDs, in the order the registry would have seen them
+		StringIDBuilder stringIDs;
+		// Number of strings added before effects were identified
+		uint epStringCount;
+		// Local string ID -> registry string ID
+		UniqueVector<uint> stringIDMap;
+
+		// Shader mains
+		UniqueVector<ShaderEntrypoint> entrypoints;
+		// Per-shader buffers in entrypoint order. Resized when parsing, so buffers are reused 
+		// between variants.
+		UniqueVector<string> shaderSrcs;
+		UniqueVector<Hash128> shaderKeys;
+		UniqueVector<Vector<byte>> shaderBins;
+		// Registry ID of each shader, -1 until committed or reused
+		UniqueVector<uint> shaderIDs;
+		// nameID -> shaderID
+		std::unordered_map<uint, uint> epNameShaderIDMap;
+
+		// Effect buffers
+		UniqueVector<EffectBlock> effectBlocks;
+		UniqueVector<PassBlock> effectPasses;
+		UniqueVector<uint> effectShaders;
+
+		/// <summary>
+		/// Identifies shaders in the source and buffers their entrypoint symbols
+		/// </summary>
+		void GetEntryPoints();
+
+		/// <summary>
+		/// Identifies effects and passes defined
+		/// </summary>
+		void GetEffects();
+
+		/// <summary>
+		/// Adds an effect pass to the buffer to be later converted into a definition
+		/// </summary>
+		void AddPass(const ScopeHandle& effectScope, string_view name);
+
+		/// <summary>
+		/// Registers precompiled shaders without an ID and writes their definitions to the variant
+		/// </summary>
+		void GetShaderDefs(const IShaderCompiler& compiler, ShaderRegistryBuilder& registry, 
+			DynamicArray<ShaderVariantDef>& variants, uint vID);
+
+		/// <summary>
+		/// Generates effect definitions for every effect in a variant
+		/// </summary>
+		void GetEffectDefs(ShaderRegistryBuilder& registry, DynamicArray<EffectVariantDef>& effects, uint vID);
+
+		/// <summary>
+		/// Adds variant-local strings on [start, end) to the registry and maps their IDs
+		/// </summary>
+		void MapStringIDs(ShaderRegistryBuilder& registry, uint start, uint end);
+	};
+}
@@ -13,6 +13,9 @@ namespace Weave::Effects
 	constexpr string_view g_VariantModesKeyword = "modes";
 	constexpr uint g_VariantModeLimit = 256u;
 
+	class PreprocessorCache;
+	struct VariantMacroDeps;
+
 	/// <summary>
 	/// Evaluates preprocessor directives for shaders and generates variants
 	/// </summary>
@@ -33,6 +36,13 @@ namespace Weave::Effects
 		/// </summary>
 		bool GetIsInitialized() const;
 
+		/// <summary>
+		/// Copies include paths, external macros and variant flags/modes from another preprocessor
+		/// initialized to the same source. Allows variants to be generated in any order without 
+		/// first generating variant 0.
+		/// </summary>
+		void SetVariantConfig(const VariantPreprocessor& other);
+
 		/// <summary>
 		/// Adds a preprocessor macro/define to the preprocessor symbol table
 		/// </summary>
@@ -50,9 +60,17 @@ namespace Weave::Effects
 		
 		/// <summary>
 		/// Generates variant with flags corresponding to the given index and returns 
-		/// reference to temporary buffer
+		/// reference to temporary buffer. If a cache is given, includes are loaded through it
+		/// and output is reused from earlier variants that only differ in unused flags or modes.
+		/// </summary>
+		void GetVariant(const uint configID, string& dst, Vector<ShaderEntrypoint>& entrypoints, 
+			PreprocessorCache* pCache = nullptr);
+
+		/// <summary>
+		/// Finds a variant stored in the cache that produces the same output as the given variant.
+		/// Returns false if none exists or if the given variant is the stored pass itself.
 		/// </summary>
-		void GetVariant(const uint configID, string& dst, Vector<ShaderEntrypoint>& entrypoints);
+		bool TryGetEquivalentVariant(const uint configID, const PreprocessorCache& cache, uint& equivID) const;
 
 		/// <summary>
 		/// Returns the total number of compile flag combos
@@ -85,6 +103,21 @@ namespace Weave::Effects
 		/// </summary>
 		void AddEntrypoint(string_view shaderName, ShadeStages stage);
 
+		/// <summary>
+		/// Records an identifier tested or expanded by the current variant
+		/// </summary>
+		void AddMacroQuery(string_view name);
+
+		/// <summary>
+		/// Loads the contents of the given include file. Returns false if it can't be opened.
+		/// </summary>
+		bool TryGetFile(const string& path, string& dst);
+
+		/// <summary>
+		/// Returns the paths of all files included by variants generated since the source was set
+		/// </summary>
+		const std::unordered_set<string>& GetIncludedFiles() const;
+
 		/// <summary>
 		/// Returns the current list of variant flags
 		/// </summary>
@@ -118,7 +151,18 @@ namespace Weave::Effects
 		UniqueVector<StringSpan> variantFlags;
 
 		Vector<ShaderEntrypoint>* pEntrypoints;
+		PreprocessorCache* pCache;
 
 		std::unordered_set<StringSpan> variantDefineSet;
+		// Identifiers that can affect the output of the current variant
+		std::unordered_set<string> macroQueries;
+		// Include paths opened since the source was set
+		std::unordered_set<string> includedFiles;
+
+		/// <summary>
+		/// Determines which variant flags and modes were tested or expanded while generating
+		/// the given variant source
+		/// </summary>
+		void GetMacroDeps(string_view varSrc, VariantMacroDeps& deps) const;
 	};
 }
\ No newline at end of file
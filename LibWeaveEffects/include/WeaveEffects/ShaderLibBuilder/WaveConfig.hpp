@@ -76,8 +76,108 @@ namespace Weave::Effects
 			WaveTokenSeqT const& values,
 			WaveLexToken const& pragma_token);
 
+		/// <summary>
+		/// Records macros tested by #if, #elif, #ifdef and #ifndef
+		/// </summary>
+		template <typename WaveContextT, typename WaveTokenSeqT>
+		bool evaluated_conditional_expression(
+			WaveContextT const& ctx,
+			WaveLexToken const& directive,
+			WaveTokenSeqT const& expression,
+			bool expression_value)
+		{
+			AddMacroQueries(expression);
+			return false;
+		}
+
+		/// <summary>
+		/// Records expanded object-like macros and the identifiers in their definitions
+		/// </summary>
+		template <typename WaveContextT, typename WaveTokenSeqT>
+		bool expanding_object_like_macro(
+			WaveContextT const& ctx,
+			WaveLexToken const& macro,
+			WaveTokenSeqT const& definition,
+			WaveLexToken const& macrocall)
+		{
+			AddMacroQuery(macro);
+			AddMacroQueries(definition);
+			return false;
+		}
+
+		/// <summary>
+		/// Records expanded function-like macros and the identifiers in their definitions and arguments
+		/// </summary>
+		template <typename WaveContextT, typename WaveTokenSeqT, typename WaveIteratorT>
+		bool expanding_function_like_macro(
+			WaveContextT const& ctx,
+			WaveLexToken const& macrodef,
+			std::vector<WaveLexToken> const& formal_args,
+			WaveTokenSeqT const& definition,
+			WaveLexToken const& macrocall,
+			std::vector<WaveTokenSeqT> const& arguments,
+			WaveIteratorT const& seqstart,
+			WaveIteratorT const& seqend)
+		{
+			AddMacroQuery(macrodef);
+			AddMacroQueries(definition);
+
+			for (const WaveTokenSeqT& arg : arguments)
+				AddMacroQueries(arg);
+
+			return false;
+		}
+
+		/// <summary>
+		/// Records macros defined in source
+		/// </summary>
+		template <typename WaveContextT, typename WaveParamsT, typename WaveTokenSeqT>
+		void defined_macro(
+			WaveContextT const& ctx,
+			WaveLexToken const& macro_name,
+			bool is_functionlike,
+			WaveParamsT const& parameters,
+			WaveTokenSeqT const& definition,
+			bool is_predefined)
+		{
+			if (!is_predefined)
+				AddMacroQuery(macro_name);
+		}
+
+		/// <summary>
+		/// Records macros undefined in source
+		/// </summary>
+		template <typename WaveContextT>
+		void undefined_macro(WaveContextT const& ctx, WaveLexToken const& macro_name)
+		{
+			AddMacroQuery(macro_name);
+		}
+
+		/// <summary>
+		/// Loads the contents of an include file into the given buffer. Returns false on failure.
+		/// </summary>
+		bool TryGetFile(const std::string& path, std::string& dst);
+
 	private:
 		VariantPreprocessor* pMain;
+
+		/// <summary>
+		/// Notifies the preprocessor of an identifier that can affect its output
+		/// </summary>
+		void AddMacroQuery(WaveLexToken const& token);
+
+		/// <summary>
+		/// Notifies the preprocessor of every identifier in the sequence
+		/// </summary>
+		template <typename WaveTokenSeqT>
+		void AddMacroQueries(WaveTokenSeqT const& tokens)
+		{
+			for (const WaveLexToken& token : tokens)
+			{
+				if (token == boost::wave::T_IDENTIFIER)
+					AddMacroQuery(token);
+			}
+		}
 	};
 
 	/// <summary>
@@ -91,9 +191,36 @@ namespace Weave::Effects
 	using WaveSrcIterator = WaveStringView::iterator;
 
 	/// <summary>
-	/// Defines how includes are loaded
+	/// Defines how includes are loaded. Files are read through the context policy, allowing
+	/// includes to be shared between variants.
 	/// </summary>
-	using WaveInputPolicy = boost::wave::iteration_context_policies::load_file_to_string;
+	struct WaveInputPolicy
+	{
+		template <typename WaveIterContextT>
+		class inner
+		{
+		public:
+			template <typename WavePositionT>
+			static void init_iterators(WaveIterContextT& iterCtx, WavePositionT const& actPos, WaveLangSupport language)
+			{
+				using WaveIteratorT = typename WaveIterContextT::iterator_type;
+
+				if (!iterCtx.ctx.get_hooks().TryGetFile(iterCtx.filename.c_str(), iterCtx.instring))
+				{
+					BOOST_WAVE_THROW_CTX(iterCtx.ctx, boost::wave::preprocess_exception,
+						bad_include_file, iterCtx.filename.c_str(), actPos);
+					return;
+				}
+
+				iterCtx.first = WaveIteratorT(iterCtx.instring.begin(), iterCtx.instring.end(),
+					WavePositionT(iterCtx.filename), language);
+				iterCtx.last = WaveIteratorT();
+			}
+
+		private:
+			std::string instring;
+		};
+	};
 
 	/// <summary>
 	/// Main preprocessor interface. Used for configuring macros, includes and retrieving lexing iterators
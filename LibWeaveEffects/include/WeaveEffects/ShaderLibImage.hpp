@@ -0,0 +1,379 @@
+#pragma once
+#include <span>
+#include "WeaveUtils/PerfectHash.hpp"
+#include "WeaveEffects/ShaderData.hpp"
+
+namespace Weave::Effects
+{
+	/// <summary>
+	/// Identifies flat library images. Reads "WFXL" in little endian.
+	/// </summary>
+	constexpr uint g_LibImageMagic = 0x4C584657u;
+
+	/// <summary>
+	/// Incremented whenever the image layout changes
+	/// </summary>
+	constexpr uint g_LibImageVersion = 3u;
+
+	/// <summary>
+	/// Required alignment of the image and each of its sections
+	/// </summary>
+	constexpr uint g_LibImageAlignment = 8u;
+
+	/// <summary>
+	/// Arrays stored in a library image. Each section holds a single element type.
+	/// </summary>
+	enum class LibImageSections : uint
+	{
+		// char: platform strings, repo names and paths
+		Text,
+		// uint: alternating start and length of each string in StringData
+		StringSpans,
+		// char: concatenated unique strings
+		StringData,
+		// ConstDef
+		Constants,
+		// ConstBufDef
+		CBufDefs,
+		// IOElementDef
+		IOElements,
+		// ResourceDef
+		Resources,
+		// ShaderDef
+		Shaders,
+		// EffectDef
+		Effects,
+		// uint: alternating start and length of each group in IDGroupData
+		IDGroupSpans,
+		// uint
+		IDGroupData,
+		// uint: alternating start and length of each shader binary in BinData
+		BinSpans,
+		// byte
+		BinData,
+		// uint: uncompressed size of each shader binary. Binaries whose stored length differs
+		// are LZ4 compressed.
+		BinRawSizes,
+		// LibImageRepo
+		Repos,
+		// LibImageVariant
+		Variants,
+		// uint: flag and mode name IDs for each repo
+		RepoIDs,
+		// ShaderVariantDef
+		ShaderVariants,
+		// EffectVariantDef
+		EffectVariants,
+		// LibImageHashTable
+		HashTables,
+		// uint: perfect hash displacements for each table
+		HashDisplacements,
+		// PerfectHashSlot
+		HashSlots,
+		Count
+	};
+
+	/// <summary>
+	/// Range of elements in a library image. Sections start at a byte offset from the start of
+	/// the image. Ranges referenced from within a section start at an element index.
+	/// </summary>
+	struct LibImageSpan
+	{
+		uint start;
+		uint length;
+	};
+
+	/// <summary>
+	/// Fixed size header at the start of every library image
+	/// </summary>
+	struct LibImageHeader
+	{
+		uint magic;
+		uint version;
+
+		/// <summary>
+		/// Total size of the image in bytes, including the header
+		/// </summary>
+		uint byteSize;
+
+		/// <summary>
+		/// PlatformTargets value
+		/// </summary>
+		uint target;
+
+		/// <summary>
+		/// Text ranges of the PlatformDef strings
+		/// </summary>
+		LibImageSpan compilerVersion;
+		LibImageSpan featureLevel;
+
+		/// <summary>
+		/// HashTables index of the string -> string ID table
+		/// </summary>
+		uint stringTable;
+
+		/// <summary>
+		/// HashTables indices of the shader and effect name ID -> default variant ID tables
+		/// </summary>
+		uint shaderTable;
+		uint effectTable;
+
+		LibImageSpan sections[(uint)LibImageSections::Count];
+	};
+
+	/// <summary>
+	/// Flat VariantRepoDef
+	/// </summary>
+	struct LibImageRepo
+	{
+		/// <summary>
+		/// Text ranges of the repo source name and path
+		/// </summary>
+		LibImageSpan name;
+		LibImageSpan path;
+
+		/// <summary>
+		/// RepoIDs ranges of flag and mode name IDs
+		/// </summary>
+		LibImageSpan flagIDs;
+		LibImageSpan modeIDs;
+
+		/// <summary>
+		/// Variants range, indexed by configID
+		/// </summary>
+		LibImageSpan variants;
+
+		/// <summary>
+		/// HashTables indices of the flag name ID -> flag bit and mode name ID -> modeID tables
+		/// </summary>
+		uint flagTable;
+		uint modeTable;
+	};
+
+	/// <summary>
+	/// Flat VariantDef
+	/// </summary>
+	struct LibImageVariant
+	{
+		LibImageSpan effects;
+		LibImageSpan shaders;
+
+		/// <summary>
+		/// HashTables indices of the name ID -> effectID and name ID -> shaderID tables
+		/// </summary>
+		uint effectTable;
+		uint shaderTable;
+	};
+
+	/// <summary>
+	/// Perfect hash table generated when the image is written. Tables with identical contents
+	/// share the same entry.
+	/// </summary>
+	struct LibImageHashTable
+	{
+		uint seed;
+
+		/// <summary>
+		/// HashDisplacements range
+		/// </summary>
+		LibImageSpan displacements;
+
+		/// <summary>
+		/// HashSlots range
+		/// </summary>
+		LibImageSpan slots;
+	};
+
+	/// <summary>
+	/// Read-only view over a library serialized in the flat image layout. Arrays are accessed
+	/// in place, so the image can be used directly from a memory mapped file or a generated
+	/// header array without deserialization. Non-owning. The viewed data must outlive it.
+	/// </summary>
+	class ShaderLibImage
+	{
+	public:
+		MAKE_DEF_MOVE_COPY(ShaderLibImage)
+
+		ShaderLibImage();
+
+		/// <summary>
+		/// Initializes a view over the given image. Throws if the data is not a valid image
+		/// of the current version.
+		/// </summary>
+		explicit ShaderLibImage(string_view data);
+
+		/// <summary>
+		/// Initializes a view over an image stored in a uint64_t / Weave::ulong header array
+		/// </summary>
+		template <std::size_t N>
+		explicit ShaderLibImage(const ulong(&arr)[N]) :
+			ShaderLibImage(string_view(reinterpret_cast<const char*>(&arr[0]), 8 * N))
+		{ }
+
+		/// <summary>
+		/// Returns true if the given data starts with a library image header
+		/// </summary>
+		static bool GetIsImage(string_view data);
+
+		/// <summary>
+		/// Returns the viewed image
+		/// </summary>
+		string_view GetData() const;
+
+		/// <summary>
+		/// Returns a copy of the platform the library was compiled for
+		/// </summary>
+		PlatformDef GetPlatform() const;
+
+		/// <summary>
+		/// Returns the number of variant repos in the library
+		/// </summary>
+		uint GetRepoCount() const;
+
+		/// <summary>
+		/// Returns the name of the given repo
+		/// </summary>
+		string_view GetRepoName(uint repoIndex) const;
+
+		/// <summary>
+		/// Returns the path of the file the given repo was compiled from
+		/// </summary>
+		string_view GetRepoPath(uint repoIndex) const;
+
+		/// <summary>
+		/// Returns the flag name IDs of the given repo in bit order
+		/// </summary>
+		std::span<const uint> GetFlagIDs(uint repoIndex) const;
+
+		/// <summary>
+		/// Returns the mode name IDs of the given repo
+		/// </summary>
+		std::span<const uint> GetModeIDs(uint repoIndex) const;
+
+		/// <summary>
+		/// Returns the number of flag/mode configurations in the given repo
+		/// </summary>
+		uint GetVariantCount(uint repoIndex) const;
+
+		/// <summary>
+		/// Returns the shaders in the given repo variant
+		/// </summary>
+		std::span<const ShaderVariantDef> GetShaderVariants(uint repoIndex, uint configID) const;
+
+		/// <summary>
+		/// Returns the effects in the given repo variant
+		/// </summary>
+		std::span<const EffectVariantDef> GetEffectVariants(uint repoIndex, uint configID) const;
+
+		/// <summary>
+		/// Returns the number of unique shader binaries in the library
+		/// </summary>
+		uint GetBinCount() const;
+
+		/// <summary>
+		/// Returns the stored, possibly compressed, bytes of the given shader binary
+		/// </summary>
+		std::span<const byte> GetBin(uint binIndex) const;
+
+		/// <summary>
+		/// Returns the uncompressed size of the given shader binary
+		/// </summary>
+		uint GetBinRawSize(uint binIndex) const;
+
+		/// <summary>
+		/// Returns true if the given shader binary is stored compressed
+		/// </summary>
+		bool GetIsBinCompressed(uint binIndex) const;
+
+		/// <summary>
+		/// Writes the uncompressed contents of the given shader binary to dst, replacing its
+		/// contents
+		/// </summary>
+		void GetDecompressedBin(uint binIndex, Vector<byte>& dst) const;
+
+		/// <summary>
+		/// Returns the table mapping strings to string IDs, keyed by the low 32 bits of each
+		/// string's key hash
+		/// </summary>
+		PerfectHashTable GetStringTable() const;
+
+		/// <summary>
+		/// Returns the table mapping shader name IDs to default variant IDs
+		/// </summary>
+		PerfectHashTable GetDefaultShaderTable() const;
+
+		/// <summary>
+		/// Returns the table mapping effect name IDs to default variant IDs
+		/// </summary>
+		PerfectHashTable GetDefaultEffectTable() const;
+
+		/// <summary>
+		/// Returns the table mapping flag name IDs to flag bits in the given repo
+		/// </summary>
+		PerfectHashTable GetFlagTable(uint repoIndex) const;
+
+		/// <summary>
+		/// Returns the table mapping mode name IDs to modeIDs in the given repo
+		/// </summary>
+		PerfectHashTable GetModeTable(uint repoIndex) const;
+
+		/// <summary>
+		/// Returns the table mapping shader name IDs to shaderIDs in the given repo variant
+		/// </summary>
+		PerfectHashTable GetShaderTable(uint repoIndex, uint configID) const;
+
+		/// <summary>
+		/// Returns the table mapping effect name IDs to effectIDs in the given repo variant
+		/// </summary>
+		PerfectHashTable GetEffectTable(uint repoIndex, uint configID) const;
+
+		/// <summary>
+		/// Returns the array stored in the given section
+		/// </summary>
+		template <typename T>
+		std::span<const T> GetSection(LibImageSections section) const
+		{
+			const LibImageSpan& span = pHeader->sections[(uint)section];
+			return std::span<const T>(reinterpret_cast<const T*>(data.data() + span.start), span.length);
+		}
+
+	private:
+		const LibImageHeader* pHeader;
+		string_view data;
+
+		string_view GetText(const LibImageSpan& span) const;
+
+		const LibImageRepo& GetRepo(uint repoIndex) const;
+
+		const LibImageVariant& GetVariant(uint repoIndex, uint configID) const;
+
+		PerfectHashTable GetHashTable(uint tableIndex) const;
+
+		/// <summary>
+		/// Throws if the section is misaligned or out of bounds
+		/// </summary>
+		template <typename T>
+		void ValidateSection(LibImageSections section) const;
+
+		/// <summary>
+		/// Throws if the range does not fit in a section or array of the given length
+		/// </summary>
+		static void ValidateRange(const LibImageSpan& span, size_t length);
+
+		/// <summary>
+		/// Throws if any start/length pair in the given span section lies outside of its data
+		/// </summary>
+		void ValidateSpans(LibImageSections spanSection, size_t dataLength) const;
+
+		/// <summary>
+		/// Throws if the given table or its arrays are out of bounds
+		/// </summary>
+		void ValidateHashTable(uint tableIndex) const;
+	};
+
+	/// <summary>
+	/// Writes the given library into the flat image layout, replacing the contents of the buffer.
+	/// Optionally LZ4 compresses shader binaries that shrink when compressed.
+	/// </summary>
+	void WriteShaderLibImage(const ShaderLibDef::Handle& def, Vector<byte>& dst, bool isCompressingBins = false);
+}
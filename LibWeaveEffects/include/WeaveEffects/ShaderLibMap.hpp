@@ -1,7 +1,9 @@
 #pragma once
 #include <unordered_map>
 #include <concepts>
+#include "WeaveUtils/MappedFile.hpp"
 #include "WeaveEffects/ShaderDataHandles.hpp"
+#include "WeaveEffects/ShaderLibImage.hpp"
 
 namespace Weave::Effects
 {
@@ -19,6 +21,18 @@ namespace Weave::Effects
 
 		ShaderLibMap(ShaderLibDef&& def);
 
+		/// <summary>
+		/// Initializes the map over a library image without copying it. The image must outlive
+		/// the map.
+		/// </summary>
+		explicit ShaderLibMap(const ShaderLibImage& image);
+
+		/// <summary>
+		/// Initializes the map over a memory mapped library image and takes ownership of the
+		/// mapping
+		/// </summary>
+		explicit ShaderLibMap(MappedFile&& file);
+
 		~ShaderLibMap();
 
 		/// <summary>
@@ -213,21 +227,6 @@ namespace Weave::Effects
 		uint GetEffectCount(uint vID) const;
 
 	private:
-		using NameIndexMap = std::unordered_map<uint, uint>;
-
-		struct VariantNameMap
-		{
-			/// <summary>
-			/// Maps (ShaderName) => ShaderDef
-			/// </summary>
-			NameIndexMap shaders;
-
-			/// <summary>
-			/// Maps (EffectName) => EffectDef
-			/// </summary>
-			NameIndexMap effects;
-		};
-
 		/// <summary>
 		/// Describes the platform targeted during compilation
 		/// </summary>
@@ -239,31 +238,30 @@ namespace Weave::Effects
 		std::unique_ptr<ShaderRegistryMap> pRegMap;
 
 		/// <summary>
-		/// NameID -> default vID map shared with all repos
+		/// Library image owned by the map, if it was converted from a definition
 		/// </summary>
-		VariantNameMap sharedVariantMap;
+		Vector<byte> imageBuf;
 
 		/// <summary>
-		/// Stores shader and effect variant lookup tables
+		/// Memory mapped library image owned by the map, if any
 		/// </summary>
-		UniqueArray<UniqueArray<VariantNameMap>> variantShaderMaps;
+		MappedFile mappedFile;
 
 		/// <summary>
-		/// Flag names used for static shader variant generation
+		/// View of the library data. Variant repos, the registry and the name lookup tables
+		/// are accessed in place.
 		/// </summary>
-		UniqueArray<NameIndexMap> variantFlagMaps;
+		ShaderLibImage image;
 
 		/// <summary>
-		/// Mutually exclusive shader modes/features used for static shader variant generation
+		/// Initializes the map to the given image data
 		/// </summary>
-		UniqueArray<NameIndexMap> variantModeMaps;
+		void Init(string_view imageData);
 
 		/// <summary>
-		/// Serializable variant repo data
+		/// Returns true if the variant ID refers to a variant in the library
 		/// </summary>
-		UniqueArray<VariantRepoDef> variantRepos;
-
-		void InitMaps();
+		bool GetIsValid(uint repoIndex, uint configIndex) const;
 
 		/// <summary>
 		/// Calculates the combined bit flag configuration used from a given variant ID
@@ -1,6 +1,7 @@
 <# Weave Effects Shader Type Map Generator
 
-Generates a C++ table for mapping shader types, names and metadata
+Generates a C++ table of shader types, names and metadata, indexed by name and by flags
+with perfect hash tables built at compile time
 
 Example Pre-build Event:
 cd $(ProjectDir)
@@ -65,16 +66,15 @@ Param(
 [string]$header = 
 @"
 #include "pch.hpp"
+#include "WeaveUtils/PerfectHash.hpp"
 #include "WeaveEffects/ShaderLibBuilder/ShaderParser/ShaderTypeInfo.hpp"
 
 namespace Weave::Effects
 {
-	using MapEntry = std::unordered_map<ShaderTypes, ShaderTypeInfo>::value_type;
-
 	template<typename T>
-	static MapEntry GetTypeEntry(string_view name, ShaderTypes flags) 
+	static constexpr ShaderTypeInfo GetTypeEntry(string_view name, ShaderTypes flags) 
 	{ 
-		return { flags, { name, flags, sizeof(T) } }; 
+		return { name, flags, sizeof(T) }; 
 	}
 
 "@;
@@ -82,13 +82,17 @@ namespace Weave::Effects
 [string]$footer = 
 @"
 
+// Types by name and by flags. Types sharing flags resolve to the first declared.
+static constexpr ConstPerfectHash s_ShaderTypeNameTable(s_ShaderTypes, [](const ShaderTypeInfo& type) { return GetConstKeyHash(type.name); });
+static constexpr ConstPerfectHash s_ShaderTypeFlagTable(s_ShaderTypes, [](const ShaderTypeInfo& type) { return (ulong)type.flags; });
+
 const ShaderTypeInfo* TryGetShaderTypeInfo(ShaderTypes flags)
 {
-	const auto& pair = s_ShaderTypeMap.find(flags);
+	const int index = s_ShaderTypeFlagTable.TryGetIndex((ulong)flags);
 
-	if (pair != s_ShaderTypeMap.end())
+	if (index != -1 && s_ShaderTypes[index].flags == flags)
 	{
-		return &pair->second;
+		return &s_ShaderTypes[index];
 	}
 	else
 		return nullptr;
@@ -96,11 +100,11 @@ const ShaderTypeInfo* TryGetShaderTypeInfo(ShaderTypes flags)
 
 bool TryGetShaderType(string_view name, ShaderTypes& type)
 {
-	const auto& pair = s_ShaderTypeNameMap.find(name);
+	const int index = s_ShaderTypeNameTable.TryGetIndex(GetConstKeyHash(name));
 
-	if (pair != s_ShaderTypeNameMap.end())
+	if (index != -1 && s_ShaderTypes[index].name == name)
 	{
-		type |= pair->second;
+		type |= s_ShaderTypes[index].flags;
 		return true;
 	}
 	else
@@ -119,21 +123,14 @@ const ShaderTypeInfo* TryGetShaderTypeInfo(string_view name)
 }
 "@;
 
-# Shader type to type data map
-[string]$typeInfoMapDecl =
-@"
-static const std::unordered_map<ShaderTypes, ShaderTypeInfo> s_ShaderTypeMap =
-{
-"@;
-
-# HLSL type name to shader type map
-[string]$nameTypeMapDecl = 
+# Shader type data table
+[string]$typeInfoTableDecl =
 @"
-static const std::unordered_map<string_view, ShaderTypes> s_ShaderTypeNameMap
+static constexpr ShaderTypeInfo s_ShaderTypes[] =
 {
 "@;
 
-# Generates shader intrinsic enum to type data entries for a given base type (int/bool/float)
+# Generates shader type data entries for a given base type (int/bool/float)
 function AppendTypeInfoSubtypes {
 	param (
 		[string]$enumTypeName,
@@ -165,7 +162,7 @@ function AppendTypeInfoSubtypes {
 	}
 }
 
-# Generates shader intrinsic enum to type data entries for a given low precision type
+# Generates shader type data entries for a given low precision type
 function AppendTypeInfoLowP {
 	param (
 		[string]$enumTypeName,
@@ -174,7 +171,7 @@ function AppendTypeInfoLowP {
 
 	# Scalar
 	[string]$flags = "(ShaderTypes::Scalar|ShaderTypes::$($enumTypeName))";
-	[void]$sb.AppendLine("{$($flags),{`"$($baseTypeName)`",$($flags),0u}},");
+	[void]$sb.AppendLine("{`"$($baseTypeName)`",$($flags),0u},");
 
 	for ([int]$i = 1; $i -lt 4; $i++)
 	{
@@ -182,7 +179,7 @@ function AppendTypeInfoLowP {
 		[int]$dimX = $i + 1;
 		$flags = "(ShaderTypes::Vector|ShaderTypes::$($enumTypeName)|ShaderTypes::Dim$($dimX))";
 		$typeName = "$($baseTypeName)$($dimX)";
-		[void]$sb.AppendLine("{$($flags),{`"$($typeName)`",$($flags),0u}},");
+		[void]$sb.AppendLine("{`"$($typeName)`",$($flags),0u},");
 
 		# Matrices
 		for ([int]$j = 1; $j -lt 4; $j++)
@@ -190,38 +187,7 @@ function AppendTypeInfoLowP {
 			[int]$dimY = $j + 1;
 			$flags = "(ShaderTypes::Matrix|ShaderTypes::$($enumTypeName)|ShaderTypes::Dim$($dimX)|ShaderTypes::DimAx$($dimY))";
 			$typeName = "$($baseTypeName)$($dimX)x$($dimY)";
-			[void]$sb.AppendLine("{$($flags),{`"$($typeName)`",$($flags),0u}},");
-		}
-	}
-}
-
-# Generates shader type name to enum entries for the given base type (int/half/float)
-function AppendSubtypeNames {
-	param (
-		[string]$hlslBaseName,
-		[string]$baseEnumName
-	)
-
-	# Scalar
-	[string]$typeName = $hlslBaseName;
-	[string]$flags = "(ShaderTypes::Scalar|ShaderTypes::$($baseEnumName))";
-	[void]$sb.AppendLine("{`"$($typeName)`",$($flags)},");
-
-	for ([int]$i = 1; $i -lt 4; $i++)
-	{
-		# Vector
-		[int]$dimX = $i + 1;
-		$typeName = "$($hlslBaseName)$($dimX)";
-		$flags = "(ShaderTypes::Vector|ShaderTypes::$($baseEnumName)|ShaderTypes::Dim$($dimX))";
-		[void]$sb.AppendLine("{`"$($typeName)`",$($flags)},");
-
-		for ([int]$j = 1; $j -lt 4; $j++)
-		{
-			# Matrices
-			[int]$dimY = $j + 1;
-			$typeName = "$($hlslBaseName)$($dimX)x$($dimY)";
-			$flags = "(ShaderTypes::Matrix|ShaderTypes::$($baseEnumName)|ShaderTypes::Dim$($dimX)|ShaderTypes::DimAx$($dimY))";
-			[void]$sb.AppendLine("{`"$($typeName)`",$($flags)},");
+			[void]$sb.AppendLine("{`"$($typeName)`",$($flags),0u},");
 		}
 	}
 }
@@ -234,12 +200,12 @@ function Write-Tables
 	[void]$sb.EnsureCapacity(10000);
 	[void]$sb.AppendLine($header);
 
-	# Type info map
-	[void]$sb.AppendLine($typeInfoMapDecl);
+	# Type info table
+	[void]$sb.AppendLine($typeInfoTableDecl);
 
 	foreach($pair in $hlslResources)
 	{
-		[void]$sb.AppendLine("{ShaderTypes::$($pair[1]),{`"$($pair[0])`",ShaderTypes::$($pair[1]),0u}},");
+		[void]$sb.AppendLine("{`"$($pair[0])`",ShaderTypes::$($pair[1]),0u},");
 	}
 
 	foreach ($pair in $hlslScalars)
@@ -254,26 +220,6 @@ function Write-Tables
 
 	[void]$sb.AppendLine("};");
 
-	# Name to type map
-	[void]$sb.AppendLine($nameTypeMapDecl);
-
-	foreach($pair in $hlslResources)
-	{
-		[void]$sb.AppendLine("{`"$($pair[0])`",ShaderTypes::$($pair[1])},");
-	}
-
-	foreach ($pair in $hlslScalars)
-	{
-		AppendSubtypeNames -hlslBaseName $pair[0] -baseEnumName $pair[1]
-	}
-
-	foreach ($pair in $hlslLowP)
-	{
-		AppendSubtypeNames -hlslBaseName $pair[0] -baseEnumName $pair[1]
-	}
-
-	[void]$sb.AppendLine("};");
-
 	# Add footer and write to file
 	[void]$sb.AppendLine($footer);
 
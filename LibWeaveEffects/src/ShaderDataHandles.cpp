@@ -21,13 +21,13 @@ uint ConstBufDefHandle::GetSize() const { return pDef->size; }
 
 const ConstDef& ConstBufDefHandle::operator[](ptrdiff_t index) const 
 { 
-	IDSpan members = pMap->GetIDGroup(pDef->layoutID);
+	IDView members = pMap->GetIDGroup(pDef->layoutID);
 	return pMap->GetConstant(members[index]);
 }
 
 size_t ConstBufDefHandle::GetLength() const 
 { 
-	IDSpan members = pMap->GetIDGroup(pDef->layoutID);
+	IDView members = pMap->GetIDGroup(pDef->layoutID);
 	return members.GetLength();
 }
 
@@ -46,7 +46,7 @@ uint ShaderDefHandle::GetFilePathID() const { return pDef->fileStringID; }
 
 uint ShaderDefHandle::GetNameID() const { return pDef->nameID; }
 
-ByteSpan ShaderDefHandle::GetBinSrc() const { return pMap->GetByteCode(pDef->byteCodeID); }
+ByteView ShaderDefHandle::GetBinSrc() const { return pMap->GetByteCode(pDef->byteCodeID); }
 
 ShadeStages ShaderDefHandle::GetStage() const { return pDef->stage; }
 
@@ -99,18 +99,18 @@ uint EffectDefHandle::GetNameID() const { return def.nameID; }
 
 ShaderDefHandle EffectDefHandle::GetShader(int pass, int shader) const
 {
-	IDSpan shaders = pMap->GetIDGroup(passes[pass]);
+	IDView shaders = pMap->GetIDGroup(passes[pass]);
 	return ShaderDefHandle(*pMap, shaders[shader]);
 }
 
-IDSpan EffectDefHandle::GetPass(int pass) const
+IDView EffectDefHandle::GetPass(int pass) const
 { 
 	return pMap->GetIDGroup(passes[pass]);
 }
 
 uint EffectDefHandle::GetShaderCount(int pass) const 
 { 
-	IDSpan shaders = pMap->GetIDGroup(passes[pass]);
+	IDView shaders = pMap->GetIDGroup(passes[pass]);
 	return (uint)shaders.GetLength();
 }
 
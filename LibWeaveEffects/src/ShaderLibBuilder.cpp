@@ -1,30 +1,42 @@
 #pragma once
 #include "pch.hpp"
-#include "WeaveEffects/ShaderLibBuilder/ShaderParser/BlockAnalyzer.hpp"
-#include "WeaveEffects/ShaderLibBuilder/SymbolTable.hpp"
-#include "WeaveEffects/ShaderLibBuilder/ShaderGenerator.hpp"
+#include "WeaveUtils/WorkerPool.hpp"
 #include "WeaveEffects/ShaderLibBuilder/ShaderCompiler.hpp"
 #include "WeaveEffects/ShaderLibBuilder/VariantPreprocessor.hpp"
+#include "WeaveEffects/ShaderLibBuilder/VariantBuilder.hpp"
 #include "WeaveEffects/ShaderLibBuilder/ShaderRegistryBuilder.hpp"
+#include "WeaveEffects/ShaderLibBuilder/ShaderCache.hpp"
+#include "WeaveEffects/ShaderLibBuilder/PreprocessorCache.hpp"
+#include "WeaveEffects/ShaderLibBuilder/BuildProfiler.hpp"
+#include "WeaveEffects/ShaderLibBuilder/ShaderRegistryMap.hpp"
+#include "WeaveEffects/ShaderLibImage.hpp"
 #include "WeaveEffects/ShaderLibBuilder.hpp"
 
 using namespace Weave::Effects;
 
 ShaderLibBuilder::ShaderLibBuilder() :
-	pVariantGen(new VariantPreprocessor()),
-	pAnalyzer(new BlockAnalyzer()),
-	pTable(new SymbolTable()),
-	pShaderGen(new ShaderGenerator()),
 	pShaderRegistry(new ShaderRegistryBuilder()),
 	isDebugging(false),
-	libBufIndex(0)
+	variantSrcArena(1024 * 1024),
+	variantHits(0),
+	variantCollisions(0),
+	shaderSrcHits(0),
+	shaderSrcLookups(0)
 {
 	platform = PlatformDef
 	{
-		.compilerVersion = string(GetCompilerVersionD3D11()),
 		.featureLevel = string("5_0"),
 		.target = PlatformTargets::DirectX11
 	};
+
+#ifdef _WIN32
+	SetCompiler(unique_ptr<IShaderCompiler>(new ShaderCompilerD3D11()));
+#else
+	SetCompiler(unique_ptr<IShaderCompiler>(new ShaderCompilerReflect()));
+#endif
+
+	SetThreadCount(1);
+	SetIncrementalPreprocessing(true);
 }
 
 ShaderLibBuilder::~ShaderLibBuilder() = default;
@@ -35,363 +47,595 @@ void ShaderLibBuilder::AddRepo(string_view name, string_view libPath, string_vie
 	VariantRepoDef& lib = repos.EmplaceBack();
 	lib.src.name = name;
 	lib.src.path = libPath;
-	pVariantGen->SetSrc(libPath, libSrc);
 
-	for (uint configID = 0; configID < pVariantGen->GetVariantCount(); configID++)
+	ClearDuplicateIndex();
+
+	if (pShaderCache != nullptr)
+		pShaderCache->ResetStats();
+
+	if (pPreprocCache != nullptr)
+		pPreprocCache->ClearVariants();
+
+	if (pProfiler != nullptr)
+		pProfiler->BeginRepo(name);
+
+	// Flags and modes are declared in pragmas and are only known after the first variant
+	VariantBuilder& firstBuilder = *variantBuilders[0];
+	firstBuilder.SetSrc(libPath, libSrc);
+	firstBuilder.Preprocess(0, pPreprocCache.get());
+	InitVariants(lib, firstBuilder.GetPreprocessor());
+
+	const uint variantCount = (uint)lib.variants.GetLength();
+	const uint builderCount = std::min((uint)variantBuilders.GetLength(), variantCount);
+
+	for (uint i = 1; i < builderCount; i++)
 	{
-		const uint vID = repoID | configID;
-		VariantSrcBuf* pBuf = &libBufs[libBufIndex];
-		pBuf->libText.clear();
-		pBuf->vID = configID;
+		variantBuilders[i]->SetSrc(libPath, libSrc);
+		variantBuilders[i]->SetVariantConfig(firstBuilder);
+	}
+
+	/* Variants are processed in batches of one per builder. Variants equivalent to one already
+	* preprocessed are mapped onto it without being rebuilt. Preprocessing, parsing and compilation
+	* run in parallel, while deduplication and registration run in configID order, leaving
+	* the resulting library identical to a serial build. Shaders are compiled as separate tasks, 
+	* so batches with fewer variants than threads still keep every thread busy. */
+	uint nextID = 0;
 
-		// Generate variant
-		pVariantGen->GetVariant(configID, pBuf->libText, entrypoints);
-		bool isDuplicate = false;
+	while (nextID < variantCount)
+	{
+		batchConfigIDs.Clear();
 
-		for (int i = 0; i < std::size(libBufs); i++)
+		// Select the next variants that need to be built
+		for (; nextID < variantCount && batchConfigIDs.GetLength() < builderCount; nextID++)
 		{
-			if (libBufIndex != i && pBuf->libText == libBufs[i].libText)
+			uint equivID;
+
+			if (nextID > 0 && pPreprocCache != nullptr && 
+				firstBuilder.GetPreprocessor().TryGetEquivalentVariant(nextID, *pPreprocCache, equivID))
 			{
-				isDuplicate = true;
-				pBuf = &libBufs[i];
-				break;
+				variantEquivIDs.EmplaceBack(nextID, equivID);
 			}
+			else
+				batchConfigIDs.EmplaceBack(nextID);
 		}
 
-		if (configID == 0)
-			InitVariants(lib);
+		const uint batchCount = (uint)batchConfigIDs.GetLength();
 
-		if (!isDuplicate) // Parse and precompile variants
+		// Generate variants
+		pWorkerPool->ParallelFor(batchCount, [&](uint i)
 		{
-			const uint resCount = pShaderRegistry->GetUniqueResCount();
+			const uint configID = batchConfigIDs[i];
 
-			pAnalyzer->AnalyzeSource(libPath, pBuf->libText);
-			pTable->ParseBlocks(*pAnalyzer);
+			if (configID > 0)
+				variantBuilders[i]->Preprocess(configID, pPreprocCache.get());
+		});
 
-			// Shaders
-			GetEntryPoints();
-			lib.variants[configID].shaders = DynamicArray<ShaderVariantDef>(entrypoints.GetLength());
-			GetShaderDefs(libPath, lib.variants[configID].shaders, vID);
+		for (uint i = 0; i < batchCount; i++)
+		{
+			const VariantBuilder& builder = *variantBuilders[i];
+			BuildProfiler::Scope profile(pProfiler.get(), BuildStages::Dedupe, builder.GetConfigID());
+			batchDuplicates[i] = GetDuplicateVariant(builder.GetConfigID(), builder.GetVariantSrc());
+		}
 
-			// Effects
-			GetEffects();
-			lib.variants[configID].effects = DynamicArray<EffectVariantDef>(effectBlocks.GetLength());
-			GetEffectDefs(lib.variants[configID].effects, vID);
+		// Parse unique variants
+		pWorkerPool->ParallelFor(batchCount, [&](uint i)
+		{
+			if (batchDuplicates[i] == -1)
+				variantBuilders[i]->Parse();
+		});
 
-			if (resCount == pShaderRegistry->GetUniqueResCount())
-				WV_LOG_WARN() << "Unused flag/mode combination detected. ID: " << vID << ". Not skipped.";
+		// Generate every shader in the batch
+		batchShaders.Clear();
 
-			libBufIndex++;
-			libBufIndex %= std::size(libBufs);
+		for (uint i = 0; i < batchCount; i++)
+		{
+			if (batchDuplicates[i] == -1)
+			{
+				for (uint j = 0; j < variantBuilders[i]->GetShaderCount(); j++)
+					batchShaders.EmplaceBack(i, j);
+			}
 		}
-		else // Skip processing
+
+		pWorkerPool->ParallelFor((uint)batchShaders.GetLength(), [&](uint i)
 		{
-			// Copy variant mappings and update ID
-			lib.variants[configID] = lib.variants[pBuf->vID];
+			const auto [builderIndex, shaderIndex] = batchShaders[i];
+			variantBuilders[builderIndex]->GenerateShader(shaderIndex, *pCompiler, platform.featureLevel, isDebugging);
+		});
 
-			for (ShaderVariantDef& shader : lib.variants[configID].shaders)
-				shader.variantID = configID;
+		// Precompile shaders not generated by an earlier variant
+		GetUniqueShaders(batchCount);
 
-			for (EffectVariantDef& effect : lib.variants[configID].effects)
-				effect.variantID = configID;
+		pWorkerPool->ParallelFor((uint)batchCompiles.GetLength(), [&](uint i)
+		{
+			const auto [builderIndex, shaderIndex] = batchCompiles[i];
+			variantBuilders[builderIndex]->CompileShader(shaderIndex, *pCompiler, platform.featureLevel, 
+				isDebugging, pShaderCache.get());
+		});
 
-			WV_LOG_WARN() << "Unused flag/mode combination detected. ID: " << vID << ". Skipped.";
+		for (uint i = 0; i < batchCount; i++)
+		{
+			VariantBuilder& builder = *variantBuilders[i];
+			CommitVariant(lib, builder, repoID | builder.GetConfigID(), batchDuplicates[i]);
+			builder.ClearVariant();
 		}
+	}
 
-		ClearVariant();
+	// Equivalent variants always follow the variant they map to
+	for (const auto& [configID, equivID] : variantEquivIDs)
+		CopyVariant(lib, configID, equivID);
+
+	if (pPreprocCache != nullptr)
+	{
+		const uint equivCount = (uint)variantEquivIDs.GetLength();
+		WV_LOG_INFO() << "Equivalent variants skipped: " << equivCount << " of " << variantCount 
+			<< " (" << (100.0 * equivCount / variantCount) << "%)";
+		WV_LOG_INFO() << "Preprocessor passes reused: " << pPreprocCache->GetHitCount() << " of " << variantCount;
 	}
-}
 
-ShaderLibDef::Handle ShaderLibBuilder::GetDefinition() const
-{
-	return
+	WV_LOG_INFO() << "Duplicate variants skipped: " << variantHits << " of " << variantCount 
+		<< " (" << (100.0 * variantHits / variantCount) << "%)";
+
+	if (variantCollisions > 0)
+		WV_LOG_WARN() << "Variant source hash collisions: " << variantCollisions;
+
+	if (shaderSrcLookups > 0)
 	{
-		.pPlatform = &platform,
-		.pRepos = &repos,
-		.regHandle = pShaderRegistry->GetDefinition(),
-		.strMapHandle = pShaderRegistry->GetStringIDBuilder().GetDefinition()
-	};
+		WV_LOG_INFO() << "Duplicate shader compiles skipped: " << shaderSrcHits << " of " << shaderSrcLookups
+			<< " (" << (100.0 * shaderSrcHits / shaderSrcLookups) << "%)";
+	}
+
+	if (pShaderCache != nullptr)
+	{
+		const uint hits = pShaderCache->GetHitCount();
+		const uint lookups = hits + pShaderCache->GetMissCount();
+		WV_LOG_INFO() << "Shader cache hits: " << hits << " of " << lookups;
+	}
+
+	UpdateRepoIncludes(builderCount);
+	ClearDuplicateIndex();
 }
 
-void ShaderLibBuilder::SetTarget(PlatformTargets target) { platform.target = target; }
+void ShaderLibBuilder::AddRepo(const ShaderLibImage& image, uint repoIndex)
+{
+	FX_CHECK_MSG(repoIndex < image.GetRepoCount(), "Repo index out of range: {}", repoIndex);
 
-void ShaderLibBuilder::SetFeatureLevel(string_view featureLevel) { platform.featureLevel = featureLevel; }
+	const PlatformDef srcPlatform = image.GetPlatform();
+	FX_CHECK_MSG(srcPlatform.target == platform.target && srcPlatform.featureLevel == platform.featureLevel &&
+		srcPlatform.compilerVersion == platform.compilerVersion,
+		"Cannot copy repo {}. Library image platform does not match.", image.GetRepoName(repoIndex));
 
-void ShaderLibBuilder::SetDebug(bool isDebugging) { this->isDebugging = isDebugging; }
+	const ShaderRegistryMap srcRegistry(image);
+	const uint repoID = (uint)repos.GetLength() << g_VariantGroupOffset;
+	VariantRepoDef& lib = repos.EmplaceBack();
+	lib.src.name = image.GetRepoName(repoIndex);
+	lib.src.path = image.GetRepoPath(repoIndex);
 
-void ShaderLibBuilder::InitVariants(VariantRepoDef& lib)
-{
-	const IDynamicArray<StringSpan>& flags = pVariantGen->GetVariantFlags();
-	lib.flagIDs = DynamicArray<uint>(flags.GetLength());
+	repoIncludes.Clear();
+	importIDMap.clear();
+	importStringMap.clear();
 
-	for (int i = 0; i < flags.GetLength(); i++)
-		lib.flagIDs[i] = pShaderRegistry->GetOrAddStringID(flags[i]);
+	if (pProfiler != nullptr)
+		pProfiler->BeginRepo(lib.src.name);
 
-	const IDynamicArray<StringSpan>& modes = pVariantGen->GetVariantModes();
-	lib.modeIDs = DynamicArray<uint>(modes.GetLength());
+	const std::span<const uint> flagIDs = image.GetFlagIDs(repoIndex);
+	lib.flagIDs = DynamicArray<uint>(flagIDs.size());
 
-	for (int i = 0; i < modes.GetLength(); i++)
-		lib.modeIDs[i] = pShaderRegistry->GetOrAddStringID(modes[i]);
+	for (uint i = 0; i < (uint)flagIDs.size(); i++)
+		lib.flagIDs[i] = ImportString(srcRegistry, flagIDs[i]);
 
-	lib.variants = DynamicArray<VariantDef>(pVariantGen->GetVariantCount());
+	const std::span<const uint> modeIDs = image.GetModeIDs(repoIndex);
+	lib.modeIDs = DynamicArray<uint>(modeIDs.size());
 
-	WV_LOG_INFO() << "Variants declared: " << lib.variants.GetLength();
-	FX_CHECK_MSG(lib.variants.GetLength() != 0, "No shaders found.");
-}
+	for (uint i = 0; i < (uint)modeIDs.size(); i++)
+		lib.modeIDs[i] = ImportString(srcRegistry, modeIDs[i]);
 
-void ShaderLibBuilder::GetEntryPoints()
-{
-	// Attribute tags
-	for (int i = 0; i < pTable->GetSymbolCount(); i++)
+	lib.variants = DynamicArray<VariantDef>(image.GetVariantCount(repoIndex));
+
+	for (uint configID = 0; configID < lib.variants.GetLength(); configID++)
 	{
-		SymbolHandle symbol = pTable->GetSymbol(i);
+		BuildProfiler::Scope profile(pProfiler.get(), BuildStages::Commit, configID);
+		const int resCount = pShaderRegistry->GetResourceCount();
+		const int uniqueCount = pShaderRegistry->GetUniqueResCount();
+		VariantDef& variant = lib.variants[configID];
+
+		const std::span<const ShaderVariantDef> shaders = image.GetShaderVariants(repoIndex, configID);
+		variant.shaders = DynamicArray<ShaderVariantDef>(shaders.size());
 
-		if (symbol.GetHasFlags(SymbolTypes::FuncDefinition))
+		for (uint i = 0; i < (uint)shaders.size(); i++)
 		{
-			TokenNodeHandle funcIdent = symbol.GetIdent();
+			variant.shaders[i] = 
+			{
+				.shaderID = ImportResource(srcRegistry, shaders[i].shaderID),
+				.variantID = repoID | (shaders[i].variantID & g_VariantMask)
+			};
+		}
+
+		const std::span<const EffectVariantDef> effects = image.GetEffectVariants(repoIndex, configID);
+		variant.effects = DynamicArray<EffectVariantDef>(effects.size());
 
-			for (int j = 0; j < funcIdent.GetChildCount(); j++)
+		for (uint i = 0; i < (uint)effects.size(); i++)
+		{
+			variant.effects[i] = 
 			{
-				if (funcIdent[j].GetHasFlags(TokenTypes::AttribShaderDecl))
-				{
-					string_view name = funcIdent.GetValue();
-					const uint nameID = pShaderRegistry->GetOrAddStringID(name);
-
-					if (!epNameShaderIDMap.contains(nameID))
-					{
-						ShaderEntrypoint& ep = entrypoints.EmplaceBack();
-						epNameShaderIDMap.emplace(nameID, -1);
-						ep.name = name;
-						ep.stage = GetStageFromFlags(funcIdent[j].GetFlags());
-						ep.symbolID = i;
-					}
-
-					break;
-				}
-			}
+				.effectID = ImportResource(srcRegistry, effects[i].effectID),
+				.variantID = repoID | (effects[i].variantID & g_VariantMask)
+			};
 		}
+
+		const int misses = pShaderRegistry->GetUniqueResCount() - uniqueCount;
+		profile.SetCounter(0, pShaderRegistry->GetResourceCount() - resCount - misses);
+		profile.SetCounter(1, misses);
 	}
 
-	// Pragma shaders
-	for (int i = 0; i < entrypoints.GetLength(); i++)
+	WV_LOG_INFO() << "Copied " << lib.variants.GetLength() << " prebuilt variants from library image";
+
+	importIDMap.clear();
+	importStringMap.clear();
+}
+
+const IDynamicArray<string>& ShaderLibBuilder::GetRepoIncludes() const { return repoIncludes; }
+
+void ShaderLibBuilder::UpdateRepoIncludes(uint builderCount)
+{
+	std::unordered_set<string_view> includeSet;
+
+	for (uint i = 0; i < builderCount; i++)
 	{
-		ShaderEntrypoint& ep = entrypoints[i];
-		ScopeHandle global = pTable->GetScope(0);
-		const IDList* pFuncs = global.TryGetFuncOverloads(ep.name);
-		
-		if (pFuncs != nullptr && !pFuncs->empty())
-		{
-			const uint nameID = pShaderRegistry->GetOrAddStringID(ep.name);
+		for (const string& path : variantBuilders[i]->GetPreprocessor().GetIncludedFiles())
+			includeSet.emplace(path);
+	}
 
-			if (!epNameShaderIDMap.contains(nameID))
-			{
-				epNameShaderIDMap.emplace(nameID, -1);
-				ep.symbolID = pFuncs->front();
-			}
-		}
-		else
-			FXBLOCK_THROW(*pAnalyzer, global.GetBlockStart(), 
-				"Definition for shader '{}' declared in pragma not found", ep.name);
+	repoIncludes.Clear();
+	repoIncludes.Reserve(includeSet.size());
+
+	for (const string_view path : includeSet)
+		repoIncludes.EmplaceBack(path);
+
+	std::sort(repoIncludes.begin(), repoIncludes.end());
+}
+
+uint ShaderLibBuilder::ImportString(const ShaderRegistryMap& src, uint stringID)
+{
+	if (stringID == -1)
+		return -1;
+
+	const auto [it, isNew] = importStringMap.try_emplace(stringID, -1);
+
+	if (isNew)
+		it->second = pShaderRegistry->GetOrAddStringID(src.GetString(stringID));
+
+	return it->second;
+}
+
+uint ShaderLibBuilder::ImportResource(const ShaderRegistryMap& src, uint id)
+{
+	if (id == -1)
+		return -1;
+
+	const auto it = importIDMap.find(id);
+
+	if (it != importIDMap.end())
+		return it->second;
+
+	uint newID = -1;
+
+	switch (ShaderRegistryBuilder::GetResourceType(id))
+	{
+	case ResourceType::Constant:
+	{
+		ConstDef def = src.GetConstant(id);
+		def.stringID = ImportString(src, def.stringID);
+		newID = pShaderRegistry->GetOrAddConstant(def);
+		break;
+	}
+	case ResourceType::ConstantBuffer:
+	{
+		ConstBufDef def = src.GetConstBuf(id);
+		def.stringID = ImportString(src, def.stringID);
+		def.layoutID = ImportResource(src, def.layoutID);
+		newID = pShaderRegistry->GetOrAddConstantBuffer(def);
+		break;
+	}
+	case ResourceType::IOElement:
+	{
+		IOElementDef def = src.GetIOElement(id);
+		def.semanticID = ImportString(src, def.semanticID);
+		newID = pShaderRegistry->GetOrAddIOElement(def);
+		break;
+	}
+	case ResourceType::Resource:
+	{
+		ResourceDef def = src.GetResource(id);
+		def.stringID = ImportString(src, def.stringID);
+		newID = pShaderRegistry->GetOrAddResource(def);
+		break;
+	}
+	case ResourceType::Shader:
+	{
+		ShaderDef def = src.GetShader(id);
+		def.fileStringID = ImportString(src, def.fileStringID);
+		def.nameID = ImportString(src, def.nameID);
+		def.byteCodeID = ImportResource(src, def.byteCodeID);
+		def.inLayoutID = ImportResource(src, def.inLayoutID);
+		def.outLayoutID = ImportResource(src, def.outLayoutID);
+		def.resLayoutID = ImportResource(src, def.resLayoutID);
+		def.cbufGroupID = ImportResource(src, def.cbufGroupID);
+		newID = pShaderRegistry->GetOrAddShader(def);
+		break;
+	}
+	case ResourceType::Effect:
+	{
+		EffectDef def = src.GetEffect(id);
+		def.nameID = ImportString(src, def.nameID);
+		def.passGroupID = ImportResource(src, def.passGroupID);
+		newID = pShaderRegistry->GetOrAddEffect(def);
+		break;
 	}
-	
-	// Shader blocks
-	for (int i = 0; i < pTable->GetSymbolCount(); i++)
+	case ResourceType::ByteCode:
+		newID = pShaderRegistry->GetOrAddShaderBin(src.GetByteCode(id));
+		break;
+	case ResourceType::IDGroups:
 	{
-		SymbolHandle symbol = pTable->GetSymbol(i);
+		// Members are imported first, as nested groups would otherwise share the buffer
+		const IDView srcGroup = src.GetIDGroup(id);
+		Vector<uint> idBuf = pShaderRegistry->GetTmpIDBuffer();
+		idBuf.Reserve(srcGroup.GetLength());
 
-		if (symbol.GetHasFlags(SymbolTypes::ShaderDef))
-		{
-			ScopeHandle scope = *symbol.GetScope();
-			string_view name = symbol.GetName();
-			const IDList* pFuncs = scope.TryGetFuncOverloads(name);
+		for (uint i = 0; i < srcGroup.GetLength(); i++)
+			idBuf.EmplaceBack(ImportResource(src, srcGroup[i]));
 
-			if (pFuncs != nullptr && !pFuncs->empty())
-			{
-				const uint nameID = pShaderRegistry->GetOrAddStringID(name);
-
-				if (!epNameShaderIDMap.contains(nameID))
-				{
-					ShaderEntrypoint& ep = entrypoints.EmplaceBack();
-					epNameShaderIDMap.emplace(nameID, -1);
-					ep.name = name;
-					ep.stage = GetStageFromFlags(symbol.GetFlags());
-					ep.symbolID = pFuncs->front();
-				}
-			}
-			else
-				FXBLOCK_THROW(*pAnalyzer, symbol.GetIdent().GetBlockStart(),
-					"Could not find entrypoint for shader block '{}'", name);
-		}
+		newID = pShaderRegistry->GetOrAddIDGroup(idBuf);
+		pShaderRegistry->ReturnTmpIDBuffer(std::move(idBuf));
+		break;
+	}
+	default:
+		FX_THROW("Invalid resource ID in library image: {}", id);
 	}
+
+	importIDMap.emplace(id, newID);
+	return newID;
 }
 
-void ShaderLibBuilder::GetEffects()
+sint ShaderLibBuilder::GetDuplicateVariant(uint configID, string_view libText)
 {
-	for (int i = 0; i < pTable->GetSymbolCount(); i++)
+	const Hash128 srcHash = GetHash128(libText);
+	const auto it = variantSrcMap.find(srcHash);
+
+	if (it != variantSrcMap.end())
 	{
-		SymbolHandle symbol = pTable->GetSymbol(i);
+		const VariantSrcRef& ref = it->second;
 
-		if (symbol.GetIsScope() && symbol.GetHasFlags(SymbolTypes::TechniqueDef))
+		if (libText == ref.src)
 		{
-			ScopeHandle effectScope = *symbol.GetScope();
-			EffectBlock& effect = effectBlocks.EmplaceBack();
-			effect.nameID = pShaderRegistry->GetOrAddStringID(symbol.GetName());
-			effect.passStart = 0;
-			effect.passStart = (uint)effectPasses.GetLength();
-			effect.passCount = 0; 
-			bool isPassDefaulted = false;
-
-			for (int j = 0; j < effectScope.GetChildCount(); j++)
-			{
-				SymbolHandle effectChild = effectScope[j];
-
-				if (!isPassDefaulted && effectChild.GetHasFlags(SymbolTypes::TechniqueShaderDecl))
-					isPassDefaulted = true;
-
-				if (effectChild.GetHasFlags(SymbolTypes::TechniquePassDecl))
-				{
-					FXBLOCK_CHECK_MSG(!isPassDefaulted, *pAnalyzer, symbol.GetIdent().GetBlockStart(),
-						"Illegal use of defaulted and explicit passes in the same effect '{}'", symbol.GetName());
-						
-					effect.passCount++;
-				}
-			}
-
-			if (isPassDefaulted)
-			{
-				AddPass(effectScope, "DefaultedPass");
-				effect.passCount = 1;
-			}
-			else
-			{
-				for (int j = 0; j < effectScope.GetChildCount(); j++)
-				{
-					SymbolHandle effectChild = effectScope[j];
-
-					if (effectChild.GetHasFlags(SymbolTypes::TechniquePassDecl))
-					{
-						ScopeHandle passScope = *effectChild.GetScope();
-						AddPass(passScope, effectChild.GetName());
-					}
-				}
-			}
+			variantHits++;
+			return (sint)ref.configID;
 		}
+
+		// Colliding variants are built normally, but only the first is indexed
+		variantCollisions++;
+		return -1;
 	}
+
+	variantSrcMap.emplace(srcHash, VariantSrcRef { .configID = configID, .src = variantSrcArena.Add(libText) });
+	return -1;
 }
 
-void ShaderLibBuilder::AddPass(const ScopeHandle& passScope, string_view name)
+void ShaderLibBuilder::GetUniqueShaders(uint batchCount)
 {
-	PassBlock& pass = effectPasses.EmplaceBack();
-	pass.nameID = pShaderRegistry->GetOrAddStringID(name);
-	pass.shaderStart = (uint)effectShaders.GetLength();
+	batchCompiles.Clear();
+	uint shaderStart = 0;
 
-	for (int j = 0; j < passScope.GetChildCount(); j++)
+	for (uint i = 0; i < batchCount; i++)
 	{
-		SymbolHandle effectChild = passScope[j];
+		if (batchDuplicates[i] != -1)
+			continue;
 
-		if (effectChild.GetHasFlags(SymbolTypes::TechniqueShaderDecl))
-		{
-			string_view shaderName = effectChild.GetName();
-			const uint stringID = pShaderRegistry->GetOrAddStringID(shaderName);
-			const auto& it = epNameShaderIDMap.find(stringID);
+		const VariantBuilder& builder = *variantBuilders[i];
+		const uint shaderCount = builder.GetShaderCount();
+		BuildProfiler::Scope profile(pProfiler.get(), BuildStages::Dedupe, builder.GetConfigID());
+		uint hits = 0;
 
-			FXBLOCK_CHECK_MSG(it != epNameShaderIDMap.end(), *pAnalyzer, effectChild.GetIdent().GetBlockStart(),
-				"Unrecognised shader name '{}' declared in effect pass", shaderName);
+		// Shaders are indexed in commit order, so the first with a given fingerprint is always
+		// registered before any reusing its ID
+		for (uint j = 0; j < shaderCount; j++)
+		{
+			const auto [it, isNew] = shaderSrcMap.try_emplace(builder.GetShaderKey(j), (uint)-1);
 
-			const uint shaderID = it->second;
-			effectShaders.EmplaceBack(shaderID);
+			if (isNew)
+				batchCompiles.EmplaceBack(batchShaders[shaderStart + j]);
+			else
+				hits++;
 		}
-	}
 
-	pass.shaderCount = (uint)effectShaders.GetLength() - pass.shaderStart;
+		profile.SetCounter(0, hits);
+		profile.SetCounter(1, shaderCount);
+		shaderSrcHits += hits;
+		shaderSrcLookups += shaderCount;
+		shaderStart += shaderCount;
+	}
 }
 
-void ShaderLibBuilder::GetShaderDefs(string_view libPath, DynamicArray<ShaderVariantDef>& variants, uint vID)
+void ShaderLibBuilder::SetDuplicateShaderIDs(VariantBuilder& builder)
 {
-	for (int i = 0; i < entrypoints.GetLength(); i++)
+	for (uint i = 0; i < builder.GetShaderCount(); i++)
 	{
-		hlslBuf.clear();
+		const uint shaderID = shaderSrcMap[builder.GetShaderKey(i)];
 
-		const ShaderEntrypoint& ep = entrypoints[i];
-		pShaderGen->GetShaderSource(*pTable, pAnalyzer->GetBlocks(), ep, entrypoints, hlslBuf);
+		if (shaderID != -1)
+			builder.SetShaderID(i, shaderID);
+	}
+}
 
-		const uint shaderID = GetShaderDefD3D11(libPath, hlslBuf, platform.featureLevel, ep.stage, 
-			ep.name, *pShaderRegistry, isDebugging);
-		const uint nameID = pShaderRegistry->GetShader(shaderID).nameID;
+void ShaderLibBuilder::IndexShaderIDs(const VariantBuilder& builder)
+{
+	for (uint i = 0; i < builder.GetShaderCount(); i++)
+		shaderSrcMap[builder.GetShaderKey(i)] = builder.GetShaderID(i);
+}
 
-		variants[i].shaderID = shaderID;
-		variants[i].variantID = vID;
-		// Update name -> shader ID key
-		epNameShaderIDMap[nameID] = shaderID;
+void ShaderLibBuilder::CommitVariant(VariantRepoDef& lib, VariantBuilder& builder, uint vID, sint duplicateID)
+{
+	const uint configID = builder.GetConfigID();
+
+	if (duplicateID == -1) // Register parsed and precompiled variant
+	{
+		const uint resCount = pShaderRegistry->GetUniqueResCount();
+		SetDuplicateShaderIDs(builder);
+		builder.Commit(*pCompiler, *pShaderRegistry, lib.variants[configID], vID);
+		IndexShaderIDs(builder);
+
+		if (resCount == pShaderRegistry->GetUniqueResCount())
+			WV_LOG_WARN() << "Unused flag/mode combination detected. ID: " << vID << ". Not skipped.";
+	}
+	else // Skip processing
+	{
+		CopyVariant(lib, configID, duplicateID);
+		WV_LOG_WARN() << "Unused flag/mode combination detected. ID: " << vID << ". Skipped.";
 	}
 }
 
-void ShaderLibBuilder::GetEffectDefs(DynamicArray<EffectVariantDef>& effects, uint vID)
+void ShaderLibBuilder::CopyVariant(VariantRepoDef& lib, uint configID, uint srcID)
 {
-	// Effects
-	for (uint i = 0; i < (uint)effectBlocks.GetLength(); i++)
+	// Copy variant mappings and update ID
+	lib.variants[configID] = lib.variants[srcID];
+
+	for (ShaderVariantDef& shader : lib.variants[configID].shaders)
+		shader.variantID = configID;
+
+	for (EffectVariantDef& effect : lib.variants[configID].effects)
+		effect.variantID = configID;
+}
+
+ShaderLibDef::Handle ShaderLibBuilder::GetDefinition() const
+{
+	return
 	{
-		const EffectBlock& block = effectBlocks[i];
-		EffectDef effect;
-		effect.nameID = block.nameID;
-		Vector<uint> passBuf = pShaderRegistry->GetTmpIDBuffer();
+		.pPlatform = &platform,
+		.pRepos = &repos,
+		.regHandle = pShaderRegistry->GetDefinition(),
+		.strMapHandle = pShaderRegistry->GetStringIDBuilder().GetDefinition()
+	};
+}
 
-		// Passes
-		for (uint j = 0; j < block.passCount; j++)
-		{
-			PassBlock& pass = effectPasses[block.passStart + j];
-			Vector<uint> idBuf = pShaderRegistry->GetTmpIDBuffer();
+void ShaderLibBuilder::SetTarget(PlatformTargets target) { platform.target = target; }
 
-			// Shaders
-			for (uint k = 0; k < pass.shaderCount; k++)
-			{
-				const uint shaderIndex = pass.shaderStart + k;
-				idBuf.EmplaceBack(effectShaders[shaderIndex]);
-			}
+void ShaderLibBuilder::SetFeatureLevel(string_view featureLevel) { platform.featureLevel = featureLevel; }
 
-			passBuf.EmplaceBack(pShaderRegistry->GetOrAddIDGroup(idBuf));
-			pShaderRegistry->ReturnTmpIDBuffer(std::move(idBuf));
-		}
+void ShaderLibBuilder::SetDebug(bool isDebugging) { this->isDebugging = isDebugging; }
 
-		effect.passGroupID = pShaderRegistry->GetOrAddIDGroup(passBuf);
-		pShaderRegistry->ReturnTmpIDBuffer(std::move(passBuf));
+void ShaderLibBuilder::SetThreadCount(uint threadCount)
+{
+	pWorkerPool.reset(new WorkerPool(threadCount));
+	threadCount = pWorkerPool->GetThreadCount();
 
-		effects[i] = EffectVariantDef 
-		{
-			.effectID = pShaderRegistry->GetOrAddEffect(effect),
-			.variantID = vID
-		};
+	variantBuilders.Clear();
+	variantBuilders.Reserve(threadCount);
+
+	for (uint i = 0; i < threadCount; i++)
+	{
+		VariantBuilder& builder = *variantBuilders.EmplaceBack(new VariantBuilder());
+		builder.SetProfiler(pProfiler.get());
 	}
+
+	batchDuplicates.Resize(threadCount);
+	batchConfigIDs.Reserve(threadCount);
 }
 
-void ShaderLibBuilder::Clear()
+uint ShaderLibBuilder::GetThreadCount() const { return pWorkerPool->GetThreadCount(); }
+
+void ShaderLibBuilder::SetCacheDir(string_view cacheDir)
 {
-	ClearVariant();
-	libBufIndex = 0;
+	if (!cacheDir.empty())
+		pShaderCache.reset(new ShaderCache(cacheDir));
+	else
+		pShaderCache.reset();
+}
 
-	for (int i = 0; i < std::size(libBufs); i++)
+void ShaderLibBuilder::SetIncrementalPreprocessing(bool isIncremental)
+{
+	if (isIncremental)
 	{
-		libBufs[i].libText.clear();
-		libBufs[i].vID = 0;
+		if (pPreprocCache == nullptr)
+			pPreprocCache.reset(new PreprocessorCache());
 	}
+	else
+		pPreprocCache.reset();
+}
 
-	repos.Clear();
-	pVariantGen->Clear();
-	pShaderRegistry->Clear();
+void ShaderLibBuilder::SetProfiling(bool isProfiling)
+{
+	if (isProfiling)
+	{
+		if (pProfiler == nullptr)
+			pProfiler.reset(new BuildProfiler());
+	}
+	else
+		pProfiler.reset();
+
+	for (unique_ptr<VariantBuilder>& pBuilder : variantBuilders)
+		pBuilder->SetProfiler(pProfiler.get());
+}
+
+const BuildProfiler* ShaderLibBuilder::GetProfiler() const { return pProfiler.get(); }
+
+void ShaderLibBuilder::ClearProfile()
+{
+	if (pProfiler != nullptr)
+		pProfiler->Clear();
 }
 
-void ShaderLibBuilder::ClearVariant()
+void ShaderLibBuilder::SetCompiler(unique_ptr<IShaderCompiler>&& pCompiler)
 {
-	pTable->Clear();
-	pAnalyzer->Clear();
-	pShaderGen->Clear();
+	FX_CHECK_MSG(pCompiler != nullptr, "Shader compiler cannot be null");
+	this->pCompiler = std::move(pCompiler);
+	platform.compilerVersion = string(this->pCompiler->GetCompilerVersion());
+}
 
-	entrypoints.Clear();
-	epNameShaderIDMap.clear();
+const IShaderCompiler& ShaderLibBuilder::GetCompiler() const { return *pCompiler; }
 
-	effectBlocks.Clear();
-	effectPasses.Clear();
-	effectShaders.Clear();
+void ShaderLibBuilder::InitVariants(VariantRepoDef& lib, const VariantPreprocessor& variantGen)
+{
+	const IDynamicArray<StringSpan>& flags = variantGen.GetVariantFlags();
+	lib.flagIDs = DynamicArray<uint>(flags.GetLength());
 
-	hlslBuf.clear();
+	for (int i = 0; i < flags.GetLength(); i++)
+		lib.flagIDs[i] = pShaderRegistry->GetOrAddStringID(flags[i]);
+
+	const IDynamicArray<StringSpan>& modes = variantGen.GetVariantModes();
+	lib.modeIDs = DynamicArray<uint>(modes.GetLength());
+
+	for (int i = 0; i < modes.GetLength(); i++)
+		lib.modeIDs[i] = pShaderRegistry->GetOrAddStringID(modes[i]);
+
+	lib.variants = DynamicArray<VariantDef>(variantGen.GetVariantCount());
+
+	WV_LOG_INFO() << "Variants declared: " << lib.variants.GetLength();
+	FX_CHECK_MSG(lib.variants.GetLength() != 0, "No shaders found.");
+}
+
+void ShaderLibBuilder::ClearDuplicateIndex()
+{
+	variantSrcArena.Clear();
+	variantSrcMap.clear();
+	variantEquivIDs.Clear();
+	variantHits = 0;
+	variantCollisions = 0;
+
+	shaderSrcMap.clear();
+	shaderSrcHits = 0;
+	shaderSrcLookups = 0;
 }
+
+void ShaderLibBuilder::Clear()
+{
+	ClearDuplicateIndex();
+
+	for (unique_ptr<VariantBuilder>& pBuilder : variantBuilders)
+		pBuilder->Clear();
+
+	if (pPreprocCache != nullptr)
+		pPreprocCache->Clear();
+
+	repos.Clear();
+	repoIncludes.Clear();
+	pShaderRegistry->Clear();
+}
\ No newline at end of file
@@ -0,0 +1,261 @@
+#include "pch.hpp"
+#include "WeaveEffects/ShaderLibBuilder/BuildProfiler.hpp"
+
+using namespace Weave;
+using namespace Weave::Effects;
+
+// Number of variants listed in the summary
+static constexpr uint s_SummaryVariantCount = 5;
+
+static constexpr string_view s_StageNames[]
+{
+	"Preprocess",
+	"Dedupe",
+	"Analyze",
+	"Parse",
+	"Generate",
+	"Compile",
+	"Commit"
+};
+
+static constexpr string_view s_CounterNames[][g_BuildCounterCount]
+{
+	{ "srcBytes", "" },
+	{ "shaderHits", "shaderLookups" },
+	{ "blocks", "srcBytes" },
+	{ "tokens", "symbols" },
+	{ "hlslBytes", "" },
+	{ "binBytes", "cacheHits" },
+	{ "regHits", "regMisses" }
+};
+
+static_assert(std::size(s_StageNames) == (uint)BuildStages::Count);
+static_assert(std::size(s_CounterNames) == (uint)BuildStages::Count);
+
+BuildProfiler::Scope::Scope(BuildProfiler* pProfiler, BuildStages stage, uint configID) :
+	pProfiler(pProfiler),
+	event()
+{
+	if (pProfiler != nullptr)
+	{
+		event.stage = stage;
+		event.configID = configID;
+		event.startNS = pProfiler->GetTimeNS();
+	}
+}
+
+BuildProfiler::Scope::~Scope()
+{
+	if (pProfiler != nullptr)
+	{
+		event.durationNS = pProfiler->GetTimeNS() - event.startNS;
+		pProfiler->AddEvent(event);
+	}
+}
+
+BuildProfiler::BuildProfiler() :
+	startTime(Stopwatch::Clock::now())
+{ }
+
+void BuildProfiler::BeginRepo(string_view name)
+{
+	std::lock_guard lock(mutex);
+	repoNames.EmplaceBack(name);
+}
+
+slong BuildProfiler::GetTimeNS() const
+{
+	return std::chrono::duration_cast<Stopwatch::Duration>(Stopwatch::Clock::now() - startTime).count();
+}
+
+void BuildProfiler::AddEvent(const BuildEvent& event)
+{
+	std::lock_guard lock(mutex);
+	const auto [it, isNew] = threadIDs.try_emplace(std::this_thread::get_id(), (uint)threadIDs.size());
+	BuildEvent& dst = events.EmplaceBack(event);
+	dst.threadID = it->second;
+	dst.repoID = repoNames.IsEmpty() ? 0 : (uint)repoNames.GetLength() - 1;
+}
+
+/// <summary>
+/// Adds an event to the totals of its stage
+/// </summary>
+static void AddStageTotals(const BuildEvent& event, BuildStageTotals& stage)
+{
+	stage.count++;
+	stage.timeNS += event.durationNS;
+	stage.maxNS = std::max(stage.maxNS, event.durationNS);
+
+	for (uint i = 0; i < g_BuildCounterCount; i++)
+		stage.counters[i] += event.counters[i];
+}
+
+BuildStageTotals BuildProfiler::GetStageTotals(BuildStages stage) const
+{
+	std::lock_guard lock(mutex);
+	BuildStageTotals totals = {};
+
+	for (const BuildEvent& event : events)
+	{
+		if (event.stage == stage)
+			AddStageTotals(event, totals);
+	}
+
+	return totals;
+}
+
+string_view BuildProfiler::GetStageName(BuildStages stage) { return s_StageNames[(uint)stage]; }
+
+string_view BuildProfiler::GetCounterName(BuildStages stage, uint index) { return s_CounterNames[(uint)stage][index]; }
+
+/// <summary>
+/// Writes a string as a quoted JSON string literal
+/// </summary>
+static void WriteJsonString(std::ostream& dst, string_view str)
+{
+	dst << '"';
+
+	for (const char ch : str)
+	{
+		if (ch == '"' || ch == '\\')
+			dst << '\\' << ch;
+		else if ((byte)ch < 0x20)
+			dst << std::format("\\u{:04x}", (uint)ch);
+		else
+			dst << ch;
+	}
+
+	dst << '"';
+}
+
+void BuildProfiler::WriteChromeTrace(std::ostream& dst) const
+{
+	std::lock_guard lock(mutex);
+	dst << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+
+	for (uint i = 0; i < (uint)threadIDs.size(); i++)
+	{
+		dst << (i > 0 ? ",\n" : "\n");
+		dst << std::format(R"({{"name":"thread_name","ph":"M","pid":1,"tid":{},"args":{{"name":"Builder thread {}"}}}})", i, i);
+	}
+
+	for (const BuildEvent& event : events)
+	{
+		// Chrome traces use microseconds
+		dst << ",\n" << std::format(R"({{"name":"{}","cat":"build","ph":"X","pid":1,"tid":{},"ts":{:.3f},"dur":{:.3f},)",
+			GetStageName(event.stage), event.threadID, 1E-3 * (double)event.startNS, 1E-3 * (double)event.durationNS);
+
+		dst << "\"args\":{\"repo\":";
+		WriteJsonString(dst, repoNames.IsEmpty() ? string_view() : string_view(repoNames[event.repoID]));
+		dst << ",\"configID\":" << event.configID;
+
+		for (uint i = 0; i < g_BuildCounterCount; i++)
+		{
+			const string_view counterName = GetCounterName(event.stage, i);
+
+			if (!counterName.empty())
+				dst << ",\"" << counterName << "\":" << event.counters[i];
+		}
+
+		dst << "}}";
+	}
+
+	dst << "\n]}\n";
+}
+
+void BuildProfiler::LogSummary() const
+{
+	struct VariantTotals
+	{
+		uint repoID;
+		uint configID;
+		slong timeNS;
+	};
+
+	std::lock_guard lock(mutex);
+	BuildStageTotals stages[(uint)BuildStages::Count] = {};
+	std::unordered_map<ulong, VariantTotals> variantMap;
+	slong buildStart = events.IsEmpty() ? 0 : events[0].startNS;
+	slong buildEnd = buildStart;
+
+	for (const BuildEvent& event : events)
+	{
+		AddStageTotals(event, stages[(uint)event.stage]);
+
+		const ulong key = ((ulong)event.repoID << 32u) | event.configID;
+		VariantTotals& variant = variantMap.try_emplace(key, VariantTotals{ event.repoID, event.configID, 0 }).first->second;
+		variant.timeNS += event.durationNS;
+
+		buildStart = std::min(buildStart, event.startNS);
+		buildEnd = std::max(buildEnd, event.startNS + event.durationNS);
+	}
+
+	slong totalNS = 0;
+
+	for (const BuildStageTotals& stage : stages)
+		totalNS += stage.timeNS;
+
+	WV_LOG_INFO() << "Build profile: " << events.GetLength() << " events on " << threadIDs.size()
+		<< " threads over " << GetTimeNStoMS(buildEnd - buildStart) << " ms";
+	WV_LOG_INFO() << std::format("  {:<11}{:>8}{:>12}{:>10}{:>10}{:>7}  {}",
+		"Stage", "Calls", "Total ms", "Avg ms", "Max ms", "%", "Counters");
+
+	for (uint i = 0; i < (uint)BuildStages::Count; i++)
+	{
+		const BuildStageTotals& stage = stages[i];
+
+		if (stage.count == 0)
+			continue;
+
+		const BuildStages stageID = (BuildStages)i;
+		string counterText;
+
+		for (uint j = 0; j < g_BuildCounterCount; j++)
+		{
+			const string_view counterName = GetCounterName(stageID, j);
+
+			if (!counterName.empty())
+				counterText += std::format("{}{}: {}", counterText.empty() ? "" : ", ", counterName, stage.counters[j]);
+		}
+
+		WV_LOG_INFO() << std::format("  {:<11}{:>8}{:>12.2f}{:>10.3f}{:>10.3f}{:>7.1f}  {}",
+			GetStageName(stageID), stage.count, GetTimeNStoMS(stage.timeNS),
+			GetTimeNStoMS(stage.timeNS / stage.count), GetTimeNStoMS(stage.maxNS),
+			(totalNS > 0) ? (100.0 * stage.timeNS / totalNS) : 0.0, counterText);
+	}
+
+	// Slowest variants by time summed over all stages
+	Vector<VariantTotals> variants;
+	variants.Reserve(variantMap.size());
+
+	for (const auto& [key, variant] : variantMap)
+		variants.EmplaceBack(variant);
+
+	const uint listCount = std::min((uint)variants.GetLength(), s_SummaryVariantCount);
+	std::partial_sort(variants.begin(), variants.begin() + listCount, variants.end(),
+		[](const VariantTotals& a, const VariantTotals& b)
+	{
+		return (a.timeNS != b.timeNS) ? (a.timeNS > b.timeNS) :
+			(a.repoID != b.repoID) ? (a.repoID < b.repoID) : (a.configID < b.configID);
+	});
+
+	if (listCount > 0)
+		WV_LOG_INFO() << "  Slowest variants:";
+
+	for (uint i = 0; i < listCount; i++)
+	{
+		const VariantTotals& variant = variants[i];
+		WV_LOG_INFO() << std::format("    {} #{}: {:.2f} ms",
+			repoNames.IsEmpty() ? string_view() : string_view(repoNames[variant.repoID]),
+			variant.configID, GetTimeNStoMS(variant.timeNS));
+	}
+}
+
+void BuildProfiler::Clear()
+{
+	std::lock_guard lock(mutex);
+	startTime = Stopwatch::Clock::now();
+	repoNames.Clear();
+	events.Clear();
+	threadIDs.clear();
+}
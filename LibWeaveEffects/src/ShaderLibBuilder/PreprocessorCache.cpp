@@ -0,0 +1,133 @@
+#include "pch.hpp"
+#include <fstream>
+#include "WeaveEffects/ShaderLibBuilder/PreprocessorCache.hpp"
+
+using namespace Weave::Effects;
+
+PreprocessorCache::PreprocessorCache() :
+	hitCount(0)
+{ }
+
+bool PreprocessorCache::TryGetFile(const string& path, string& dst)
+{
+	std::lock_guard<std::mutex> lock(cacheMutex);
+	auto it = fileMap.find(path);
+
+	if (it == fileMap.end())
+	{
+		// Opened in text mode to match Wave's default include loader
+		std::ifstream file(path);
+
+		if (!file.is_open())
+			return false;
+
+		file.unsetf(std::ios::skipws);
+		string text((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+		it = fileMap.emplace(path, std::move(text)).first;
+	}
+
+	dst.assign(it->second);
+	return true;
+}
+
+bool PreprocessorCache::TryGetVariant(uint flagID, uint modeID, string& dst, Vector<ShaderEntrypoint>& entrypoints)
+{
+	std::lock_guard<std::mutex> lock(cacheMutex);
+
+	for (const VariantRef& ref : variants)
+	{
+		if (GetIsEquivalent(ref, flagID, modeID))
+		{
+			dst.append(srcBuf, ref.srcStart, ref.srcLength);
+			entrypoints.AddRange(epBuf, ref.epStart, ref.epCount);
+			hitCount++;
+			return true;
+		}
+	}
+
+	return false;
+}
+
+bool PreprocessorCache::TryGetEquivalent(uint flagID, uint modeID, uint& equivFlagID, uint& equivModeID) const
+{
+	std::lock_guard<std::mutex> lock(cacheMutex);
+
+	for (const VariantRef& ref : variants)
+	{
+		if (GetIsEquivalent(ref, flagID, modeID))
+		{
+			equivFlagID = ref.flagID;
+			equivModeID = ref.modeID;
+			return true;
+		}
+	}
+
+	return false;
+}
+
+void PreprocessorCache::AddVariant(uint flagID, uint modeID, const VariantMacroDeps& deps, string_view src,
+	const IDynamicArray<ShaderEntrypoint>& entrypoints)
+{
+	std::lock_guard<std::mutex> lock(cacheMutex);
+
+	// Concurrent passes over equivalent variants are stored once
+	for (const VariantRef& ref : variants)
+	{
+		if (GetIsEquivalent(ref, flagID, modeID))
+			return;
+	}
+
+	variants.EmplaceBack(VariantRef
+	{
+		.flagID = flagID,
+		.modeID = modeID,
+		.deps = deps,
+		.srcStart = (uint)srcBuf.length(),
+		.srcLength = (uint)src.length(),
+		.epStart = (uint)epBuf.GetLength(),
+		.epCount = (uint)entrypoints.GetLength()
+	});
+
+	srcBuf.append(src);
+	epBuf.AddRange(entrypoints);
+}
+
+uint PreprocessorCache::GetHitCount() const
+{
+	std::lock_guard<std::mutex> lock(cacheMutex);
+	return hitCount;
+}
+
+void PreprocessorCache::ClearVariants()
+{
+	std::lock_guard<std::mutex> lock(cacheMutex);
+	variants.Clear();
+	srcBuf.clear();
+	epBuf.Clear();
+	hitCount = 0;
+}
+
+void PreprocessorCache::Clear()
+{
+	ClearVariants();
+
+	std::lock_guard<std::mutex> lock(cacheMutex);
+	fileMap.clear();
+}
+
+bool PreprocessorCache::GetIsEquivalent(const VariantRef& ref, uint flagID, uint modeID)
+{
+	const VariantMacroDeps& deps = ref.deps;
+
+	if ((flagID & deps.flagMask) != (ref.flagID & deps.flagMask))
+		return false;
+
+	// Only one mode macro is defined at a time, and mode 0 defines none
+	if (modeID != ref.modeID)
+	{
+		if ((modeID > 0 && deps.modeMask[modeID]) || (ref.modeID > 0 && deps.modeMask[ref.modeID]))
+			return false;
+	}
+
+	return true;
+}
@@ -0,0 +1,168 @@
+#include "pch.hpp"
+#include <fstream>
+#include <thread>
+#include "WeaveUtils/Span.hpp"
+#include "WeaveEffects/ShaderLibBuilder/ShaderCache.hpp"
+
+using namespace Weave;
+using namespace Weave::Effects;
+
+namespace fs = std::filesystem;
+
+/// <summary>
+/// Header prefixed to each cache entry
+/// </summary>
+struct CacheEntryHeader
+{
+	uint magic;
+	uint version;
+	ulong byteCodeSize;
+	Hash128 checksum;
+};
+
+// "WFXC"
+static constexpr uint s_CacheMagic = 0x43584657u;
+// Incremented when the entry layout changes
+static constexpr uint s_CacheVersion = 1u;
+
+ShaderCache::ShaderCache(string_view cacheDir) :
+	cacheDir(cacheDir),
+	hitCount(0),
+	missCount(0)
+{
+	try
+	{
+		fs::create_directories(this->cacheDir);
+	}
+	catch (const fs::filesystem_error& e)
+	{
+		FX_THROW("Failed to create shader cache directory '{}': {}", cacheDir, e.what());
+	}
+
+	FX_CHECK_MSG(fs::is_directory(this->cacheDir), "Shader cache path is not a directory: {}", cacheDir);
+}
+
+const fs::path& ShaderCache::GetCacheDir() const { return cacheDir; }
+
+Hash128 ShaderCache::GetKey(
+	string_view srcFile,
+	string_view srcText,
+	ShadeStages stage,
+	string_view mainName,
+	string_view featureLevel,
+	bool isDebugging,
+	string_view compilerVersion
+)
+{
+	static thread_local string keyBuf;
+	keyBuf.clear();
+
+	// Null separators prevent ambiguous concatenations
+	keyBuf.append(compilerVersion);
+	keyBuf.push_back('\0');
+	keyBuf.append(featureLevel);
+	keyBuf.push_back('\0');
+	keyBuf.push_back((char)stage);
+	keyBuf.push_back(isDebugging ? '1' : '0');
+	keyBuf.append(mainName);
+	keyBuf.push_back('\0');
+	// Embedded in debug info and error messages
+	keyBuf.append(srcFile);
+	keyBuf.push_back('\0');
+	keyBuf.append(srcText);
+
+	return GetHash128(keyBuf);
+}
+
+bool ShaderCache::TryGetShader(const Hash128& key, Vector<byte>& byteCode)
+{
+	const fs::path entryPath = GetEntryPath(key);
+	std::ifstream file(entryPath, std::ios::binary | std::ios::ate);
+	CacheEntryHeader header;
+
+	if (!file.is_open())
+	{
+		missCount++;
+		return false;
+	}
+
+	const ulong fileSize = (ulong)file.tellg();
+	file.seekg(0);
+
+	if (fileSize >= sizeof(header) && file.read(reinterpret_cast<char*>(&header), sizeof(header)) &&
+		header.magic == s_CacheMagic && header.version == s_CacheVersion &&
+		header.byteCodeSize == (fileSize - sizeof(header)))
+	{
+		const size_t start = byteCode.GetLength();
+		byteCode.Resize(start + header.byteCodeSize);
+		Span<byte> binSpan(byteCode.GetData() + start, header.byteCodeSize);
+
+		if (file.read(reinterpret_cast<char*>(binSpan.GetData()), header.byteCodeSize) &&
+			GetHash128(binSpan) == header.checksum)
+		{
+			hitCount++;
+			return true;
+		}
+
+		byteCode.Resize(start);
+	}
+
+	WV_LOG_WARN() << "Ignoring invalid shader cache entry: " << entryPath;
+	missCount++;
+	return false;
+}
+
+void ShaderCache::AddShader(const Hash128& key, const IDynamicArray<byte>& byteCode)
+{
+	const CacheEntryHeader header
+	{
+		.magic = s_CacheMagic,
+		.version = s_CacheVersion,
+		.byteCodeSize = (ulong)byteCode.GetLength(),
+		.checksum = GetHash128(byteCode)
+	};
+
+	const fs::path entryPath = GetEntryPath(key);
+	// Written under a unique name and renamed so concurrent readers never see partial entries
+	fs::path tmpPath = entryPath;
+	tmpPath += std::format(".{}.tmp", std::hash<std::thread::id>{}(std::this_thread::get_id()));
+
+	{
+		std::ofstream file(tmpPath, std::ios::binary | std::ios::trunc);
+		file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+		file.write(reinterpret_cast<const char*>(byteCode.GetData()), GetArrSize(byteCode));
+
+		if (!file)
+		{
+			WV_LOG_WARN() << "Failed to write shader cache entry: " << tmpPath;
+			file.close();
+			std::error_code err;
+			fs::remove(tmpPath, err);
+			return;
+		}
+	}
+
+	std::error_code err;
+	fs::rename(tmpPath, entryPath, err);
+
+	if (err)
+	{
+		WV_LOG_WARN() << "Failed to write shader cache entry: " << entryPath << ". " << err.message();
+		fs::remove(tmpPath, err);
+	}
+}
+
+uint ShaderCache::GetHitCount() const { return hitCount; }
+
+uint ShaderCache::GetMissCount() const { return missCount; }
+
+void ShaderCache::ResetStats()
+{
+	hitCount = 0;
+	missCount = 0;
+}
+
+fs::path ShaderCache::GetEntryPath(const Hash128& key) const
+{
+	return cacheDir / std::format("{:016x}{:016x}.bin", key.high, key.low);
+}
@@ -1,6 +1,10 @@
 #include "pch.hpp"
+
+// The D3D11 backend needs the Windows SDK. Other platforms use ShaderCompilerReflect.
+#ifdef _WIN32
 #include <d3d11shader.h>
 #include <d3dcompiler.h>
+#include <winver.h>
 #include <memory>
 #include <thread>
 #include "WeaveUtils/Win32.hpp"
@@ -11,6 +15,7 @@
 
 #pragma comment(lib, "dxguid.lib")
 #pragma comment(lib, "d3dcompiler.lib")
+#pragma comment(lib, "version.lib")
 
 using namespace Weave;
 using namespace Weave::Effects;
@@ -79,8 +84,9 @@ private:
 
 	bool isDebugging;
 
-	// Feature level postfix, e.g. 5_0, 4_0, 4_0_level_9_1
-	string_view featureLevel;
+	// Feature level postfix, e.g. 5_0, 4_0, 4_0_level_9_1. Owned, as the state outlives the 
+	// builders whose platform strings it's set from.
+	string featureLevel;
 	string targets[TargetCount];
 };
 
@@ -147,15 +153,14 @@ static ShaderTypes GetResourceType(const D3D11_SHADER_INPUT_BIND_DESC& resDesc)
 }
 
 /// <summary>
-/// Returns precompiled shader bytecode for D3D11 with the shading stage specified, targeting SM 5.0
+/// Appends precompiled shader bytecode for D3D11 with the shading stage specified to the given buffer
 /// </summary>
-static void GetPrecompShaderD3D11(
+static void CompileShaderD3D11(
 	string_view srcFile, 
 	string_view srcText, 
 	ShadeStages stage, 
 	string_view mainName, 
-	ShaderDef& def, 
-	ShaderRegistryBuilder& builder
+	Vector<byte>& byteCode
 )
 {
 	FXSYNTAX_CHECK_MSG((int)stage >= 0 && (int)stage < CompilerState::GetTargetCount(), "Invalid stage specified");
@@ -212,16 +217,8 @@ static void GetPrecompShaderD3D11(
 	else if (FAILED(hr))
 		FX_THROW("Unknown compiler error");
 
-	def.fileStringID = builder.GetOrAddStringID(srcFile);
-	def.nameID = builder.GetOrAddStringID(mainName);
-	def.stage = stage;
-
 	const Span<byte> binSpan(static_cast<byte*>(binSrc->GetBufferPointer()), binSrc->GetBufferSize());
-	Vector<byte> byteBuf = builder.GetTmpByteBuffer();
-	byteBuf.AddRange(binSpan);
-
-	def.byteCodeID = builder.GetOrAddShaderBin(byteBuf);
-	builder.ReturnTmpByteBuffer(std::move(byteBuf));
+	byteCode.AddRange(binSpan);
 }
 
 /// <summary>
@@ -409,6 +406,48 @@ static void GetReflectedMetadata(ShaderDef& def, ShaderRegistryBuilder& builder)
 		pReflect->GetThreadGroupSize(&def.threadGroupSize.x, &def.threadGroupSize.y, &def.threadGroupSize.z);
 }
 
+/// <summary>
+/// Precompiles the given HLSL source and appends the resulting bytecode to the given buffer
+/// </summary>
+void Weave::Effects::GetPrecompShaderD3D11(
+	string_view srcFile,
+	string_view srcText,
+	string_view featureLevel,
+	ShadeStages stage,
+	string_view mainName,
+	Vector<byte>& byteCode,
+	bool isDebugging
+)
+{
+	s_State.SetFeatureLevel(featureLevel);
+	s_State.SetDebugging(isDebugging);
+
+	CompileShaderD3D11(srcFile, srcText, stage, mainName, byteCode);
+}
+
+/// <summary>
+/// Registers precompiled bytecode and generates metadata for resources required by the shader
+/// </summary>
+uint Weave::Effects::GetShaderDefD3D11(
+	string_view srcFile,
+	const IDynamicArray<byte>& byteCode,
+	ShadeStages stage,
+	string_view mainName,
+	ShaderRegistryBuilder& builder
+)
+{
+	ShaderDef def;
+	def.fileStringID = builder.GetOrAddStringID(srcFile);
+	def.nameID = builder.GetOrAddStringID(mainName);
+	def.stage = stage;
+	def.byteCodeID = builder.GetOrAddShaderBin(byteCode);
+
+	// Reflect binary
+	GetReflectedMetadata(def, builder);
+
+	return builder.GetOrAddShader(def);
+}
+
 /// <summary>
 /// Precompiles the given HLSL source and generates metadata for resources required by the shader
 /// </summary>
@@ -422,16 +461,80 @@ uint Weave::Effects::GetShaderDefD3D11(
 	bool isDebugging
 )
 {
-	ShaderDef def;
-	s_State.SetFeatureLevel(featureLevel);
-	s_State.SetDebugging(isDebugging);
-
 	// Precompile
-	GetPrecompShaderD3D11(srcFile, srcText, stage, mainName, def, builder);
-	// Reflect binary
-	GetReflectedMetadata(def, builder);
+	Vector<byte> byteBuf = builder.GetTmpByteBuffer();
+	GetPrecompShaderD3D11(srcFile, srcText, featureLevel, stage, mainName, byteBuf, isDebugging);
 
-	return builder.GetOrAddShader(def);
+	const uint shaderID = GetShaderDefD3D11(srcFile, byteBuf, stage, mainName, builder);
+	builder.ReturnTmpByteBuffer(std::move(byteBuf));
+
+	return shaderID;
+}
+
+/// <summary>
+/// Returns the compiler DLL name followed by the file version of the loaded module. The name 
+/// alone stays the same when d3dcompiler_47 is updated in place.
+/// </summary>
+static string GetLoadedCompilerVersionD3D11()
+{
+	const HMODULE hModule = GetModuleHandleW(D3DCOMPILER_DLL_W);
+
+	if (hModule == nullptr)
+		WIN_THROW_HR_MSG(GetLastError(), "Failed to find loaded compiler module: {}", D3DCOMPILER_DLL_A);
+
+	wchar_t path[MAX_PATH];
+	const DWORD pathLength = GetModuleFileNameW(hModule, path, MAX_PATH);
+
+	if (pathLength == 0 || pathLength == MAX_PATH)
+		WIN_THROW_HR_MSG(GetLastError(), "Failed to get compiler module path: {}", D3DCOMPILER_DLL_A);
+
+	DWORD handle = 0;
+	const DWORD infoSize = GetFileVersionInfoSizeW(path, &handle);
+	Vector<byte> info;
+	info.Resize(infoSize);
+
+	if (infoSize == 0 || !GetFileVersionInfoW(path, 0, infoSize, info.GetData()))
+		WIN_THROW_HR_MSG(GetLastError(), "Failed to get compiler version info: {}", D3DCOMPILER_DLL_A);
+
+	VS_FIXEDFILEINFO* pFileInfo = nullptr;
+	UINT fileInfoSize = 0;
+
+	FX_CHECK_MSG(VerQueryValueW(info.GetData(), L"\\", reinterpret_cast<void**>(&pFileInfo), &fileInfoSize) && 
+		fileInfoSize >= sizeof(VS_FIXEDFILEINFO), "Compiler version info missing: {}", D3DCOMPILER_DLL_A);
+
+	return std::format("{} {}.{}.{}.{}", D3DCOMPILER_DLL_A,
+		HIWORD(pFileInfo->dwFileVersionMS), LOWORD(pFileInfo->dwFileVersionMS),
+		HIWORD(pFileInfo->dwFileVersionLS), LOWORD(pFileInfo->dwFileVersionLS));
+}
+
+string_view Weave::Effects::GetCompilerVersionD3D11() 
+{
+	// The module is linked on startup and can't change while the process is running
+	static const string s_CompilerVersion = GetLoadedCompilerVersionD3D11();
+	return s_CompilerVersion;
+}
+
+string_view ShaderCompilerD3D11::GetCompilerVersion() const { return GetCompilerVersionD3D11(); }
+
+void ShaderCompilerD3D11::GetPrecompShader(
+	const ShaderSourceDesc& src,
+	string_view featureLevel,
+	Vector<byte>& byteCode,
+	bool isDebugging
+) const
+{
+	GetPrecompShaderD3D11(src.srcFile, src.srcText, featureLevel, src.stage, src.mainName, byteCode, isDebugging);
+}
+
+uint ShaderCompilerD3D11::GetShaderDef(
+	string_view srcFile,
+	const IDynamicArray<byte>& byteCode,
+	ShadeStages stage,
+	string_view mainName,
+	ShaderRegistryBuilder& builder
+) const
+{
+	return GetShaderDefD3D11(srcFile, byteCode, stage, mainName, builder);
 }
 
-string_view Weave::Effects::GetCompilerVersionD3D11() { return D3DCOMPILER_DLL_A; }
\ No newline at end of file
+#endif
@@ -0,0 +1,786 @@
+#include "pch.hpp"
+#include <charconv>
+#include <cstring>
+#include "WeaveUtils/Hash.hpp"
+#include "WeaveEffects/ShaderLibBuilder/SymbolTable.hpp"
+#include "WeaveEffects/ShaderLibBuilder/ShaderCompiler.hpp"
+
+using namespace Weave;
+using namespace Weave::Effects;
+
+/*
+	Placeholder bytecode is a ReflectHeader followed by a reflection payload. The payload stores
+	the thread group size, input and output signatures, constant buffers and resources in that
+	order. Each list is prefixed by its length and strings are prefixed by their length in bytes.
+*/
+
+/// <summary>
+/// Header prefixed to placeholder bytecode
+/// </summary>
+struct ReflectHeader
+{
+	uint magic;
+	uint version;
+	uint stage;
+	uint payloadSize;
+	// Identifies the source and compiler configuration the bytecode was generated from
+	Hash128 srcHash;
+};
+
+// "WFXR"
+static constexpr uint s_ReflectMagic = 0x52584657u;
+// Incremented when the placeholder layout or reflection rules change
+static constexpr uint s_ReflectVersion = 1u;
+static constexpr string_view s_ReflectCompilerVersion = "WFX Reflect 1";
+
+// Matches D3D_REGISTER_COMPONENT_TYPE
+static constexpr uint s_ComponentUInt32 = 1u;
+static constexpr uint s_ComponentSInt32 = 2u;
+static constexpr uint s_ComponentFloat32 = 3u;
+
+// Size of a constant buffer register in bytes
+static constexpr uint s_CBufRegisterSize = 16u;
+static constexpr string_view s_EffectGlobalsName = "_EffectGlobals";
+
+/// <summary>
+/// Returns the number of rows or vector components in a numeric type
+/// </summary>
+static uint GetRowCount(ShaderTypes flags)
+{
+	if ((flags & ShaderTypes::Dim4) == ShaderTypes::Dim4) return 4;
+	if ((flags & ShaderTypes::Dim3) == ShaderTypes::Dim3) return 3;
+	if ((flags & ShaderTypes::Dim2) == ShaderTypes::Dim2) return 2;
+	return 1;
+}
+
+/// <summary>
+/// Returns the number of columns in a matrix type
+/// </summary>
+static uint GetColumnCount(ShaderTypes flags)
+{
+	if ((flags & ShaderTypes::DimAx4) == ShaderTypes::DimAx4) return 4;
+	if ((flags & ShaderTypes::DimAx3) == ShaderTypes::DimAx3) return 3;
+	if ((flags & ShaderTypes::DimAx2) == ShaderTypes::DimAx2) return 2;
+	return 1;
+}
+
+/// <summary>
+/// Returns the size of each component of a numeric type in constant buffers
+/// </summary>
+static uint GetComponentSize(ShaderTypes flags)
+{
+	return ((flags & ShaderTypes::Double) == ShaderTypes::Double) ? 8u : 4u;
+}
+
+/// <summary>
+/// Returns the register component type of a numeric type in a stage signature
+/// </summary>
+static uint GetComponentType(ShaderTypes flags)
+{
+	if ((flags & ShaderTypes::Float) == ShaderTypes::Float)
+		return s_ComponentFloat32;
+	else if ((flags & ShaderTypes::Integer) == ShaderTypes::Integer)
+		return s_ComponentSInt32;
+	else
+		return s_ComponentUInt32;
+}
+
+static uint GetAligned(uint offset, uint alignment) { return (offset + alignment - 1) & ~(alignment - 1); }
+
+/// <summary>
+/// Returns the type of a resource as reported by the D3D11 backend
+/// </summary>
+static ShaderTypes GetResourceType(ShaderTypes flags)
+{
+	if ((flags & ShaderTypes::Sampler) != ShaderTypes::Sampler && (flags & ShaderTypes::RandomRW) != ShaderTypes::RandomRW)
+		flags |= ShaderTypes::ReadOnly;
+
+	return flags;
+}
+
+/// <summary>
+/// Returns the index of the first child of the given token with the given flags, or -1 if none
+/// </summary>
+static int TryGetChildIndex(const TokenNodeHandle& ident, TokenTypes flags)
+{
+	for (int i = 0; i < ident.GetChildCount(); i++)
+	{
+		if (ident[i].GetHasFlags(flags))
+			return i;
+	}
+
+	return -1;
+}
+
+/// <summary>
+/// Resolves the type specified for a variable, parameter or function return value from its
+/// type token. Typedefs are followed to the type they alias. Unrecognized types are returned
+/// as user types with the given name.
+/// </summary>
+static void GetIdentType(const ScopeHandle& scope, const TokenNodeHandle& ident, ShaderTypeInfo& type, TokenTypes& typeFlags)
+{
+	const int typeIndex = TryGetChildIndex(ident, TokenTypes::Type);
+	FX_CHECK_MSG(typeIndex != -1, "Type of '{}' undefined", ident.GetValue());
+
+	const TokenNodeHandle typeToken = ident[typeIndex];
+	typeFlags = typeToken.GetFlags();
+	string_view name = typeToken.GetValue();
+
+	// Bounded to guard against cyclic aliases
+	for (int depth = 0; depth < 8; depth++)
+	{
+		if (const ShaderTypeInfo* pType = TryGetShaderTypeInfo(name); pType != nullptr)
+		{
+			type = *pType;
+			return;
+		}
+
+		optional<SymbolHandle> symbol = scope.TryGetChild(name);
+
+		if (!symbol.has_value() || !symbol->GetHasFlags(SymbolTypes::TypeAlias) || symbol->GetIsScope())
+			break;
+
+		const TokenNodeHandle aliasIdent = symbol->GetIdent();
+		const int aliasIndex = TryGetChildIndex(aliasIdent, TokenTypes::Type);
+
+		if (aliasIndex == -1)
+			break;
+
+		name = aliasIdent[aliasIndex].GetValue();
+	}
+
+	type = ShaderTypeInfo{ .name = name, .flags = ShaderTypes::UserType, .size = 0 };
+}
+
+/// <summary>
+/// Returns the scope defining the members of a user struct or cbuffer visible from the given scope
+/// </summary>
+static optional<ScopeHandle> TryGetUserTypeScope(const ScopeHandle& scope, const ShaderTypeInfo& type)
+{
+	if (!type.GetHasFlags(ShaderTypes::UserType))
+		return std::nullopt;
+
+	optional<SymbolHandle> symbol = scope.TryGetChild(type.name);
+
+	if (symbol.has_value() && symbol->GetHasFlags(SymbolTypes::UserType) && symbol->GetIsScope())
+		return symbol->GetScope();
+	else
+		return std::nullopt;
+}
+
+/// <summary>
+/// Serializes reflection data derived from a parsed variant into placeholder bytecode
+/// </summary>
+class ReflectWriter
+{
+public:
+	void Write(const ShaderSourceDesc& src, string_view featureLevel, bool isDebugging, Vector<byte>& byteCode)
+	{
+		FX_CHECK_MSG(src.pTable != nullptr, "Reflection-only compilation of '{}' requires a parsed source", src.mainName);
+
+		pDst = &byteCode;
+		const size_t headerStart = pDst->GetLength();
+		pDst->Resize(headerStart + sizeof(ReflectHeader));
+
+		const SymbolTable& table = *src.pTable;
+		SymbolHandle main = table.GetSymbol(src.mainID);
+		FX_CHECK_MSG(main.GetHasFlags(SymbolTypes::FuncDefinition) && main.GetName() == src.mainName,
+			"Entrypoint '{}' not found", src.mainName);
+
+		const TokenNodeHandle ident = main.GetIdent();
+		const ScopeHandle scope = *main.GetScope();
+
+		WriteThreadGroupSize(ident, src.stage);
+		WriteIOLayout(scope, ident, src.stage);
+		WriteResources(table, scope);
+
+		const ReflectHeader header
+		{
+			.magic = s_ReflectMagic,
+			.version = s_ReflectVersion,
+			.stage = (uint)src.stage,
+			.payloadSize = (uint)(pDst->GetLength() - headerStart - sizeof(ReflectHeader)),
+			.srcHash = GetSourceHash(src, featureLevel, isDebugging)
+		};
+
+		memcpy(pDst->GetData() + headerStart, &header, sizeof(header));
+		pDst = nullptr;
+	}
+
+private:
+	Vector<byte>* pDst = nullptr;
+	string keyBuf;
+	UniqueVector<int> cbufBuf;
+	UniqueVector<int> globalVarBuf;
+	UniqueVector<int> resourceBuf;
+
+	template<typename T> requires std::is_trivially_copyable_v<T>
+	void WriteValue(const T& value)
+	{
+		const size_t start = pDst->GetLength();
+		pDst->Resize(start + sizeof(T));
+		memcpy(pDst->GetData() + start, &value, sizeof(T));
+	}
+
+	void WriteString(string_view str)
+	{
+		WriteValue((uint)str.length());
+		const size_t start = pDst->GetLength();
+		pDst->Resize(start + str.length());
+		memcpy(pDst->GetData() + start, str.data(), str.length());
+	}
+
+	/// <summary>
+	/// Reserves space for a list length to be written later with SetCount()
+	/// </summary>
+	size_t ReserveCount()
+	{
+		const size_t offset = pDst->GetLength();
+		WriteValue(0u);
+		return offset;
+	}
+
+	void SetCount(size_t offset, uint count) { memcpy(pDst->GetData() + offset, &count, sizeof(count)); }
+
+	Hash128 GetSourceHash(const ShaderSourceDesc& src, string_view featureLevel, bool isDebugging)
+	{
+		keyBuf.clear();
+		keyBuf.append(featureLevel);
+		keyBuf.push_back('\0');
+		keyBuf.push_back(isDebugging ? '1' : '0');
+		keyBuf.append(src.mainName);
+		keyBuf.push_back('\0');
+		keyBuf.append(src.srcText);
+
+		return GetHash128(keyBuf);
+	}
+
+	/// <summary>
+	/// Writes the thread group size declared by the numthreads attribute of compute shaders
+	/// </summary>
+	void WriteThreadGroupSize(const TokenNodeHandle& ident, ShadeStages stage)
+	{
+		uint groupSize[3] = { 0, 0, 0 };
+
+		if (stage == ShadeStages::Compute)
+		{
+			for (int i = 0; i < ident.GetChildCount(); i++)
+			{
+				TokenNodeHandle attrib = ident[i];
+
+				if (attrib.GetHasFlags(TokenTypes::AttribIdent) && attrib.GetValue() == "numthreads")
+				{
+					int argCount = 0;
+
+					for (int j = 0; j < attrib.GetChildCount() && argCount < 3; j++)
+					{
+						if (attrib[j].GetHasFlags(TokenTypes::LiteralArg))
+						{
+							const string_view arg = attrib[j].GetValue();
+							std::from_chars(arg.data(), arg.data() + arg.length(), groupSize[argCount]);
+							argCount++;
+						}
+					}
+
+					break;
+				}
+			}
+		}
+
+		for (uint dim : groupSize)
+			WriteValue(dim);
+	}
+
+	/// <summary>
+	/// Writes input and output signatures from entrypoint parameters and return values
+	/// </summary>
+	void WriteIOLayout(const ScopeHandle& scope, const TokenNodeHandle& ident, ShadeStages stage)
+	{
+		// Compute shaders only take system values
+		const bool hasSignature = stage != ShadeStages::Compute;
+
+		// Inputs
+		size_t countOffset = ReserveCount();
+		uint count = 0;
+
+		if (hasSignature)
+		{
+			for (int i = 0; i < ident.GetChildCount(); i++)
+			{
+				TokenNodeHandle param = ident[i];
+
+				if (param.GetHasFlags(TokenTypes::ParamIdent) && param.GetHasSymbol())
+				{
+					ShaderTypeInfo type;
+					TokenTypes typeFlags;
+					GetIdentType(scope, param, type, typeFlags);
+					count += WriteIOElements(scope, param, type);
+				}
+			}
+		}
+
+		SetCount(countOffset, count);
+
+		// Outputs
+		countOffset = ReserveCount();
+		count = 0;
+
+		if (hasSignature)
+		{
+			ShaderTypeInfo type;
+			TokenTypes typeFlags;
+			GetIdentType(scope, ident, type, typeFlags);
+			count += WriteIOElements(scope, ident, type);
+		}
+
+		SetCount(countOffset, count);
+	}
+
+	/// <summary>
+	/// Writes signature elements for a parameter, return value or struct member. Structs are
+	/// flattened into their members and matrices occupy one element per row.
+	/// </summary>
+	uint WriteIOElements(const ScopeHandle& scope, const TokenNodeHandle& ident, const ShaderTypeInfo& type)
+	{
+		if (const optional<ScopeHandle> structScope = TryGetUserTypeScope(scope, type); structScope.has_value())
+		{
+			uint count = 0;
+
+			for (int i = 0; i < structScope->GetChildCount(); i++)
+			{
+				SymbolHandle member = structScope->GetChild(i);
+
+				if (member.GetHasFlags(SymbolTypes::Variable))
+				{
+					ShaderTypeInfo memberType;
+					TokenTypes typeFlags;
+					GetIdentType(*structScope, member.GetIdent(), memberType, typeFlags);
+					count += WriteIOElements(*structScope, member.GetIdent(), memberType);
+				}
+			}
+
+			return count;
+		}
+
+		const int semanticIndex = TryGetChildIndex(ident, TokenTypes::Semantic);
+
+		if (semanticIndex == -1 || type.flags == ShaderTypes::Void || type.GetHasFlags(ShaderTypes::Resource))
+			return 0;
+
+		const TokenNodeHandle semantic = ident[semanticIndex];
+		const uint firstIndex = (uint)std::max(semantic.GetAsAttribute()->GetSemanticIndex(), 0);
+		const bool isMatrix = type.GetHasFlags(ShaderTypes::Matrix);
+		const uint elementCount = isMatrix ? GetRowCount(type.flags) : 1;
+		const uint componentCount = isMatrix ? GetColumnCount(type.flags) : GetRowCount(type.flags);
+
+		for (uint i = 0; i < elementCount; i++)
+		{
+			WriteString(semantic.GetValue());
+			WriteValue(firstIndex + i);
+			WriteValue(GetComponentType(type.flags));
+			WriteValue(componentCount);
+		}
+
+		return elementCount;
+	}
+
+	/// <summary>
+	/// Identifies constant buffers, loose global constants and resources visible to the entrypoint
+	/// and writes their definitions. Every declared resource is treated as used.
+	/// </summary>
+	void WriteResources(const SymbolTable& table, const ScopeHandle& mainScope)
+	{
+		cbufBuf.Clear();
+		globalVarBuf.Clear();
+		resourceBuf.Clear();
+
+		// Same visibility rules used by the ShaderGenerator for _EffectGlobals
+		optional<ScopeHandle> scope = mainScope.GetParentScope();
+
+		while (scope.has_value())
+		{
+			for (int i = 0; i < scope->GetChildCount(); i++)
+			{
+				SymbolHandle child = scope->GetChild(i);
+
+				if (child.GetHasFlags(SymbolTypes::ConstBufDef))
+				{
+					cbufBuf.EmplaceBack(child.GetID());
+				}
+				else if (child.GetHasFlags(SymbolTypes::Variable) && !child.GetHasFlags(SymbolTypes::Definition) &&
+					!child.GetHasFlags(SymbolTypes::Ambiguous))
+				{
+					ShaderTypeInfo type;
+					TokenTypes modifiers;
+					GetIdentType(*scope, child.GetIdent(), type, modifiers);
+
+					if (type.GetHasFlags(ShaderTypes::Resource))
+						resourceBuf.EmplaceBack(child.GetID());
+					else if ((int)(modifiers & TokenTypes::TypeModifier) == 0)
+						globalVarBuf.EmplaceBack(child.GetID());
+				}
+			}
+
+			scope = scope->GetParentScope();
+		}
+
+		// Symbol IDs follow declaration order
+		std::sort(cbufBuf.begin(), cbufBuf.end());
+		std::sort(globalVarBuf.begin(), globalVarBuf.end());
+		std::sort(resourceBuf.begin(), resourceBuf.end());
+
+		WriteConstantBuffers(table, mainScope);
+		WriteResourceDefs(table, mainScope);
+	}
+
+	/// <summary>
+	/// Writes constant buffer layouts. Generated globals are ordered by their first variable.
+	/// </summary>
+	void WriteConstantBuffers(const SymbolTable& table, const ScopeHandle& mainScope)
+	{
+		const bool hasGlobals = !globalVarBuf.IsEmpty();
+		WriteValue((uint)cbufBuf.GetLength() + (hasGlobals ? 1u : 0u));
+		bool isGlobalsWritten = !hasGlobals;
+
+		for (int cbufID : cbufBuf)
+		{
+			if (!isGlobalsWritten && globalVarBuf[0] < cbufID)
+			{
+				WriteGlobalConstants(table, mainScope);
+				isGlobalsWritten = true;
+			}
+
+			SymbolHandle cbuf = table.GetSymbol(cbufID);
+			const ScopeHandle cbufScope = *cbuf.GetScope();
+			const size_t sizeOffset = WriteCBufferHeader(cbuf.GetName());
+			const size_t countOffset = ReserveCount();
+			uint offset = 0, count = 0;
+
+			for (int i = 0; i < cbufScope.GetChildCount(); i++)
+			{
+				SymbolHandle member = cbufScope.GetChild(i);
+
+				if (member.GetHasFlags(SymbolTypes::Variable))
+				{
+					WriteConstant(cbufScope, member, offset);
+					count++;
+				}
+			}
+
+			SetCount(countOffset, count);
+			SetCount(sizeOffset, GetAligned(offset, s_CBufRegisterSize));
+		}
+
+		if (!isGlobalsWritten)
+			WriteGlobalConstants(table, mainScope);
+	}
+
+	/// <summary>
+	/// Writes the layout of the cbuffer generated for loose global variables
+	/// </summary>
+	void WriteGlobalConstants(const SymbolTable& table, const ScopeHandle& mainScope)
+	{
+		const size_t sizeOffset = WriteCBufferHeader(s_EffectGlobalsName);
+		WriteValue((uint)globalVarBuf.GetLength());
+		uint offset = 0;
+
+		for (int varID : globalVarBuf)
+			WriteConstant(mainScope, table.GetSymbol(varID), offset);
+
+		SetCount(sizeOffset, GetAligned(offset, s_CBufRegisterSize));
+	}
+
+	/// <summary>
+	/// Writes a cbuffer name and returns the offset of its size, set after its layout is known
+	/// </summary>
+	size_t WriteCBufferHeader(string_view name)
+	{
+		WriteString(name);
+		return ReserveCount();
+	}
+
+	/// <summary>
+	/// Writes the definition of a constant packed at the given offset and advances the offset
+	/// </summary>
+	void WriteConstant(const ScopeHandle& scope, const SymbolHandle& var, uint& offset)
+	{
+		ShaderTypeInfo type;
+		TokenTypes typeFlags;
+		GetIdentType(scope, var.GetIdent(), type, typeFlags);
+
+		const uint start = GetPackedOffset(scope, type, offset);
+		WriteString(var.GetName());
+		WriteValue(start);
+		WriteValue(offset - start);
+	}
+
+	/// <summary>
+	/// Packs a value of the given type at the offset using HLSL constant buffer packing rules
+	/// and returns its starting offset. The offset is advanced to the end of the value.
+	/// </summary>
+	static uint GetPackedOffset(const ScopeHandle& scope, const ShaderTypeInfo& type, uint& offset)
+	{
+		// Structs start on a new register and are followed by one
+		if (const optional<ScopeHandle> structScope = TryGetUserTypeScope(scope, type); structScope.has_value())
+		{
+			const uint start = GetAligned(offset, s_CBufRegisterSize);
+			offset = start;
+
+			for (int i = 0; i < structScope->GetChildCount(); i++)
+			{
+				SymbolHandle member = structScope->GetChild(i);
+
+				if (member.GetHasFlags(SymbolTypes::Variable))
+				{
+					ShaderTypeInfo memberType;
+					TokenTypes typeFlags;
+					GetIdentType(*structScope, member.GetIdent(), memberType, typeFlags);
+					GetPackedOffset(*structScope, memberType, offset);
+				}
+			}
+
+			offset = GetAligned(offset, s_CBufRegisterSize);
+			return start;
+		}
+
+		const uint componentSize = GetComponentSize(type.flags);
+		uint start = offset;
+
+		if (type.GetHasFlags(ShaderTypes::Matrix))
+		{
+			// Column major, one register per column
+			start = GetAligned(offset, s_CBufRegisterSize);
+			offset = start + (GetColumnCount(type.flags) - 1) * s_CBufRegisterSize + GetRowCount(type.flags) * componentSize;
+		}
+		else
+		{
+			const uint size = GetRowCount(type.flags) * componentSize;
+
+			// Values can't straddle registers
+			if ((offset % s_CBufRegisterSize) + size > s_CBufRegisterSize)
+				start = GetAligned(offset, s_CBufRegisterSize);
+
+			offset = start + size;
+		}
+
+		return start;
+	}
+
+	/// <summary>
+	/// Writes textures, samplers and buffers with slots assigned sequentially per register class
+	/// </summary>
+	void WriteResourceDefs(const SymbolTable& table, const ScopeHandle& mainScope)
+	{
+		uint srvSlot = 0, samplerSlot = 0, uavSlot = 0;
+		WriteValue((uint)resourceBuf.GetLength());
+
+		for (int resID : resourceBuf)
+		{
+			SymbolHandle res = table.GetSymbol(resID);
+			ShaderTypeInfo resType;
+			TokenTypes typeFlags;
+			GetIdentType(mainScope, res.GetIdent(), resType, typeFlags);
+			const ShaderTypes type = GetResourceType(resType.flags);
+			uint slot;
+
+			if ((type & ShaderTypes::Sampler) == ShaderTypes::Sampler)
+				slot = samplerSlot++;
+			else if ((type & ShaderTypes::RandomRW) == ShaderTypes::RandomRW)
+				slot = uavSlot++;
+			else
+				slot = srvSlot++;
+
+			WriteString(res.GetName());
+			WriteValue(type);
+			WriteValue(slot);
+		}
+	}
+};
+
+/// <summary>
+/// Reads reflection data from placeholder bytecode
+/// </summary>
+class ReflectReader
+{
+public:
+	ReflectReader(const IDynamicArray<byte>& byteCode, ShadeStages stage) :
+		pSrc(byteCode.GetData()),
+		pos(sizeof(ReflectHeader)),
+		end(byteCode.GetLength())
+	{
+		FX_CHECK_MSG(end >= sizeof(ReflectHeader), "Invalid reflection bytecode");
+
+		ReflectHeader header;
+		memcpy(&header, pSrc, sizeof(header));
+
+		FX_CHECK_MSG(header.magic == s_ReflectMagic && header.version == s_ReflectVersion &&
+			header.payloadSize == (end - pos), "Invalid reflection bytecode");
+		FX_CHECK_MSG(header.stage == (uint)stage, "Reflection bytecode stage mismatch");
+	}
+
+	template<typename T> requires std::is_trivially_copyable_v<T>
+	T ReadValue()
+	{
+		FX_CHECK_MSG(pos + sizeof(T) <= end, "Unexpected end of reflection bytecode");
+		T value;
+		memcpy(&value, pSrc + pos, sizeof(T));
+		pos += sizeof(T);
+
+		return value;
+	}
+
+	string_view ReadString()
+	{
+		const uint length = ReadValue<uint>();
+		FX_CHECK_MSG(pos + length <= end, "Unexpected end of reflection bytecode");
+		const string_view str(reinterpret_cast<const char*>(pSrc + pos), length);
+		pos += length;
+
+		return str;
+	}
+
+private:
+	const byte* pSrc;
+	size_t pos;
+	size_t end;
+};
+
+/// <summary>
+/// Registers a signature read from placeholder bytecode and returns its layout ID, or -1 if empty
+/// </summary>
+static uint GetIOLayout(ReflectReader& reader, ShaderRegistryBuilder& builder)
+{
+	const uint count = reader.ReadValue<uint>();
+
+	if (count == 0)
+		return -1;
+
+	Vector<uint> idBuf = builder.GetTmpIDBuffer();
+
+	for (uint i = 0; i < count; i++)
+	{
+		IOElementDef element;
+		element.semanticID = builder.GetOrAddStringID(reader.ReadString());
+		element.semanticIndex = reader.ReadValue<uint>();
+		element.dataType = reader.ReadValue<uint>();
+		element.componentCount = reader.ReadValue<uint>();
+		element.size = element.componentCount * 4; // Assume 4-byte/32-bit components
+
+		idBuf.EmplaceBack(builder.GetOrAddIOElement(element));
+	}
+
+	const uint layoutID = builder.GetOrAddIDGroup(idBuf);
+	builder.ReturnTmpIDBuffer(std::move(idBuf));
+
+	return layoutID;
+}
+
+/// <summary>
+/// Registers constant buffers read from placeholder bytecode and returns their group ID, or -1 if none
+/// </summary>
+static uint GetConstantBuffers(ReflectReader& reader, ShaderRegistryBuilder& builder)
+{
+	const uint cbufCount = reader.ReadValue<uint>();
+
+	if (cbufCount == 0)
+		return -1;
+
+	Vector<uint> groupIDbuf = builder.GetTmpIDBuffer();
+
+	for (uint i = 0; i < cbufCount; i++)
+	{
+		Vector<uint> constIDbuf = builder.GetTmpIDBuffer();
+		ConstBufDef constants;
+		constants.stringID = builder.GetOrAddStringID(reader.ReadString());
+		constants.size = reader.ReadValue<uint>();
+		const uint varCount = reader.ReadValue<uint>();
+
+		for (uint j = 0; j < varCount; j++)
+		{
+			ConstDef varDef;
+			varDef.stringID = builder.GetOrAddStringID(reader.ReadString());
+			varDef.offset = reader.ReadValue<uint>();
+			varDef.size = reader.ReadValue<uint>();
+
+			constIDbuf.EmplaceBack(builder.GetOrAddConstant(varDef));
+		}
+
+		constants.layoutID = builder.GetOrAddIDGroup(constIDbuf);
+		groupIDbuf.EmplaceBack(builder.GetOrAddConstantBuffer(constants));
+		builder.ReturnTmpIDBuffer(std::move(constIDbuf));
+	}
+
+	const uint groupID = builder.GetOrAddIDGroup(groupIDbuf);
+	builder.ReturnTmpIDBuffer(std::move(groupIDbuf));
+
+	return groupID;
+}
+
+/// <summary>
+/// Registers resources read from placeholder bytecode and returns their layout ID, or -1 if none
+/// </summary>
+static uint GetResources(ReflectReader& reader, ShaderRegistryBuilder& builder)
+{
+	const uint resCount = reader.ReadValue<uint>();
+
+	if (resCount == 0)
+		return -1;
+
+	Vector<uint> idBuf = builder.GetTmpIDBuffer();
+
+	for (uint i = 0; i < resCount; i++)
+	{
+		ResourceDef res;
+		res.stringID = builder.GetOrAddStringID(reader.ReadString());
+		res.type = reader.ReadValue<ShaderTypes>();
+		res.slot = reader.ReadValue<uint>();
+
+		idBuf.EmplaceBack(builder.GetOrAddResource(res));
+	}
+
+	const uint layoutID = builder.GetOrAddIDGroup(idBuf);
+	builder.ReturnTmpIDBuffer(std::move(idBuf));
+
+	return layoutID;
+}
+
+string_view ShaderCompilerReflect::GetCompilerVersion() const { return s_ReflectCompilerVersion; }
+
+void ShaderCompilerReflect::GetPrecompShader(
+	const ShaderSourceDesc& src,
+	string_view featureLevel,
+	Vector<byte>& byteCode,
+	bool isDebugging
+) const
+{
+	static thread_local ReflectWriter s_Writer;
+	s_Writer.Write(src, featureLevel, isDebugging, byteCode);
+}
+
+uint ShaderCompilerReflect::GetShaderDef(
+	string_view srcFile,
+	const IDynamicArray<byte>& byteCode,
+	ShadeStages stage,
+	string_view mainName,
+	ShaderRegistryBuilder& builder
+) const
+{
+	ReflectReader reader(byteCode, stage);
+
+	ShaderDef def;
+	def.fileStringID = builder.GetOrAddStringID(srcFile);
+	def.nameID = builder.GetOrAddStringID(mainName);
+	def.stage = stage;
+	def.byteCodeID = builder.GetOrAddShaderBin(byteCode);
+
+	// Registered in the same order as reflected D3D11 metadata
+	def.threadGroupSize.x = reader.ReadValue<uint>();
+	def.threadGroupSize.y = reader.ReadValue<uint>();
+	def.threadGroupSize.z = reader.ReadValue<uint>();
+	def.inLayoutID = GetIOLayout(reader, builder);
+	def.outLayoutID = GetIOLayout(reader, builder);
+	def.cbufGroupID = GetConstantBuffers(reader, builder);
+	def.resLayoutID = GetResources(reader, builder);
+
+	return builder.GetOrAddShader(def);
+}
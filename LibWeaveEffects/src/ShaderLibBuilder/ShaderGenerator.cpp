@@ -13,6 +13,37 @@ static void AppendLineDirective(int line, string& srcOut)
 	std::format_to(std::back_inserter(srcOut), "#line {}\n", line);
 }
 
+static bool GetIsIdentChar(char ch)
+{
+	return (ch >= 'a' && ch <= 'z') || (ch >= 'A' && ch <= 'Z') || (ch >= '0' && ch <= '9') || ch == '_';
+}
+
+/// <summary>
+/// Returns true if the block is a lone semicolon, like the one terminating a struct definition
+/// </summary>
+static bool GetIsEmptyStatement(const LexBlock& block)
+{
+	if (!block.GetHasFlags(LexBlockTypes::SemicolonSeparator))
+		return false;
+
+	for (const char ch : block.src)
+	{
+		if (ch != ';' && ch > ' ')
+			return false;
+	}
+
+	return true;
+}
+
+/// <summary>
+/// Returns true if the block's text is emitted as is and can reference other symbols. Containers
+/// span their contents, and only their brackets are emitted.
+/// </summary>
+static bool GetIsReferenceBlock(const LexBlock& block)
+{
+	return !block.GetHasAnyFlag(LexBlockTypes::Container | LexBlockTypes::Directive);
+}
+
 SourceMask::SourceMask() : altText(), startBlock(0), blockCount(0) { }
 
 SourceMask::SourceMask(TextBlock altText, int startBlock, int blockCount) :
@@ -32,6 +63,7 @@ void ShaderGenerator::GetShaderSource(const SymbolTable& table, const IDynamicAr
 	Clear();
 	GetGlobalVariables(table, main.symbolID);
 	GetSourceMask(table, srcBlocks, main, shaders);
+	MaskUnreachableDefinitions(table, srcBlocks, main);
 	GetMaskedSource(srcBlocks, srcOut);
 }
 
@@ -40,6 +72,10 @@ void ShaderGenerator::Clear()
 	globalVarBuf.Clear();
 	globalVarDefBuf.clear();
 	sourceMasks.Clear();
+	defRanges.Clear();
+	defNameMap.clear();
+	blockDefs.Clear();
+	defQueue.Clear();
 }
 
 static void GetCorrectedMask(SourceMask& a, SourceMask& b)
@@ -227,6 +263,151 @@ void ShaderGenerator::GenerateGlobalCBuffer(const SymbolTable& table, const IDyn
 	sourceMasks[bufMaskIndex].altText = globalVarDefBuf;
 }
 
+void ShaderGenerator::MaskUnreachableDefinitions(const SymbolTable& table, const IDynamicArray<LexBlock>& srcBlocks, 
+	const ShaderEntrypoint& main)
+{
+	defRanges.Clear();
+	defNameMap.clear();
+	defQueue.Clear();
+
+	optional<ScopeHandle> scope = table.GetSymbol(main.symbolID).GetScope()->GetParentScope();
+
+	do
+	{
+		AddScopeDefinitions(*scope, srcBlocks, main.symbolID);
+		scope = scope->GetParentScope();
+
+	} while (scope != std::nullopt);
+
+	if (defRanges.GetLength() == 0)
+		return;
+
+	blockDefs.Clear();
+	blockDefs.Resize(srcBlocks.GetLength());
+	std::fill(blockDefs.begin(), blockDefs.end(), -1);
+
+	for (int defID = 0; defID < defRanges.GetLength(); defID++)
+	{
+		const DefinitionRange& def = defRanges[defID];
+		std::fill_n(blockDefs.begin() + def.blockStart, def.blockCount, defID);
+	}
+
+	for (const SourceMask& mask : sourceMasks)
+	{
+		if (mask.blockCount > 0)
+			std::fill_n(blockDefs.begin() + mask.startBlock, mask.blockCount, -2);
+	}
+
+	// Everything emitted outside of a definition is a root, including replacement text
+	for (const SourceMask& mask : sourceMasks)
+		AddReferences(mask.altText);
+
+	for (int blockID = 0; blockID < srcBlocks.GetLength(); blockID++)
+	{
+		if (blockDefs[blockID] == -1 && GetIsReferenceBlock(srcBlocks[blockID]))
+			AddReferences(srcBlocks[blockID].src);
+	}
+
+	// Follow references from reachable definitions. Queue grows as new ones are found.
+	for (int i = 0; i < defQueue.GetLength(); i++)
+	{
+		const int defID = defQueue[i];
+		const int blockStart = defRanges[defID].blockStart,
+			blockEnd = blockStart + defRanges[defID].blockCount;
+
+		for (int blockID = blockStart; blockID < blockEnd; blockID++)
+		{
+			if (blockDefs[blockID] == defID && GetIsReferenceBlock(srcBlocks[blockID]))
+				AddReferences(srcBlocks[blockID].src);
+		}
+	}
+
+	for (const DefinitionRange& def : defRanges)
+	{
+		if (!def.isReachable)
+			sourceMasks.EmplaceBack("", def.blockStart, def.blockCount);
+	}
+}
+
+void ShaderGenerator::AddScopeDefinitions(ScopeHandle scope, const IDynamicArray<LexBlock>& srcBlocks, const int main)
+{
+	for (int i = 0; i < scope.GetChildCount(); i++)
+	{
+		SymbolHandle symbol = scope.GetChild(i);
+
+		if (symbol.GetID() == main || !symbol.GetIsScope() || symbol.GetHasFlags(SymbolTypes::Alias))
+			continue;
+
+		ScopeHandle defScope = *symbol.GetScope();
+		const int blockStart = symbol.GetIdent().GetBlockStart();
+		int lastBlock = defScope.GetBlockStart() + defScope.GetBlockCount() - 1;
+
+		if (symbol.GetHasFlags(SymbolTypes::StructDef))
+		{
+			// Structs also declaring variables are left in place
+			if ((lastBlock + 1) < srcBlocks.GetLength() && GetIsEmptyStatement(srcBlocks[lastBlock + 1]))
+				lastBlock++;
+			else
+				continue;
+		}
+		else if (!symbol.GetHasFlags(SymbolTypes::FuncDefinition))
+			continue;
+
+		// Overloads and types sharing a name are chained and reached together
+		const int defID = (int)defRanges.GetLength();
+		DefinitionRange& def = defRanges.EmplaceBack();
+		def.blockStart = blockStart;
+		def.blockCount = lastBlock - blockStart + 1;
+		def.next = -1;
+		def.isReachable = false;
+
+		const auto [it, isNew] = defNameMap.try_emplace(symbol.GetName(), defID);
+
+		if (!isNew)
+		{
+			def.next = it->second;
+			it->second = defID;
+		}
+	}
+}
+
+void ShaderGenerator::AddReferences(string_view text)
+{
+	size_t pos = 0;
+
+	while (pos < text.length())
+	{
+		if (!GetIsIdentChar(text[pos]))
+		{
+			pos++;
+			continue;
+		}
+
+		const size_t start = pos;
+
+		while (pos < text.length() && GetIsIdentChar(text[pos]))
+			pos++;
+
+		// Numeric literal
+		if (text[start] >= '0' && text[start] <= '9')
+			continue;
+
+		const auto it = defNameMap.find(text.substr(start, pos - start));
+
+		if (it != defNameMap.end())
+		{
+			for (int defID = it->second; defID != -1; defID = defRanges[defID].next)
+			{
+				if (!defRanges[defID].isReachable)
+				{
+					defRanges[defID].isReachable = true;
+					defQueue.Add(defID);
+				}
+			}
+		}
+	}
+}
+
 void ShaderGenerator::AddScopeMask(SymbolHandle symbol, bool isContentMasked)
 {
 	ScopeHandle scope = *symbol.GetScope();
@@ -1,8 +1,14 @@
 #include "pch.hpp"
 #include <charconv>
+#include <bit>
 #include "WeaveEffects/EffectParseException.hpp"
 #include "WeaveEffects/ShaderLibBuilder/ShaderParser/BlockAnalyzer.hpp"
 
+#if defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2) || defined(__SSE2__)
+#define FX_BLOCK_SCAN_SSE2
+#include <emmintrin.h>
+#endif
+
 namespace Weave::Effects
 {
     static LexBlockTypes GetDelimiterType(const char ch)
@@ -37,6 +43,101 @@ namespace Weave::Effects
         "=,:;{}()[]<>#", // 2 - Can start or close templates
     };
 
+    // Number of chars classified per vector step
+    static constexpr size_t s_ScanWidth = 16;
+
+    /// <summary>
+    /// Returns a pointer to the first char in [pStart, pEnd) that isn't whitespace, or pEnd if 
+    /// there are none. Newlines skipped are added to line. Chars are signed, so anything outside 
+    /// of ASCII is treated as whitespace, same as the per-char check.
+    /// </summary>
+    static const char* SkipWhitespace(const char* pStart, const char* pEnd, int& line)
+    {
+        const char* pCh = pStart;
+
+#ifdef FX_BLOCK_SCAN_SSE2
+        const __m128i space = _mm_set1_epi8(' ');
+        const __m128i newline = _mm_set1_epi8('\n');
+
+        while (UnsignedDelta(pEnd, pCh) >= s_ScanWidth)
+        {
+            const __m128i chars = _mm_loadu_si128((const __m128i*)pCh);
+            const uint wordMask = (uint)_mm_movemask_epi8(_mm_cmpgt_epi8(chars, space));
+            const uint lineMask = (uint)_mm_movemask_epi8(_mm_cmpeq_epi8(chars, newline));
+
+            if (wordMask != 0)
+            {
+                const int offset = std::countr_zero(wordMask);
+                line += std::popcount(lineMask & ((1u << offset) - 1u));
+                return pCh + offset;
+            }
+
+            line += std::popcount(lineMask);
+            pCh += s_ScanWidth;
+        }
+#endif
+
+        for (; pCh < pEnd && *pCh <= ' '; pCh++)
+        {
+            if (*pCh == '\n')
+                line++;
+        }
+
+        return pCh;
+    }
+
+    /// <summary>
+    /// Returns a pointer to the first char in [pStart, pEnd) that can't be part of a block, 
+    /// either because it's in the break filter or because it's outside of ASCII. Returns pEnd 
+    /// if there are none. Newlines before the returned char are added to lineCount.
+    /// </summary>
+    static const char* FindBlockEnd(const char* pStart, const char* pEnd, string_view filter, int& lineCount)
+    {
+        const char* pCh = pStart;
+
+#ifdef FX_BLOCK_SCAN_SSE2
+        __m128i breakChars[s_ScanWidth];
+        const uint filterLength = (uint)std::min(filter.length(), s_ScanWidth);
+        const __m128i zero = _mm_setzero_si128();
+        const __m128i newline = _mm_set1_epi8('\n');
+
+        FX_ASSERT_MSG(filter.length() <= s_ScanWidth, "Block break filter too long");
+
+        for (uint i = 0; i < filterLength; i++)
+            breakChars[i] = _mm_set1_epi8(filter[i]);
+
+        while (UnsignedDelta(pEnd, pCh) >= s_ScanWidth)
+        {
+            const __m128i chars = _mm_loadu_si128((const __m128i*)pCh);
+            __m128i isBreak = _mm_cmplt_epi8(chars, zero);
+
+            for (uint i = 0; i < filterLength; i++)
+                isBreak = _mm_or_si128(isBreak, _mm_cmpeq_epi8(chars, breakChars[i]));
+
+            const uint breakMask = (uint)_mm_movemask_epi8(isBreak);
+            const uint lineMask = (uint)_mm_movemask_epi8(_mm_cmpeq_epi8(chars, newline));
+
+            if (breakMask != 0)
+            {
+                const int offset = std::countr_zero(breakMask);
+                lineCount += std::popcount(lineMask & ((1u << offset) - 1u));
+                return pCh + offset;
+            }
+
+            lineCount += std::popcount(lineMask);
+            pCh += s_ScanWidth;
+        }
+#endif
+
+        for (; pCh < pEnd && TextBlock::GetIsRangeChar(*pCh, filter); pCh++)
+        {
+            if (*pCh == '\n')
+                lineCount++;
+        }
+
+        return pCh;
+    }
+
     /// <summary>
     /// Returns appropriate filter based on current template instantiation or backtracking state.
     /// </summary>
@@ -91,10 +192,10 @@ namespace Weave::Effects
             // Parse
             if (pPos <= &src.GetBack())
             { 
-                if (*pPos <= ' ') // Skip whitespace
+                if (*pPos <= ' ') // Skip whitespace and count lines
                 {
-                    if (*pPos == '\n') // Count lines
-                        line++;
+                    pPos = SkipWhitespace(pPos, &src.GetBack() + 1, line);
+                    continue;
                 }
                 else // Get blocks
                 {
@@ -151,14 +252,9 @@ namespace Weave::Effects
 
     void BlockAnalyzer::AddBlock(const TextBlock& start)
     {
-        const string_view filter = GetBreakFilter();
-        const char* pNext = start.GetData() - 1;
-
-        do
-        {
-            pNext = start.FindEnd(pNext + 1, filter);
-        } 
-        while (pNext < &start.GetBack() && TextBlock::GetIsRangeChar(*pNext, filter));
+        // Terminates on the first break char, or the last char if there are none
+        int lineCount = 0;
+        const char* pNext = FindBlockEnd(start.GetData(), &start.GetBack(), GetBreakFilter(), lineCount);
 
         // Create new non-container block
         LexBlock& block = blocks.EmplaceBack();
@@ -201,7 +297,8 @@ namespace Weave::Effects
         block.depth = depth;
         block.src = TextBlock(start.GetData(), pNext);
         block.startLine = line;
-        block.lineCount = block.src.FindCount('\n');
+        // The terminating char is never a newline, so the lines scanned are the lines spanned
+        block.lineCount = lineCount;
         block.file = GetFileIndex();
 
         line += block.lineCount;
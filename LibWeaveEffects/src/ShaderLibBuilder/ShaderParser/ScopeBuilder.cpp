@@ -1,4 +1,5 @@
 #include "pch.hpp"
+#include "WeaveUtils/Hash.hpp"
 #include "WeaveEffects/ShaderLibBuilder/ShaderParser/SymbolData.hpp"
 #include "WeaveEffects/ShaderLibBuilder/ShaderParser/SymbolPatterns.hpp"
 #include "WeaveEffects/ShaderLibBuilder/ShaderParser/ScopeBuilder.hpp"
@@ -6,6 +7,174 @@
 using namespace Weave;
 using namespace Weave::Effects;
 
+// Initial number of slots in the name ID table. Must be a power of two.
+static constexpr uint s_NameTableStartSize = 256;
+
+NameIDTable::NameIDTable() :
+    slots(s_NameTableStartSize),
+    count(0),
+    generation(1)
+{ }
+
+uint NameIDTable::FindSlot(const ulong hash, string_view name) const
+{
+    const uint mask = (uint)slots.GetLength() - 1;
+    uint index = (uint)hash & mask;
+
+    // Linear probing, terminated by the first slot not written since the last clear
+    while (slots[index].generation == generation)
+    {
+        const Slot& slot = slots[index];
+
+        if (slot.hash == hash && slot.name == name)
+            break;
+
+        index = (index + 1) & mask;
+    }
+
+    return index;
+}
+
+int NameIDTable::TryGetID(string_view name) const
+{
+    const Slot& slot = slots[FindSlot(GetHash64(name.data(), name.size()), name)];
+    return (slot.generation == generation) ? slot.id : -1;
+}
+
+int NameIDTable::GetOrAddID(string_view name)
+{
+    // Keep load under 1/2
+    if (2 * (count + 1) > slots.GetLength())
+        Grow();
+
+    const ulong hash = GetHash64(name.data(), name.size());
+    Slot& slot = slots[FindSlot(hash, name)];
+
+    if (slot.generation != generation)
+    {
+        slot.name = name;
+        slot.hash = hash;
+        slot.id = (int)count;
+        slot.generation = generation;
+        count++;
+    }
+
+    return slot.id;
+}
+
+void NameIDTable::Clear()
+{
+    count = 0;
+    generation++;
+
+    // Stale generations must never collide with the current one
+    if (generation == 0)
+    {
+        for (Slot& slot : slots)
+            slot.generation = 0;
+
+        generation = 1;
+    }
+}
+
+void NameIDTable::Grow()
+{
+    UniqueArray<Slot> oldSlots(std::move(slots));
+    slots = UniqueArray<Slot>(2 * oldSlots.GetLength());
+
+    for (const Slot& slot : oldSlots)
+    {
+        if (slot.generation == generation)
+            slots[FindSlot(slot.hash, slot.name)] = slot;
+    }
+}
+
+/// <summary>
+/// Returns the list head at the given index, or -1 if the list hasn't been allocated
+/// </summary>
+static int GetListHead(const IDynamicArray<int>& heads, const int index)
+{
+    return (index < (int)heads.GetLength()) ? heads[index] : -1;
+}
+
+/// <summary>
+/// Returns a reference to the list head at the given index, allocating empty lists up to it
+/// </summary>
+static int& GetOrAddListHead(UniqueVector<int>& heads, const int index)
+{
+    while ((int)heads.GetLength() <= index)
+        heads.EmplaceBack(-1);
+
+    return heads[index];
+}
+
+ScopeNameTable::ScopeNameTable() = default;
+
+int ScopeNameTable::TryGetValue(const int scopeID, const int nameID) const
+{
+    for (int i = GetListHead(nameHeads, nameID); i != -1; i = bindings[i].next)
+    {
+        if (bindings[i].scopeID == scopeID)
+            return bindings[i].value;
+    }
+
+    return -1;
+}
+
+int ScopeNameTable::TryGetActiveValue(const int nameID) const
+{
+    const int index = GetListHead(activeHeads, nameID);
+    return (index != -1) ? bindings[index].value : -1;
+}
+
+int ScopeNameTable::GetFirstBinding(const int nameID) const { return GetListHead(nameHeads, nameID); }
+
+const ScopeBinding& ScopeNameTable::GetBinding(const int index) const { return bindings[index]; }
+
+bool ScopeNameTable::TryAdd(const int scopeID, const int nameID, const int value)
+{
+    int& activeHead = GetOrAddListHead(activeHeads, nameID);
+
+    // Bindings in the innermost scope are always at the top of their stacks
+    if (activeHead != -1 && bindings[activeHead].scopeID == scopeID)
+        return false;
+
+    int& nameHead = GetOrAddListHead(nameHeads, nameID);
+    int& scopeHead = GetOrAddListHead(scopeHeads, scopeID);
+    const int index = (int)bindings.GetLength();
+
+    bindings.EmplaceBack(ScopeBinding
+    {
+        .nameID = nameID,
+        .scopeID = scopeID,
+        .value = value,
+        .next = nameHead,
+        .nextActive = activeHead,
+        .nextInScope = scopeHead
+    });
+
+    nameHead = index;
+    activeHead = index;
+    scopeHead = index;
+
+    return true;
+}
+
+void ScopeNameTable::PopScope(const int scopeID)
+{
+    // Bindings in enclosed scopes were already removed, leaving these at the top
+    for (int i = GetListHead(scopeHeads, scopeID); i != -1; i = bindings[i].nextInScope)
+        activeHeads[bindings[i].nameID] = bindings[i].nextActive;
+}
+
+void ScopeNameTable::Clear()
+{
+    bindings.Clear();
+    nameHeads.Clear();
+    activeHeads.Clear();
+    scopeHeads.Clear();
+}
+
 ScopeBuilder::ScopeBuilder() :
     scopes(50),
     topScope(0)
@@ -32,31 +201,39 @@ void ScopeBuilder::AddScope(const int symbolID, const int blockStart, const int
     ScopeData& scope = scopes.EmplaceBack();
     scope.symbolID = symbolID;
     scope.parentScope = parentID;
+    scope.lastChildScope = std::numeric_limits<int>::max();
     scope.blockStart = blockStart;
     scope.blockCount = blockCount;
 
-    scopeSymbolMaps.EmplaceBack();
-    funcOverloadMaps.EmplaceBack();
-    scopeSymbolLists.EmplaceBack();
+    // Reuse symbol lists left over from previous clears
+    if (topScope < (int)scopeSymbolLists.GetLength())
+        scopeSymbolLists[topScope].Clear();
+    else
+        scopeSymbolLists.EmplaceBack();
 }
 
 void ScopeBuilder::AddFuncToOverloadTable(const string_view name, const int symbolID)
 {
-    FuncOverloadMap& map = funcOverloadMaps[topScope];
+    const int nameID = nameIDs.GetOrAddID(name);
+    const int listID = (int)funcOverloads.GetLength();
 
-    if (!map.contains(name))
-        map.emplace(name, IDList());
+    if (funcOverloadTable.TryAdd(topScope, nameID, listID))
+        funcOverloads.EmplaceBack(overloadNodes);
 
-    IDList& funcList = map.find(name)->second;
-    funcList.push_front(symbolID);
+    IDList& funcList = funcOverloads[funcOverloadTable.TryGetActiveValue(nameID)];
+    overloadNodes.EmplaceBack(symbolID, funcList.head);
+    funcList.head = (int)overloadNodes.GetLength() - 1;
+    funcList.length++;
 }
 
 void ScopeBuilder::Clear()
 {
     scopes.Clear();
-    scopeSymbolMaps.Clear();
-    funcOverloadMaps.Clear();
-    scopeSymbolLists.Clear();
+    nameIDs.Clear();
+    scopeSymbolTable.Clear();
+    funcOverloadTable.Clear();
+    funcOverloads.Clear();
+    overloadNodes.Clear();
 
     tokens.Clear();
     symbols.Clear();
@@ -67,7 +244,7 @@ void ScopeBuilder::Clear()
     attributes.Clear();
 
     deferredSymbolBuf.Clear();
-    generatedText.clear();
+    generatedText.Clear();
 
     Init();
 }
@@ -121,17 +298,15 @@ int ScopeBuilder::GetScopeChild(const int scopeID, const int index) const
 
 int ScopeBuilder::GetScopeChild(const int scopeID, string_view ident) const
 {
-    if (scopeSymbolMaps[scopeID].contains(ident))
-        return scopeSymbolMaps[scopeID].find(ident)->second;
-    else
-        return -1;
+    const int nameID = nameIDs.TryGetID(ident);
+    return (nameID != -1) ? scopeSymbolTable.TryGetValue(scopeID, nameID) : -1;
 }
 
 size_t ScopeBuilder::GetScopeChildCount(const int scopeID) const { return scopeSymbolLists[scopeID].GetLength(); }
 
-string_view ScopeBuilder::AddGeneratedText(string&& str) { return generatedText.emplace_front(std::move(str)); }
+string_view ScopeBuilder::AddGeneratedText(string&& str) { return generatedText.Add(str); }
 
-string_view ScopeBuilder::AddGeneratedText(string_view str) { return generatedText.emplace_front(str); }
+string_view ScopeBuilder::AddGeneratedText(string_view str) { return generatedText.Add(str); }
 
 bool ScopeBuilder::TryGetTokenFlags(TokenDef& token, int top) const
 {
@@ -193,74 +368,58 @@ const ShaderTypeInfo* ScopeBuilder::TryGetType(string_view name, int top) const
     return nullptr;
 }
 
-bool ScopeBuilder::TryGetSymbol(string_view name, int& symbolID, int top) const
+int ScopeBuilder::TryResolveName(const ScopeNameTable& table, string_view name, int top) const
 {
-    if (top == -1)
-        top = topScope;
+    const int nameID = nameIDs.TryGetID(name);
+
+    if (nameID == -1)
+        return -1;
 
-    const ScopeData* pScope;
+    // Open scopes are resolved from the top of the name's binding stack
+    if (top == -1 || top == topScope)
+        return table.TryGetActiveValue(nameID);
 
-    do
+    // Scopes are numbered in the order they're opened, so the innermost scope enclosing the 
+    // top scope has the largest ID of those that do
+    int value = -1;
+    int valueScope = -1;
+
+    for (int i = table.GetFirstBinding(nameID); i != -1; i = table.GetBinding(i).next)
     {
-        pScope = &scopes[top];
-        auto nameSymbolPair = scopeSymbolMaps[top].find(name);
+        const ScopeBinding& binding = table.GetBinding(i);
 
-        if (nameSymbolPair != scopeSymbolMaps[top].end())
+        if (binding.scopeID > valueScope && binding.scopeID <= top && top <= scopes[binding.scopeID].lastChildScope)
         {
-            symbolID = nameSymbolPair->second;
-            return true;
+            value = binding.value;
+            valueScope = binding.scopeID;
         }
+    }
 
-        top = pScope->parentScope;
-
-    } while (pScope->parentScope != -1);
-
-    return false;
+    return value;
 }
 
-const IDList* ScopeBuilder::TryGetFuncOverloads(string_view ident, int top) const
+bool ScopeBuilder::TryGetSymbol(string_view name, int& symbolID, int top) const
 {
-    if (top == -1)
-        top = topScope;
-
-    const ScopeData* pScope;
+    const int id = TryResolveName(scopeSymbolTable, name, top);
 
-    do
+    if (id != -1)
     {
-        pScope = &scopes[top];     
-        auto nameSymbolPair = funcOverloadMaps[top].find(ident);
-
-        if (nameSymbolPair != funcOverloadMaps[top].end())
-        {
-            return &nameSymbolPair->second;
-        }
-
-        top = pScope->parentScope;
+        symbolID = id;
+        return true;
+    }
 
-    } while (pScope->parentScope != -1);
+    return false;
+}
 
-    return nullptr;
+const IDList* ScopeBuilder::TryGetFuncOverloads(string_view ident, int top) const
+{
+    const int listID = TryResolveName(funcOverloadTable, ident, top);
+    return (listID != -1) ? &funcOverloads[listID] : nullptr;
 }
 
 bool ScopeBuilder::GetHasSymbol(string_view name, int top) const
 {
-    if (top == -1)
-        top = topScope;
-
-    const ScopeData* pScope;
-
-    do
-    {
-        pScope = &scopes[top];
-
-        if (scopeSymbolMaps[top].contains(name))
-            return true;
-
-        top = pScope->parentScope;
-
-    } while (pScope->parentScope != -1);
-
-    return false;
+    return TryResolveName(scopeSymbolTable, name, top) != -1;
 }
 
 int ScopeBuilder::GetNewToken(string_view value, TokenTypes flags, const int depth, const int blockID)
@@ -380,6 +539,9 @@ void ScopeBuilder::PopScope(const int lastBlock)
     FX_ASSERT_MSG(scope.parentScope >= 0, "Attempted to terminate global scope.");
 
     scope.blockCount = lastBlock - scope.blockStart + 1;
+    scope.lastChildScope = (int)scopes.GetLength() - 1;
+    scopeSymbolTable.PopScope(topScope);
+    funcOverloadTable.PopScope(topScope);
     topScope = scope.parentScope;
 }
 
@@ -407,7 +569,7 @@ void ScopeBuilder::PushSymbol(const int symbolID, const bool isDeferred)
 
         FXSYNTAX_CHECK_MSG(!GetHasSymbol(name), "Unexpected redefinition of symbol '{}'", name);
 
-        scopeSymbolMaps[topScope].emplace(name, symbolID);
+        scopeSymbolTable.TryAdd(topScope, nameIDs.GetOrAddID(name), symbolID);
         scopeSymbolLists[topScope].EmplaceBack(symbolID);
     }
 
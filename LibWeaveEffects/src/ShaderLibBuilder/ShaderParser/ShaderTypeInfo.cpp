@@ -1,38 +1,37 @@
 #include "pch.hpp"
+#include "WeaveUtils/PerfectHash.hpp"
 #include "WeaveEffects/ShaderLibBuilder/ShaderParser/ShaderTypeInfo.hpp"
 
 namespace Weave::Effects
 {
-	using MapEntry = std::unordered_map<ShaderTypes, ShaderTypeInfo>::value_type;
-
 	template<typename T>
-	static MapEntry GetTypeEntry(string_view name, ShaderTypes flags) 
+	static constexpr ShaderTypeInfo GetTypeEntry(string_view name, ShaderTypes flags) 
 	{ 
-		return { flags, { name, flags, sizeof(T) } }; 
+		return { name, flags, sizeof(T) }; 
 	}
 
-static const std::unordered_map<ShaderTypes, ShaderTypeInfo> s_ShaderTypeMap =
+static constexpr ShaderTypeInfo s_ShaderTypes[] =
 {
-{ShaderTypes::Void,{"void",ShaderTypes::Void,0u}},
-{ShaderTypes::Matrix,{"matrix",ShaderTypes::Matrix,0u}},
-{ShaderTypes::Texture,{"Texture",ShaderTypes::Texture,0u}},
-{ShaderTypes::Texture1D,{"Texture1D",ShaderTypes::Texture1D,0u}},
-{ShaderTypes::Texture2D,{"Texture2D",ShaderTypes::Texture2D,0u}},
-{ShaderTypes::Texture3D,{"Texture3D",ShaderTypes::Texture3D,0u}},
-{ShaderTypes::Texture1DArray,{"Texture1DArray",ShaderTypes::Texture1DArray,0u}},
-{ShaderTypes::Texture2DArray,{"Texture2DArray",ShaderTypes::Texture2DArray,0u}},
-{ShaderTypes::TextureCube,{"TextureCube",ShaderTypes::TextureCube,0u}},
-{ShaderTypes::TextureCube,{"TextureCubeArray",ShaderTypes::TextureCube,0u}},
-{ShaderTypes::RwTexture,{"RWTexture",ShaderTypes::RwTexture,0u}},
-{ShaderTypes::RWTexture1D,{"RWTexture1D",ShaderTypes::RWTexture1D,0u}},
-{ShaderTypes::RWTexture2D,{"RWTexture2D",ShaderTypes::RWTexture2D,0u}},
-{ShaderTypes::RwTexture1DArray,{"RWTexture1DArray",ShaderTypes::RwTexture1DArray,0u}},
-{ShaderTypes::RwTexture2DArray,{"RWTexture2DArray",ShaderTypes::RwTexture2DArray,0u}},
-{ShaderTypes::Buffer,{"Buffer",ShaderTypes::Buffer,0u}},
-{ShaderTypes::StructuredBuffer,{"StructuredBuffer",ShaderTypes::StructuredBuffer,0u}},
-{ShaderTypes::RwBuffer,{"RWBuffer",ShaderTypes::RwBuffer,0u}},
-{ShaderTypes::RwStructuredBuffer,{"RWStructuredBuffer",ShaderTypes::RwStructuredBuffer,0u}},
-{ShaderTypes::Sampler,{"SamplerState",ShaderTypes::Sampler,0u}},
+{"void",ShaderTypes::Void,0u},
+{"matrix",ShaderTypes::Matrix,0u},
+{"Texture",ShaderTypes::Texture,0u},
+{"Texture1D",ShaderTypes::Texture1D,0u},
+{"Texture2D",ShaderTypes::Texture2D,0u},
+{"Texture3D",ShaderTypes::Texture3D,0u},
+{"Texture1DArray",ShaderTypes::Texture1DArray,0u},
+{"Texture2DArray",ShaderTypes::Texture2DArray,0u},
+{"TextureCube",ShaderTypes::TextureCube,0u},
+{"TextureCubeArray",ShaderTypes::TextureCube,0u},
+{"RWTexture",ShaderTypes::RwTexture,0u},
+{"RWTexture1D",ShaderTypes::RWTexture1D,0u},
+{"RWTexture2D",ShaderTypes::RWTexture2D,0u},
+{"RWTexture1DArray",ShaderTypes::RwTexture1DArray,0u},
+{"RWTexture2DArray",ShaderTypes::RwTexture2DArray,0u},
+{"Buffer",ShaderTypes::Buffer,0u},
+{"StructuredBuffer",ShaderTypes::StructuredBuffer,0u},
+{"RWBuffer",ShaderTypes::RwBuffer,0u},
+{"RWStructuredBuffer",ShaderTypes::RwStructuredBuffer,0u},
+{"SamplerState",ShaderTypes::Sampler,0u},
 GetTypeEntry<bool>("bool",(ShaderTypes::Scalar|ShaderTypes::Bool)),
 GetTypeEntry<glm::vec<2,bool,glm::defaultp>>("bool2",(ShaderTypes::Vector|ShaderTypes::Bool|ShaderTypes::Dim2)),
 GetTypeEntry<glm::mat<2,2,bool,glm::defaultp>>("bool2x2",(ShaderTypes::Matrix|ShaderTypes::Bool|ShaderTypes::Dim2|ShaderTypes::DimAx2)),
@@ -98,285 +97,110 @@ GetTypeEntry<glm::vec<4,double,glm::defaultp>>("double4",(ShaderTypes::Vector|Sh
 GetTypeEntry<glm::mat<4,2,double,glm::defaultp>>("double4x2",(ShaderTypes::Matrix|ShaderTypes::Double|ShaderTypes::Dim4|ShaderTypes::DimAx2)),
 GetTypeEntry<glm::mat<4,3,double,glm::defaultp>>("double4x3",(ShaderTypes::Matrix|ShaderTypes::Double|ShaderTypes::Dim4|ShaderTypes::DimAx3)),
 GetTypeEntry<glm::mat<4,4,double,glm::defaultp>>("double4x4",(ShaderTypes::Matrix|ShaderTypes::Double|ShaderTypes::Dim4|ShaderTypes::DimAx4)),
-{(ShaderTypes::Scalar|ShaderTypes::HalfFloat),{"half",(ShaderTypes::Scalar|ShaderTypes::HalfFloat),0u}},
-{(ShaderTypes::Vector|ShaderTypes::HalfFloat|ShaderTypes::Dim2),{"half2",(ShaderTypes::Vector|ShaderTypes::HalfFloat|ShaderTypes::Dim2),0u}},
-{(ShaderTypes::Matrix|ShaderTypes::HalfFloat|ShaderTypes::Dim2|ShaderTypes::DimAx2),{"half2x2",(ShaderTypes::Matrix|ShaderTypes::HalfFloat|ShaderTypes::Dim2|ShaderTypes::DimAx2),0u}},
-{(ShaderTypes::Matrix|ShaderTypes::HalfFloat|ShaderTypes::Dim2|ShaderTypes::DimAx3),{"half2x3",(ShaderTypes::Matrix|ShaderTypes::HalfFloat|ShaderTypes::Dim2|ShaderTypes::DimAx3),0u}},
-{(ShaderTypes::Matrix|ShaderTypes::HalfFloat|ShaderTypes::Dim2|ShaderTypes::DimAx4),{"half2x4",(ShaderTypes::Matrix|ShaderTypes::HalfFloat|ShaderTypes::Dim2|ShaderTypes::DimAx4),0u}},
-{(ShaderTypes::Vector|ShaderTypes::HalfFloat|ShaderTypes::Dim3),{"half3",(ShaderTypes::Vector|ShaderTypes::HalfFloat|ShaderTypes::Dim3),0u}},
-{(ShaderTypes::Matrix|ShaderTypes::HalfFloat|ShaderTypes::Dim3|ShaderTypes::DimAx2),{"half3x2",(ShaderTypes::Matrix|ShaderTypes::HalfFloat|ShaderTypes::Dim3|ShaderTypes::DimAx2),0u}},
-{(ShaderTypes::Matrix|ShaderTypes::HalfFloat|ShaderTypes::Dim3|ShaderTypes::DimAx3),{"half3x3",(ShaderTypes::Matrix|ShaderTypes::HalfFloat|ShaderTypes::Dim3|ShaderTypes::DimAx3),0u}},
-{(ShaderTypes::Matrix|ShaderTypes::HalfFloat|ShaderTypes::Dim3|ShaderTypes::DimAx4),{"half3x4",(ShaderTypes::Matrix|ShaderTypes::HalfFloat|ShaderTypes::Dim3|ShaderTypes::DimAx4),0u}},
-{(ShaderTypes::Vector|ShaderTypes::HalfFloat|ShaderTypes::Dim4),{"half4",(ShaderTypes::Vector|ShaderTypes::HalfFloat|ShaderTypes::Dim4),0u}},
-{(ShaderTypes::Matrix|ShaderTypes::HalfFloat|ShaderTypes::Dim4|ShaderTypes::DimAx2),{"half4x2",(ShaderTypes::Matrix|ShaderTypes::HalfFloat|ShaderTypes::Dim4|ShaderTypes::DimAx2),0u}},
-{(ShaderTypes::Matrix|ShaderTypes::HalfFloat|ShaderTypes::Dim4|ShaderTypes::DimAx3),{"half4x3",(ShaderTypes::Matrix|ShaderTypes::HalfFloat|ShaderTypes::Dim4|ShaderTypes::DimAx3),0u}},
-{(ShaderTypes::Matrix|ShaderTypes::HalfFloat|ShaderTypes::Dim4|ShaderTypes::DimAx4),{"half4x4",(ShaderTypes::Matrix|ShaderTypes::HalfFloat|ShaderTypes::Dim4|ShaderTypes::DimAx4),0u}},
-{(ShaderTypes::Scalar|ShaderTypes::Min10Float),{"min10float",(ShaderTypes::Scalar|ShaderTypes::Min10Float),0u}},
-{(ShaderTypes::Vector|ShaderTypes::Min10Float|ShaderTypes::Dim2),{"min10float2",(ShaderTypes::Vector|ShaderTypes::Min10Float|ShaderTypes::Dim2),0u}},
-{(ShaderTypes::Matrix|ShaderTypes::Min10Float|ShaderTypes::Dim2|ShaderTypes::DimAx2),{"min10float2x2",(ShaderTypes::Matrix|ShaderTypes::Min10Float|ShaderTypes::Dim2|ShaderTypes::DimAx2),0u}},
-{(ShaderTypes::Matrix|ShaderTypes::Min10Float|ShaderTypes::Dim2|ShaderTypes::DimAx3),{"min10float2x3",(ShaderTypes::Matrix|ShaderTypes::Min10Float|ShaderTypes::Dim2|ShaderTypes::DimAx3),0u}},
-{(ShaderTypes::Matrix|ShaderTypes::Min10Float|ShaderTypes::Dim2|ShaderTypes::DimAx4),{"min10float2x4",(ShaderTypes::Matrix|ShaderTypes::Min10Float|ShaderTypes::Dim2|ShaderTypes::DimAx4),0u}},
-{(ShaderTypes::Vector|ShaderTypes::Min10Float|ShaderTypes::Dim3),{"min10float3",(ShaderTypes::Vector|ShaderTypes::Min10Float|ShaderTypes::Dim3),0u}},
-{(ShaderTypes::Matrix|ShaderTypes::Min10Float|ShaderTypes::Dim3|ShaderTypes::DimAx2),{"min10float3x2",(ShaderTypes::Matrix|ShaderTypes::Min10Float|ShaderTypes::Dim3|ShaderTypes::DimAx2),0u}},
-{(ShaderTypes::Matrix|ShaderTypes::Min10Float|ShaderTypes::Dim3|ShaderTypes::DimAx3),{"min10float3x3",(ShaderTypes::Matrix|ShaderTypes::Min10Float|ShaderTypes::Dim3|ShaderTypes::DimAx3),0u}},
-{(ShaderTypes::Matrix|ShaderTypes::Min10Float|ShaderTypes::Dim3|ShaderTypes::DimAx4),{"min10float3x4",(ShaderTypes::Matrix|ShaderTypes::Min10Float|ShaderTypes::Dim3|ShaderTypes::DimAx4),0u}},
-{(ShaderTypes::Vector|ShaderTypes::Min10Float|ShaderTypes::Dim4),{"min10float4",(ShaderTypes::Vector|ShaderTypes::Min10Float|ShaderTypes::Dim4),0u}},
-{(ShaderTypes::Matrix|ShaderTypes::Min10Float|ShaderTypes::Dim4|ShaderTypes::DimAx2),{"min10float4x2",(ShaderTypes::Matrix|ShaderTypes::Min10Float|ShaderTypes::Dim4|ShaderTypes::DimAx2),0u}},
-{(ShaderTypes::Matrix|ShaderTypes::Min10Float|ShaderTypes::Dim4|ShaderTypes::DimAx3),{"min10float4x3",(ShaderTypes::Matrix|ShaderTypes::Min10Float|ShaderTypes::Dim4|ShaderTypes::DimAx3),0u}},
-{(ShaderTypes::Matrix|ShaderTypes::Min10Float|ShaderTypes::Dim4|ShaderTypes::DimAx4),{"min10float4x4",(ShaderTypes::Matrix|ShaderTypes::Min10Float|ShaderTypes::Dim4|ShaderTypes::DimAx4),0u}},
-{(ShaderTypes::Scalar|ShaderTypes::Min16Float),{"min16float",(ShaderTypes::Scalar|ShaderTypes::Min16Float),0u}},
-{(ShaderTypes::Vector|ShaderTypes::Min16Float|ShaderTypes::Dim2),{"min16float2",(ShaderTypes::Vector|ShaderTypes::Min16Float|ShaderTypes::Dim2),0u}},
-{(ShaderTypes::Matrix|ShaderTypes::Min16Float|ShaderTypes::Dim2|ShaderTypes::DimAx2),{"min16float2x2",(ShaderTypes::Matrix|ShaderTypes::Min16Float|ShaderTypes::Dim2|ShaderTypes::DimAx2),0u}},
-{(ShaderTypes::Matrix|ShaderTypes::Min16Float|ShaderTypes::Dim2|ShaderTypes::DimAx3),{"min16float2x3",(ShaderTypes::Matrix|ShaderTypes::Min16Float|ShaderTypes::Dim2|ShaderTypes::DimAx3),0u}},
-{(ShaderTypes::Matrix|ShaderTypes::Min16Float|ShaderTypes::Dim2|ShaderTypes::DimAx4),{"min16float2x4",(ShaderTypes::Matrix|ShaderTypes::Min16Float|ShaderTypes::Dim2|ShaderTypes::DimAx4),0u}},
-{(ShaderTypes::Vector|ShaderTypes::Min16Float|ShaderTypes::Dim3),{"min16float3",(ShaderTypes::Vector|ShaderTypes::Min16Float|ShaderTypes::Dim3),0u}},
-{(ShaderTypes::Matrix|ShaderTypes::Min16Float|ShaderTypes::Dim3|ShaderTypes::DimAx2),{"min16float3x2",(ShaderTypes::Matrix|ShaderTypes::Min16Float|ShaderTypes::Dim3|ShaderTypes::DimAx2),0u}},
-{(ShaderTypes::Matrix|ShaderTypes::Min16Float|ShaderTypes::Dim3|ShaderTypes::DimAx3),{"min16float3x3",(ShaderTypes::Matrix|ShaderTypes::Min16Float|ShaderTypes::Dim3|ShaderTypes::DimAx3),0u}},
-{(ShaderTypes::Matrix|ShaderTypes::Min16Float|ShaderTypes::Dim3|ShaderTypes::DimAx4),{"min16float3x4",(ShaderTypes::Matrix|ShaderTypes::Min16Float|ShaderTypes::Dim3|ShaderTypes::DimAx4),0u}},
-{(ShaderTypes::Vector|ShaderTypes::Min16Float|ShaderTypes::Dim4),{"min16float4",(ShaderTypes::Vector|ShaderTypes::Min16Float|ShaderTypes::Dim4),0u}},
-{(ShaderTypes::Matrix|ShaderTypes::Min16Float|ShaderTypes::Dim4|ShaderTypes::DimAx2),{"min16float4x2",(ShaderTypes::Matrix|ShaderTypes::Min16Float|ShaderTypes::Dim4|ShaderTypes::DimAx2),0u}},
-{(ShaderTypes::Matrix|ShaderTypes::Min16Float|ShaderTypes::Dim4|ShaderTypes::DimAx3),{"min16float4x3",(ShaderTypes::Matrix|ShaderTypes::Min16Float|ShaderTypes::Dim4|ShaderTypes::DimAx3),0u}},
-{(ShaderTypes::Matrix|ShaderTypes::Min16Float|ShaderTypes::Dim4|ShaderTypes::DimAx4),{"min16float4x4",(ShaderTypes::Matrix|ShaderTypes::Min16Float|ShaderTypes::Dim4|ShaderTypes::DimAx4),0u}},
-{(ShaderTypes::Scalar|ShaderTypes::Min10Int),{"min10int",(ShaderTypes::Scalar|ShaderTypes::Min10Int),0u}},
-{(ShaderTypes::Vector|ShaderTypes::Min10Int|ShaderTypes::Dim2),{"min10int2",(ShaderTypes::Vector|ShaderTypes::Min10Int|ShaderTypes::Dim2),0u}},
-{(ShaderTypes::Matrix|ShaderTypes::Min10Int|ShaderTypes::Dim2|ShaderTypes::DimAx2),{"min10int2x2",(ShaderTypes::Matrix|ShaderTypes::Min10Int|ShaderTypes::Dim2|ShaderTypes::DimAx2),0u}},
-{(ShaderTypes::Matrix|ShaderTypes::Min10Int|ShaderTypes::Dim2|ShaderTypes::DimAx3),{"min10int2x3",(ShaderTypes::Matrix|ShaderTypes::Min10Int|ShaderTypes::Dim2|ShaderTypes::DimAx3),0u}},
-{(ShaderTypes::Matrix|ShaderTypes::Min10Int|ShaderTypes::Dim2|ShaderTypes::DimAx4),{"min10int2x4",(ShaderTypes::Matrix|ShaderTypes::Min10Int|ShaderTypes::Dim2|ShaderTypes::DimAx4),0u}},
-{(ShaderTypes::Vector|ShaderTypes::Min10Int|ShaderTypes::Dim3),{"min10int3",(ShaderTypes::Vector|ShaderTypes::Min10Int|ShaderTypes::Dim3),0u}},
-{(ShaderTypes::Matrix|ShaderTypes::Min10Int|ShaderTypes::Dim3|ShaderTypes::DimAx2),{"min10int3x2",(ShaderTypes::Matrix|ShaderTypes::Min10Int|ShaderTypes::Dim3|ShaderTypes::DimAx2),0u}},
-{(ShaderTypes::Matrix|ShaderTypes::Min10Int|ShaderTypes::Dim3|ShaderTypes::DimAx3),{"min10int3x3",(ShaderTypes::Matrix|ShaderTypes::Min10Int|ShaderTypes::Dim3|ShaderTypes::DimAx3),0u}},
-{(ShaderTypes::Matrix|ShaderTypes::Min10Int|ShaderTypes::Dim3|ShaderTypes::DimAx4),{"min10int3x4",(ShaderTypes::Matrix|ShaderTypes::Min10Int|ShaderTypes::Dim3|ShaderTypes::DimAx4),0u}},
-{(ShaderTypes::Vector|ShaderTypes::Min10Int|ShaderTypes::Dim4),{"min10int4",(ShaderTypes::Vector|ShaderTypes::Min10Int|ShaderTypes::Dim4),0u}},
-{(ShaderTypes::Matrix|ShaderTypes::Min10Int|ShaderTypes::Dim4|ShaderTypes::DimAx2),{"min10int4x2",(ShaderTypes::Matrix|ShaderTypes::Min10Int|ShaderTypes::Dim4|ShaderTypes::DimAx2),0u}},
-{(ShaderTypes::Matrix|ShaderTypes::Min10Int|ShaderTypes::Dim4|ShaderTypes::DimAx3),{"min10int4x3",(ShaderTypes::Matrix|ShaderTypes::Min10Int|ShaderTypes::Dim4|ShaderTypes::DimAx3),0u}},
-{(ShaderTypes::Matrix|ShaderTypes::Min10Int|ShaderTypes::Dim4|ShaderTypes::DimAx4),{"min10int4x4",(ShaderTypes::Matrix|ShaderTypes::Min10Int|ShaderTypes::Dim4|ShaderTypes::DimAx4),0u}},
-{(ShaderTypes::Scalar|ShaderTypes::Min16Int),{"min16int",(ShaderTypes::Scalar|ShaderTypes::Min16Int),0u}},
-{(ShaderTypes::Vector|ShaderTypes::Min16Int|ShaderTypes::Dim2),{"min16int2",(ShaderTypes::Vector|ShaderTypes::Min16Int|ShaderTypes::Dim2),0u}},
-{(ShaderTypes::Matrix|ShaderTypes::Min16Int|ShaderTypes::Dim2|ShaderTypes::DimAx2),{"min16int2x2",(ShaderTypes::Matrix|ShaderTypes::Min16Int|ShaderTypes::Dim2|ShaderTypes::DimAx2),0u}},
-{(ShaderTypes::Matrix|ShaderTypes::Min16Int|ShaderTypes::Dim2|ShaderTypes::DimAx3),{"min16int2x3",(ShaderTypes::Matrix|ShaderTypes::Min16Int|ShaderTypes::Dim2|ShaderTypes::DimAx3),0u}},
-{(ShaderTypes::Matrix|ShaderTypes::Min16Int|ShaderTypes::Dim2|ShaderTypes::DimAx4),{"min16int2x4",(ShaderTypes::Matrix|ShaderTypes::Min16Int|ShaderTypes::Dim2|ShaderTypes::DimAx4),0u}},
-{(ShaderTypes::Vector|ShaderTypes::Min16Int|ShaderTypes::Dim3),{"min16int3",(ShaderTypes::Vector|ShaderTypes::Min16Int|ShaderTypes::Dim3),0u}},
-{(ShaderTypes::Matrix|ShaderTypes::Min16Int|ShaderTypes::Dim3|ShaderTypes::DimAx2),{"min16int3x2",(ShaderTypes::Matrix|ShaderTypes::Min16Int|ShaderTypes::Dim3|ShaderTypes::DimAx2),0u}},
-{(ShaderTypes::Matrix|ShaderTypes::Min16Int|ShaderTypes::Dim3|ShaderTypes::DimAx3),{"min16int3x3",(ShaderTypes::Matrix|ShaderTypes::Min16Int|ShaderTypes::Dim3|ShaderTypes::DimAx3),0u}},
-{(ShaderTypes::Matrix|ShaderTypes::Min16Int|ShaderTypes::Dim3|ShaderTypes::DimAx4),{"min16int3x4",(ShaderTypes::Matrix|ShaderTypes::Min16Int|ShaderTypes::Dim3|ShaderTypes::DimAx4),0u}},
-{(ShaderTypes::Vector|ShaderTypes::Min16Int|ShaderTypes::Dim4),{"min16int4",(ShaderTypes::Vector|ShaderTypes::Min16Int|ShaderTypes::Dim4),0u}},
-{(ShaderTypes::Matrix|ShaderTypes::Min16Int|ShaderTypes::Dim4|ShaderTypes::DimAx2),{"min16int4x2",(ShaderTypes::Matrix|ShaderTypes::Min16Int|ShaderTypes::Dim4|ShaderTypes::DimAx2),0u}},
-{(ShaderTypes::Matrix|ShaderTypes::Min16Int|ShaderTypes::Dim4|ShaderTypes::DimAx3),{"min16int4x3",(ShaderTypes::Matrix|ShaderTypes::Min16Int|ShaderTypes::Dim4|ShaderTypes::DimAx3),0u}},
-{(ShaderTypes::Matrix|ShaderTypes::Min16Int|ShaderTypes::Dim4|ShaderTypes::DimAx4),{"min16int4x4",(ShaderTypes::Matrix|ShaderTypes::Min16Int|ShaderTypes::Dim4|ShaderTypes::DimAx4),0u}},
-{(ShaderTypes::Scalar|ShaderTypes::Min10UInt),{"min10uint",(ShaderTypes::Scalar|ShaderTypes::Min10UInt),0u}},
-{(ShaderTypes::Vector|ShaderTypes::Min10UInt|ShaderTypes::Dim2),{"min10uint2",(ShaderTypes::Vector|ShaderTypes::Min10UInt|ShaderTypes::Dim2),0u}},
-{(ShaderTypes::Matrix|ShaderTypes::Min10UInt|ShaderTypes::Dim2|ShaderTypes::DimAx2),{"min10uint2x2",(ShaderTypes::Matrix|ShaderTypes::Min10UInt|ShaderTypes::Dim2|ShaderTypes::DimAx2),0u}},
-{(ShaderTypes::Matrix|ShaderTypes::Min10UInt|ShaderTypes::Dim2|ShaderTypes::DimAx3),{"min10uint2x3",(ShaderTypes::Matrix|ShaderTypes::Min10UInt|ShaderTypes::Dim2|ShaderTypes::DimAx3),0u}},
-{(ShaderTypes::Matrix|ShaderTypes::Min10UInt|ShaderTypes::Dim2|ShaderTypes::DimAx4),{"min10uint2x4",(ShaderTypes::Matrix|ShaderTypes::Min10UInt|ShaderTypes::Dim2|ShaderTypes::DimAx4),0u}},
-{(ShaderTypes::Vector|ShaderTypes::Min10UInt|ShaderTypes::Dim3),{"min10uint3",(ShaderTypes::Vector|ShaderTypes::Min10UInt|ShaderTypes::Dim3),0u}},
-{(ShaderTypes::Matrix|ShaderTypes::Min10UInt|ShaderTypes::Dim3|ShaderTypes::DimAx2),{"min10uint3x2",(ShaderTypes::Matrix|ShaderTypes::Min10UInt|ShaderTypes::Dim3|ShaderTypes::DimAx2),0u}},
-{(ShaderTypes::Matrix|ShaderTypes::Min10UInt|ShaderTypes::Dim3|ShaderTypes::DimAx3),{"min10uint3x3",(ShaderTypes::Matrix|ShaderTypes::Min10UInt|ShaderTypes::Dim3|ShaderTypes::DimAx3),0u}},
-{(ShaderTypes::Matrix|ShaderTypes::Min10UInt|ShaderTypes::Dim3|ShaderTypes::DimAx4),{"min10uint3x4",(ShaderTypes::Matrix|ShaderTypes::Min10UInt|ShaderTypes::Dim3|ShaderTypes::DimAx4),0u}},
-{(ShaderTypes::Vector|ShaderTypes::Min10UInt|ShaderTypes::Dim4),{"min10uint4",(ShaderTypes::Vector|ShaderTypes::Min10UInt|ShaderTypes::Dim4),0u}},
-{(ShaderTypes::Matrix|ShaderTypes::Min10UInt|ShaderTypes::Dim4|ShaderTypes::DimAx2),{"min10uint4x2",(ShaderTypes::Matrix|ShaderTypes::Min10UInt|ShaderTypes::Dim4|ShaderTypes::DimAx2),0u}},
-{(ShaderTypes::Matrix|ShaderTypes::Min10UInt|ShaderTypes::Dim4|ShaderTypes::DimAx3),{"min10uint4x3",(ShaderTypes::Matrix|ShaderTypes::Min10UInt|ShaderTypes::Dim4|ShaderTypes::DimAx3),0u}},
-{(ShaderTypes::Matrix|ShaderTypes::Min10UInt|ShaderTypes::Dim4|ShaderTypes::DimAx4),{"min10uint4x4",(ShaderTypes::Matrix|ShaderTypes::Min10UInt|ShaderTypes::Dim4|ShaderTypes::DimAx4),0u}},
-{(ShaderTypes::Scalar|ShaderTypes::Min16UInt),{"min16uint",(ShaderTypes::Scalar|ShaderTypes::Min16UInt),0u}},
-{(ShaderTypes::Vector|ShaderTypes::Min16UInt|ShaderTypes::Dim2),{"min16uint2",(ShaderTypes::Vector|ShaderTypes::Min16UInt|ShaderTypes::Dim2),0u}},
-{(ShaderTypes::Matrix|ShaderTypes::Min16UInt|ShaderTypes::Dim2|ShaderTypes::DimAx2),{"min16uint2x2",(ShaderTypes::Matrix|ShaderTypes::Min16UInt|ShaderTypes::Dim2|ShaderTypes::DimAx2),0u}},
-{(ShaderTypes::Matrix|ShaderTypes::Min16UInt|ShaderTypes::Dim2|ShaderTypes::DimAx3),{"min16uint2x3",(ShaderTypes::Matrix|ShaderTypes::Min16UInt|ShaderTypes::Dim2|ShaderTypes::DimAx3),0u}},
-{(ShaderTypes::Matrix|ShaderTypes::Min16UInt|ShaderTypes::Dim2|ShaderTypes::DimAx4),{"min16uint2x4",(ShaderTypes::Matrix|ShaderTypes::Min16UInt|ShaderTypes::Dim2|ShaderTypes::DimAx4),0u}},
-{(ShaderTypes::Vector|ShaderTypes::Min16UInt|ShaderTypes::Dim3),{"min16uint3",(ShaderTypes::Vector|ShaderTypes::Min16UInt|ShaderTypes::Dim3),0u}},
-{(ShaderTypes::Matrix|ShaderTypes::Min16UInt|ShaderTypes::Dim3|ShaderTypes::DimAx2),{"min16uint3x2",(ShaderTypes::Matrix|ShaderTypes::Min16UInt|ShaderTypes::Dim3|ShaderTypes::DimAx2),0u}},
-{(ShaderTypes::Matrix|ShaderTypes::Min16UInt|ShaderTypes::Dim3|ShaderTypes::DimAx3),{"min16uint3x3",(ShaderTypes::Matrix|ShaderTypes::Min16UInt|ShaderTypes::Dim3|ShaderTypes::DimAx3),0u}},
-{(ShaderTypes::Matrix|ShaderTypes::Min16UInt|ShaderTypes::Dim3|ShaderTypes::DimAx4),{"min16uint3x4",(ShaderTypes::Matrix|ShaderTypes::Min16UInt|ShaderTypes::Dim3|ShaderTypes::DimAx4),0u}},
-{(ShaderTypes::Vector|ShaderTypes::Min16UInt|ShaderTypes::Dim4),{"min16uint4",(ShaderTypes::Vector|ShaderTypes::Min16UInt|ShaderTypes::Dim4),0u}},
-{(ShaderTypes::Matrix|ShaderTypes::Min16UInt|ShaderTypes::Dim4|ShaderTypes::DimAx2),{"min16uint4x2",(ShaderTypes::Matrix|ShaderTypes::Min16UInt|ShaderTypes::Dim4|ShaderTypes::DimAx2),0u}},
-{(ShaderTypes::Matrix|ShaderTypes::Min16UInt|ShaderTypes::Dim4|ShaderTypes::DimAx3),{"min16uint4x3",(ShaderTypes::Matrix|ShaderTypes::Min16UInt|ShaderTypes::Dim4|ShaderTypes::DimAx3),0u}},
-{(ShaderTypes::Matrix|ShaderTypes::Min16UInt|ShaderTypes::Dim4|ShaderTypes::DimAx4),{"min16uint4x4",(ShaderTypes::Matrix|ShaderTypes::Min16UInt|ShaderTypes::Dim4|ShaderTypes::DimAx4),0u}},
-};
-static const std::unordered_map<string_view, ShaderTypes> s_ShaderTypeNameMap
-{
-{"void",ShaderTypes::Void},
-{"matrix",ShaderTypes::Matrix},
-{"Texture",ShaderTypes::Texture},
-{"Texture1D",ShaderTypes::Texture1D},
-{"Texture2D",ShaderTypes::Texture2D},
-{"Texture3D",ShaderTypes::Texture3D},
-{"Texture1DArray",ShaderTypes::Texture1DArray},
-{"Texture2DArray",ShaderTypes::Texture2DArray},
-{"TextureCube",ShaderTypes::TextureCube},
-{"TextureCubeArray",ShaderTypes::TextureCube},
-{"RWTexture",ShaderTypes::RwTexture},
-{"RWTexture1D",ShaderTypes::RWTexture1D},
-{"RWTexture2D",ShaderTypes::RWTexture2D},
-{"RWTexture1DArray",ShaderTypes::RwTexture1DArray},
-{"RWTexture2DArray",ShaderTypes::RwTexture2DArray},
-{"Buffer",ShaderTypes::Buffer},
-{"StructuredBuffer",ShaderTypes::StructuredBuffer},
-{"RWBuffer",ShaderTypes::RwBuffer},
-{"RWStructuredBuffer",ShaderTypes::RwStructuredBuffer},
-{"SamplerState",ShaderTypes::Sampler},
-{"bool",(ShaderTypes::Scalar|ShaderTypes::Bool)},
-{"bool2",(ShaderTypes::Vector|ShaderTypes::Bool|ShaderTypes::Dim2)},
-{"bool2x2",(ShaderTypes::Matrix|ShaderTypes::Bool|ShaderTypes::Dim2|ShaderTypes::DimAx2)},
-{"bool2x3",(ShaderTypes::Matrix|ShaderTypes::Bool|ShaderTypes::Dim2|ShaderTypes::DimAx3)},
-{"bool2x4",(ShaderTypes::Matrix|ShaderTypes::Bool|ShaderTypes::Dim2|ShaderTypes::DimAx4)},
-{"bool3",(ShaderTypes::Vector|ShaderTypes::Bool|ShaderTypes::Dim3)},
-{"bool3x2",(ShaderTypes::Matrix|ShaderTypes::Bool|ShaderTypes::Dim3|ShaderTypes::DimAx2)},
-{"bool3x3",(ShaderTypes::Matrix|ShaderTypes::Bool|ShaderTypes::Dim3|ShaderTypes::DimAx3)},
-{"bool3x4",(ShaderTypes::Matrix|ShaderTypes::Bool|ShaderTypes::Dim3|ShaderTypes::DimAx4)},
-{"bool4",(ShaderTypes::Vector|ShaderTypes::Bool|ShaderTypes::Dim4)},
-{"bool4x2",(ShaderTypes::Matrix|ShaderTypes::Bool|ShaderTypes::Dim4|ShaderTypes::DimAx2)},
-{"bool4x3",(ShaderTypes::Matrix|ShaderTypes::Bool|ShaderTypes::Dim4|ShaderTypes::DimAx3)},
-{"bool4x4",(ShaderTypes::Matrix|ShaderTypes::Bool|ShaderTypes::Dim4|ShaderTypes::DimAx4)},
-{"uint",(ShaderTypes::Scalar|ShaderTypes::UnsignedInt)},
-{"uint2",(ShaderTypes::Vector|ShaderTypes::UnsignedInt|ShaderTypes::Dim2)},
-{"uint2x2",(ShaderTypes::Matrix|ShaderTypes::UnsignedInt|ShaderTypes::Dim2|ShaderTypes::DimAx2)},
-{"uint2x3",(ShaderTypes::Matrix|ShaderTypes::UnsignedInt|ShaderTypes::Dim2|ShaderTypes::DimAx3)},
-{"uint2x4",(ShaderTypes::Matrix|ShaderTypes::UnsignedInt|ShaderTypes::Dim2|ShaderTypes::DimAx4)},
-{"uint3",(ShaderTypes::Vector|ShaderTypes::UnsignedInt|ShaderTypes::Dim3)},
-{"uint3x2",(ShaderTypes::Matrix|ShaderTypes::UnsignedInt|ShaderTypes::Dim3|ShaderTypes::DimAx2)},
-{"uint3x3",(ShaderTypes::Matrix|ShaderTypes::UnsignedInt|ShaderTypes::Dim3|ShaderTypes::DimAx3)},
-{"uint3x4",(ShaderTypes::Matrix|ShaderTypes::UnsignedInt|ShaderTypes::Dim3|ShaderTypes::DimAx4)},
-{"uint4",(ShaderTypes::Vector|ShaderTypes::UnsignedInt|ShaderTypes::Dim4)},
-{"uint4x2",(ShaderTypes::Matrix|ShaderTypes::UnsignedInt|ShaderTypes::Dim4|ShaderTypes::DimAx2)},
-{"uint4x3",(ShaderTypes::Matrix|ShaderTypes::UnsignedInt|ShaderTypes::Dim4|ShaderTypes::DimAx3)},
-{"uint4x4",(ShaderTypes::Matrix|ShaderTypes::UnsignedInt|ShaderTypes::Dim4|ShaderTypes::DimAx4)},
-{"int",(ShaderTypes::Scalar|ShaderTypes::Integer)},
-{"int2",(ShaderTypes::Vector|ShaderTypes::Integer|ShaderTypes::Dim2)},
-{"int2x2",(ShaderTypes::Matrix|ShaderTypes::Integer|ShaderTypes::Dim2|ShaderTypes::DimAx2)},
-{"int2x3",(ShaderTypes::Matrix|ShaderTypes::Integer|ShaderTypes::Dim2|ShaderTypes::DimAx3)},
-{"int2x4",(ShaderTypes::Matrix|ShaderTypes::Integer|ShaderTypes::Dim2|ShaderTypes::DimAx4)},
-{"int3",(ShaderTypes::Vector|ShaderTypes::Integer|ShaderTypes::Dim3)},
-{"int3x2",(ShaderTypes::Matrix|ShaderTypes::Integer|ShaderTypes::Dim3|ShaderTypes::DimAx2)},
-{"int3x3",(ShaderTypes::Matrix|ShaderTypes::Integer|ShaderTypes::Dim3|ShaderTypes::DimAx3)},
-{"int3x4",(ShaderTypes::Matrix|ShaderTypes::Integer|ShaderTypes::Dim3|ShaderTypes::DimAx4)},
-{"int4",(ShaderTypes::Vector|ShaderTypes::Integer|ShaderTypes::Dim4)},
-{"int4x2",(ShaderTypes::Matrix|ShaderTypes::Integer|ShaderTypes::Dim4|ShaderTypes::DimAx2)},
-{"int4x3",(ShaderTypes::Matrix|ShaderTypes::Integer|ShaderTypes::Dim4|ShaderTypes::DimAx3)},
-{"int4x4",(ShaderTypes::Matrix|ShaderTypes::Integer|ShaderTypes::Dim4|ShaderTypes::DimAx4)},
-{"float",(ShaderTypes::Scalar|ShaderTypes::Float)},
-{"float2",(ShaderTypes::Vector|ShaderTypes::Float|ShaderTypes::Dim2)},
-{"float2x2",(ShaderTypes::Matrix|ShaderTypes::Float|ShaderTypes::Dim2|ShaderTypes::DimAx2)},
-{"float2x3",(ShaderTypes::Matrix|ShaderTypes::Float|ShaderTypes::Dim2|ShaderTypes::DimAx3)},
-{"float2x4",(ShaderTypes::Matrix|ShaderTypes::Float|ShaderTypes::Dim2|ShaderTypes::DimAx4)},
-{"float3",(ShaderTypes::Vector|ShaderTypes::Float|ShaderTypes::Dim3)},
-{"float3x2",(ShaderTypes::Matrix|ShaderTypes::Float|ShaderTypes::Dim3|ShaderTypes::DimAx2)},
-{"float3x3",(ShaderTypes::Matrix|ShaderTypes::Float|ShaderTypes::Dim3|ShaderTypes::DimAx3)},
-{"float3x4",(ShaderTypes::Matrix|ShaderTypes::Float|ShaderTypes::Dim3|ShaderTypes::DimAx4)},
-{"float4",(ShaderTypes::Vector|ShaderTypes::Float|ShaderTypes::Dim4)},
-{"float4x2",(ShaderTypes::Matrix|ShaderTypes::Float|ShaderTypes::Dim4|ShaderTypes::DimAx2)},
-{"float4x3",(ShaderTypes::Matrix|ShaderTypes::Float|ShaderTypes::Dim4|ShaderTypes::DimAx3)},
-{"float4x4",(ShaderTypes::Matrix|ShaderTypes::Float|ShaderTypes::Dim4|ShaderTypes::DimAx4)},
-{"double",(ShaderTypes::Scalar|ShaderTypes::Double)},
-{"double2",(ShaderTypes::Vector|ShaderTypes::Double|ShaderTypes::Dim2)},
-{"double2x2",(ShaderTypes::Matrix|ShaderTypes::Double|ShaderTypes::Dim2|ShaderTypes::DimAx2)},
-{"double2x3",(ShaderTypes::Matrix|ShaderTypes::Double|ShaderTypes::Dim2|ShaderTypes::DimAx3)},
-{"double2x4",(ShaderTypes::Matrix|ShaderTypes::Double|ShaderTypes::Dim2|ShaderTypes::DimAx4)},
-{"double3",(ShaderTypes::Vector|ShaderTypes::Double|ShaderTypes::Dim3)},
-{"double3x2",(ShaderTypes::Matrix|ShaderTypes::Double|ShaderTypes::Dim3|ShaderTypes::DimAx2)},
-{"double3x3",(ShaderTypes::Matrix|ShaderTypes::Double|ShaderTypes::Dim3|ShaderTypes::DimAx3)},
-{"double3x4",(ShaderTypes::Matrix|ShaderTypes::Double|ShaderTypes::Dim3|ShaderTypes::DimAx4)},
-{"double4",(ShaderTypes::Vector|ShaderTypes::Double|ShaderTypes::Dim4)},
-{"double4x2",(ShaderTypes::Matrix|ShaderTypes::Double|ShaderTypes::Dim4|ShaderTypes::DimAx2)},
-{"double4x3",(ShaderTypes::Matrix|ShaderTypes::Double|ShaderTypes::Dim4|ShaderTypes::DimAx3)},
-{"double4x4",(ShaderTypes::Matrix|ShaderTypes::Double|ShaderTypes::Dim4|ShaderTypes::DimAx4)},
-{"half",(ShaderTypes::Scalar|ShaderTypes::HalfFloat)},
-{"half2",(ShaderTypes::Vector|ShaderTypes::HalfFloat|ShaderTypes::Dim2)},
-{"half2x2",(ShaderTypes::Matrix|ShaderTypes::HalfFloat|ShaderTypes::Dim2|ShaderTypes::DimAx2)},
-{"half2x3",(ShaderTypes::Matrix|ShaderTypes::HalfFloat|ShaderTypes::Dim2|ShaderTypes::DimAx3)},
-{"half2x4",(ShaderTypes::Matrix|ShaderTypes::HalfFloat|ShaderTypes::Dim2|ShaderTypes::DimAx4)},
-{"half3",(ShaderTypes::Vector|ShaderTypes::HalfFloat|ShaderTypes::Dim3)},
-{"half3x2",(ShaderTypes::Matrix|ShaderTypes::HalfFloat|ShaderTypes::Dim3|ShaderTypes::DimAx2)},
-{"half3x3",(ShaderTypes::Matrix|ShaderTypes::HalfFloat|ShaderTypes::Dim3|ShaderTypes::DimAx3)},
-{"half3x4",(ShaderTypes::Matrix|ShaderTypes::HalfFloat|ShaderTypes::Dim3|ShaderTypes::DimAx4)},
-{"half4",(ShaderTypes::Vector|ShaderTypes::HalfFloat|ShaderTypes::Dim4)},
-{"half4x2",(ShaderTypes::Matrix|ShaderTypes::HalfFloat|ShaderTypes::Dim4|ShaderTypes::DimAx2)},
-{"half4x3",(ShaderTypes::Matrix|ShaderTypes::HalfFloat|ShaderTypes::Dim4|ShaderTypes::DimAx3)},
-{"half4x4",(ShaderTypes::Matrix|ShaderTypes::HalfFloat|ShaderTypes::Dim4|ShaderTypes::DimAx4)},
-{"min10float",(ShaderTypes::Scalar|ShaderTypes::Min10Float)},
-{"min10float2",(ShaderTypes::Vector|ShaderTypes::Min10Float|ShaderTypes::Dim2)},
-{"min10float2x2",(ShaderTypes::Matrix|ShaderTypes::Min10Float|ShaderTypes::Dim2|ShaderTypes::DimAx2)},
-{"min10float2x3",(ShaderTypes::Matrix|ShaderTypes::Min10Float|ShaderTypes::Dim2|ShaderTypes::DimAx3)},
-{"min10float2x4",(ShaderTypes::Matrix|ShaderTypes::Min10Float|ShaderTypes::Dim2|ShaderTypes::DimAx4)},
-{"min10float3",(ShaderTypes::Vector|ShaderTypes::Min10Float|ShaderTypes::Dim3)},
-{"min10float3x2",(ShaderTypes::Matrix|ShaderTypes::Min10Float|ShaderTypes::Dim3|ShaderTypes::DimAx2)},
-{"min10float3x3",(ShaderTypes::Matrix|ShaderTypes::Min10Float|ShaderTypes::Dim3|ShaderTypes::DimAx3)},
-{"min10float3x4",(ShaderTypes::Matrix|ShaderTypes::Min10Float|ShaderTypes::Dim3|ShaderTypes::DimAx4)},
-{"min10float4",(ShaderTypes::Vector|ShaderTypes::Min10Float|ShaderTypes::Dim4)},
-{"min10float4x2",(ShaderTypes::Matrix|ShaderTypes::Min10Float|ShaderTypes::Dim4|ShaderTypes::DimAx2)},
-{"min10float4x3",(ShaderTypes::Matrix|ShaderTypes::Min10Float|ShaderTypes::Dim4|ShaderTypes::DimAx3)},
-{"min10float4x4",(ShaderTypes::Matrix|ShaderTypes::Min10Float|ShaderTypes::Dim4|ShaderTypes::DimAx4)},
-{"min16float",(ShaderTypes::Scalar|ShaderTypes::Min16Float)},
-{"min16float2",(ShaderTypes::Vector|ShaderTypes::Min16Float|ShaderTypes::Dim2)},
-{"min16float2x2",(ShaderTypes::Matrix|ShaderTypes::Min16Float|ShaderTypes::Dim2|ShaderTypes::DimAx2)},
-{"min16float2x3",(ShaderTypes::Matrix|ShaderTypes::Min16Float|ShaderTypes::Dim2|ShaderTypes::DimAx3)},
-{"min16float2x4",(ShaderTypes::Matrix|ShaderTypes::Min16Float|ShaderTypes::Dim2|ShaderTypes::DimAx4)},
-{"min16float3",(ShaderTypes::Vector|ShaderTypes::Min16Float|ShaderTypes::Dim3)},
-{"min16float3x2",(ShaderTypes::Matrix|ShaderTypes::Min16Float|ShaderTypes::Dim3|ShaderTypes::DimAx2)},
-{"min16float3x3",(ShaderTypes::Matrix|ShaderTypes::Min16Float|ShaderTypes::Dim3|ShaderTypes::DimAx3)},
-{"min16float3x4",(ShaderTypes::Matrix|ShaderTypes::Min16Float|ShaderTypes::Dim3|ShaderTypes::DimAx4)},
-{"min16float4",(ShaderTypes::Vector|ShaderTypes::Min16Float|ShaderTypes::Dim4)},
-{"min16float4x2",(ShaderTypes::Matrix|ShaderTypes::Min16Float|ShaderTypes::Dim4|ShaderTypes::DimAx2)},
-{"min16float4x3",(ShaderTypes::Matrix|ShaderTypes::Min16Float|ShaderTypes::Dim4|ShaderTypes::DimAx3)},
-{"min16float4x4",(ShaderTypes::Matrix|ShaderTypes::Min16Float|ShaderTypes::Dim4|ShaderTypes::DimAx4)},
-{"min10int",(ShaderTypes::Scalar|ShaderTypes::Min10Int)},
-{"min10int2",(ShaderTypes::Vector|ShaderTypes::Min10Int|ShaderTypes::Dim2)},
-{"min10int2x2",(ShaderTypes::Matrix|ShaderTypes::Min10Int|ShaderTypes::Dim2|ShaderTypes::DimAx2)},
-{"min10int2x3",(ShaderTypes::Matrix|ShaderTypes::Min10Int|ShaderTypes::Dim2|ShaderTypes::DimAx3)},
-{"min10int2x4",(ShaderTypes::Matrix|ShaderTypes::Min10Int|ShaderTypes::Dim2|ShaderTypes::DimAx4)},
-{"min10int3",(ShaderTypes::Vector|ShaderTypes::Min10Int|ShaderTypes::Dim3)},
-{"min10int3x2",(ShaderTypes::Matrix|ShaderTypes::Min10Int|ShaderTypes::Dim3|ShaderTypes::DimAx2)},
-{"min10int3x3",(ShaderTypes::Matrix|ShaderTypes::Min10Int|ShaderTypes::Dim3|ShaderTypes::DimAx3)},
-{"min10int3x4",(ShaderTypes::Matrix|ShaderTypes::Min10Int|ShaderTypes::Dim3|ShaderTypes::DimAx4)},
-{"min10int4",(ShaderTypes::Vector|ShaderTypes::Min10Int|ShaderTypes::Dim4)},
-{"min10int4x2",(ShaderTypes::Matrix|ShaderTypes::Min10Int|ShaderTypes::Dim4|ShaderTypes::DimAx2)},
-{"min10int4x3",(ShaderTypes::Matrix|ShaderTypes::Min10Int|ShaderTypes::Dim4|ShaderTypes::DimAx3)},
-{"min10int4x4",(ShaderTypes::Matrix|ShaderTypes::Min10Int|ShaderTypes::Dim4|ShaderTypes::DimAx4)},
-{"min16int",(ShaderTypes::Scalar|ShaderTypes::Min16Int)},
-{"min16int2",(ShaderTypes::Vector|ShaderTypes::Min16Int|ShaderTypes::Dim2)},
-{"min16int2x2",(ShaderTypes::Matrix|ShaderTypes::Min16Int|ShaderTypes::Dim2|ShaderTypes::DimAx2)},
-{"min16int2x3",(ShaderTypes::Matrix|ShaderTypes::Min16Int|ShaderTypes::Dim2|ShaderTypes::DimAx3)},
-{"min16int2x4",(ShaderTypes::Matrix|ShaderTypes::Min16Int|ShaderTypes::Dim2|ShaderTypes::DimAx4)},
-{"min16int3",(ShaderTypes::Vector|ShaderTypes::Min16Int|ShaderTypes::Dim3)},
-{"min16int3x2",(ShaderTypes::Matrix|ShaderTypes::Min16Int|ShaderTypes::Dim3|ShaderTypes::DimAx2)},
-{"min16int3x3",(ShaderTypes::Matrix|ShaderTypes::Min16Int|ShaderTypes::Dim3|ShaderTypes::DimAx3)},
-{"min16int3x4",(ShaderTypes::Matrix|ShaderTypes::Min16Int|ShaderTypes::Dim3|ShaderTypes::DimAx4)},
-{"min16int4",(ShaderTypes::Vector|ShaderTypes::Min16Int|ShaderTypes::Dim4)},
-{"min16int4x2",(ShaderTypes::Matrix|ShaderTypes::Min16Int|ShaderTypes::Dim4|ShaderTypes::DimAx2)},
-{"min16int4x3",(ShaderTypes::Matrix|ShaderTypes::Min16Int|ShaderTypes::Dim4|ShaderTypes::DimAx3)},
-{"min16int4x4",(ShaderTypes::Matrix|ShaderTypes::Min16Int|ShaderTypes::Dim4|ShaderTypes::DimAx4)},
-{"min10uint",(ShaderTypes::Scalar|ShaderTypes::Min10UInt)},
-{"min10uint2",(ShaderTypes::Vector|ShaderTypes::Min10UInt|ShaderTypes::Dim2)},
-{"min10uint2x2",(ShaderTypes::Matrix|ShaderTypes::Min10UInt|ShaderTypes::Dim2|ShaderTypes::DimAx2)},
-{"min10uint2x3",(ShaderTypes::Matrix|ShaderTypes::Min10UInt|ShaderTypes::Dim2|ShaderTypes::DimAx3)},
-{"min10uint2x4",(ShaderTypes::Matrix|ShaderTypes::Min10UInt|ShaderTypes::Dim2|ShaderTypes::DimAx4)},
-{"min10uint3",(ShaderTypes::Vector|ShaderTypes::Min10UInt|ShaderTypes::Dim3)},
-{"min10uint3x2",(ShaderTypes::Matrix|ShaderTypes::Min10UInt|ShaderTypes::Dim3|ShaderTypes::DimAx2)},
-{"min10uint3x3",(ShaderTypes::Matrix|ShaderTypes::Min10UInt|ShaderTypes::Dim3|ShaderTypes::DimAx3)},
-{"min10uint3x4",(ShaderTypes::Matrix|ShaderTypes::Min10UInt|ShaderTypes::Dim3|ShaderTypes::DimAx4)},
-{"min10uint4",(ShaderTypes::Vector|ShaderTypes::Min10UInt|ShaderTypes::Dim4)},
-{"min10uint4x2",(ShaderTypes::Matrix|ShaderTypes::Min10UInt|ShaderTypes::Dim4|ShaderTypes::DimAx2)},
-{"min10uint4x3",(ShaderTypes::Matrix|ShaderTypes::Min10UInt|ShaderTypes::Dim4|ShaderTypes::DimAx3)},
-{"min10uint4x4",(ShaderTypes::Matrix|ShaderTypes::Min10UInt|ShaderTypes::Dim4|ShaderTypes::DimAx4)},
-{"min16uint",(ShaderTypes::Scalar|ShaderTypes::Min16UInt)},
-{"min16uint2",(ShaderTypes::Vector|ShaderTypes::Min16UInt|ShaderTypes::Dim2)},
-{"min16uint2x2",(ShaderTypes::Matrix|ShaderTypes::Min16UInt|ShaderTypes::Dim2|ShaderTypes::DimAx2)},
-{"min16uint2x3",(ShaderTypes::Matrix|ShaderTypes::Min16UInt|ShaderTypes::Dim2|ShaderTypes::DimAx3)},
-{"min16uint2x4",(ShaderTypes::Matrix|ShaderTypes::Min16UInt|ShaderTypes::Dim2|ShaderTypes::DimAx4)},
-{"min16uint3",(ShaderTypes::Vector|ShaderTypes::Min16UInt|ShaderTypes::Dim3)},
-{"min16uint3x2",(ShaderTypes::Matrix|ShaderTypes::Min16UInt|ShaderTypes::Dim3|ShaderTypes::DimAx2)},
-{"min16uint3x3",(ShaderTypes::Matrix|ShaderTypes::Min16UInt|ShaderTypes::Dim3|ShaderTypes::DimAx3)},
-{"min16uint3x4",(ShaderTypes::Matrix|ShaderTypes::Min16UInt|ShaderTypes::Dim3|ShaderTypes::DimAx4)},
-{"min16uint4",(ShaderTypes::Vector|ShaderTypes::Min16UInt|ShaderTypes::Dim4)},
-{"min16uint4x2",(ShaderTypes::Matrix|ShaderTypes::Min16UInt|ShaderTypes::Dim4|ShaderTypes::DimAx2)},
-{"min16uint4x3",(ShaderTypes::Matrix|ShaderTypes::Min16UInt|ShaderTypes::Dim4|ShaderTypes::DimAx3)},
-{"min16uint4x4",(ShaderTypes::Matrix|ShaderTypes::Min16UInt|ShaderTypes::Dim4|ShaderTypes::DimAx4)},
+{"half",(ShaderTypes::Scalar|ShaderTypes::HalfFloat),0u},
+{"half2",(ShaderTypes::Vector|ShaderTypes::HalfFloat|ShaderTypes::Dim2),0u},
+{"half2x2",(ShaderTypes::Matrix|ShaderTypes::HalfFloat|ShaderTypes::Dim2|ShaderTypes::DimAx2),0u},
+{"half2x3",(ShaderTypes::Matrix|ShaderTypes::HalfFloat|ShaderTypes::Dim2|ShaderTypes::DimAx3),0u},
+{"half2x4",(ShaderTypes::Matrix|ShaderTypes::HalfFloat|ShaderTypes::Dim2|ShaderTypes::DimAx4),0u},
+{"half3",(ShaderTypes::Vector|ShaderTypes::HalfFloat|ShaderTypes::Dim3),0u},
+{"half3x2",(ShaderTypes::Matrix|ShaderTypes::HalfFloat|ShaderTypes::Dim3|ShaderTypes::DimAx2),0u},
+{"half3x3",(ShaderTypes::Matrix|ShaderTypes::HalfFloat|ShaderTypes::Dim3|ShaderTypes::DimAx3),0u},
+{"half3x4",(ShaderTypes::Matrix|ShaderTypes::HalfFloat|ShaderTypes::Dim3|ShaderTypes::DimAx4),0u},
+{"half4",(ShaderTypes::Vector|ShaderTypes::HalfFloat|ShaderTypes::Dim4),0u},
+{"half4x2",(ShaderTypes::Matrix|ShaderTypes::HalfFloat|ShaderTypes::Dim4|ShaderTypes::DimAx2),0u},
+{"half4x3",(ShaderTypes::Matrix|ShaderTypes::HalfFloat|ShaderTypes::Dim4|ShaderTypes::DimAx3),0u},
+{"half4x4",(ShaderTypes::Matrix|ShaderTypes::HalfFloat|ShaderTypes::Dim4|ShaderTypes::DimAx4),0u},
+{"min10float",(ShaderTypes::Scalar|ShaderTypes::Min10Float),0u},
+{"min10float2",(ShaderTypes::Vector|ShaderTypes::Min10Float|ShaderTypes::Dim2),0u},
+{"min10float2x2",(ShaderTypes::Matrix|ShaderTypes::Min10Float|ShaderTypes::Dim2|ShaderTypes::DimAx2),0u},
+{"min10float2x3",(ShaderTypes::Matrix|ShaderTypes::Min10Float|ShaderTypes::Dim2|ShaderTypes::DimAx3),0u},
+{"min10float2x4",(ShaderTypes::Matrix|ShaderTypes::Min10Float|ShaderTypes::Dim2|ShaderTypes::DimAx4),0u},
+{"min10float3",(ShaderTypes::Vector|ShaderTypes::Min10Float|ShaderTypes::Dim3),0u},
+{"min10float3x2",(ShaderTypes::Matrix|ShaderTypes::Min10Float|ShaderTypes::Dim3|ShaderTypes::DimAx2),0u},
+{"min10float3x3",(ShaderTypes::Matrix|ShaderTypes::Min10Float|ShaderTypes::Dim3|ShaderTypes::DimAx3),0u},
+{"min10float3x4",(ShaderTypes::Matrix|ShaderTypes::Min10Float|ShaderTypes::Dim3|ShaderTypes::DimAx4),0u},
+{"min10float4",(ShaderTypes::Vector|ShaderTypes::Min10Float|ShaderTypes::Dim4),0u},
+{"min10float4x2",(ShaderTypes::Matrix|ShaderTypes::Min10Float|ShaderTypes::Dim4|ShaderTypes::DimAx2),0u},
+{"min10float4x3",(ShaderTypes::Matrix|ShaderTypes::Min10Float|ShaderTypes::Dim4|ShaderTypes::DimAx3),0u},
+{"min10float4x4",(ShaderTypes::Matrix|ShaderTypes::Min10Float|ShaderTypes::Dim4|ShaderTypes::DimAx4),0u},
+{"min16float",(ShaderTypes::Scalar|ShaderTypes::Min16Float),0u},
+{"min16float2",(ShaderTypes::Vector|ShaderTypes::Min16Float|ShaderTypes::Dim2),0u},
+{"min16float2x2",(ShaderTypes::Matrix|ShaderTypes::Min16Float|ShaderTypes::Dim2|ShaderTypes::DimAx2),0u},
+{"min16float2x3",(ShaderTypes::Matrix|ShaderTypes::Min16Float|ShaderTypes::Dim2|ShaderTypes::DimAx3),0u},
+{"min16float2x4",(ShaderTypes::Matrix|ShaderTypes::Min16Float|ShaderTypes::Dim2|ShaderTypes::DimAx4),0u},
+{"min16float3",(ShaderTypes::Vector|ShaderTypes::Min16Float|ShaderTypes::Dim3),0u},
+{"min16float3x2",(ShaderTypes::Matrix|ShaderTypes::Min16Float|ShaderTypes::Dim3|ShaderTypes::DimAx2),0u},
+{"min16float3x3",(ShaderTypes::Matrix|ShaderTypes::Min16Float|ShaderTypes::Dim3|ShaderTypes::DimAx3),0u},
+{"min16float3x4",(ShaderTypes::Matrix|ShaderTypes::Min16Float|ShaderTypes::Dim3|ShaderTypes::DimAx4),0u},
+{"min16float4",(ShaderTypes::Vector|ShaderTypes::Min16Float|ShaderTypes::Dim4),0u},
+{"min16float4x2",(ShaderTypes::Matrix|ShaderTypes::Min16Float|ShaderTypes::Dim4|ShaderTypes::DimAx2),0u},
+{"min16float4x3",(ShaderTypes::Matrix|ShaderTypes::Min16Float|ShaderTypes::Dim4|ShaderTypes::DimAx3),0u},
+{"min16float4x4",(ShaderTypes::Matrix|ShaderTypes::Min16Float|ShaderTypes::Dim4|ShaderTypes::DimAx4),0u},
+{"min10int",(ShaderTypes::Scalar|ShaderTypes::Min10Int),0u},
+{"min10int2",(ShaderTypes::Vector|ShaderTypes::Min10Int|ShaderTypes::Dim2),0u},
+{"min10int2x2",(ShaderTypes::Matrix|ShaderTypes::Min10Int|ShaderTypes::Dim2|ShaderTypes::DimAx2),0u},
+{"min10int2x3",(ShaderTypes::Matrix|ShaderTypes::Min10Int|ShaderTypes::Dim2|ShaderTypes::DimAx3),0u},
+{"min10int2x4",(ShaderTypes::Matrix|ShaderTypes::Min10Int|ShaderTypes::Dim2|ShaderTypes::DimAx4),0u},
+{"min10int3",(ShaderTypes::Vector|ShaderTypes::Min10Int|ShaderTypes::Dim3),0u},
+{"min10int3x2",(ShaderTypes::Matrix|ShaderTypes::Min10Int|ShaderTypes::Dim3|ShaderTypes::DimAx2),0u},
+{"min10int3x3",(ShaderTypes::Matrix|ShaderTypes::Min10Int|ShaderTypes::Dim3|ShaderTypes::DimAx3),0u},
+{"min10int3x4",(ShaderTypes::Matrix|ShaderTypes::Min10Int|ShaderTypes::Dim3|ShaderTypes::DimAx4),0u},
+{"min10int4",(ShaderTypes::Vector|ShaderTypes::Min10Int|ShaderTypes::Dim4),0u},
+{"min10int4x2",(ShaderTypes::Matrix|ShaderTypes::Min10Int|ShaderTypes::Dim4|ShaderTypes::DimAx2),0u},
+{"min10int4x3",(ShaderTypes::Matrix|ShaderTypes::Min10Int|ShaderTypes::Dim4|ShaderTypes::DimAx3),0u},
+{"min10int4x4",(ShaderTypes::Matrix|ShaderTypes::Min10Int|ShaderTypes::Dim4|ShaderTypes::DimAx4),0u},
+{"min16int",(ShaderTypes::Scalar|ShaderTypes::Min16Int),0u},
+{"min16int2",(ShaderTypes::Vector|ShaderTypes::Min16Int|ShaderTypes::Dim2),0u},
+{"min16int2x2",(ShaderTypes::Matrix|ShaderTypes::Min16Int|ShaderTypes::Dim2|ShaderTypes::DimAx2),0u},
+{"min16int2x3",(ShaderTypes::Matrix|ShaderTypes::Min16Int|ShaderTypes::Dim2|ShaderTypes::DimAx3),0u},
+{"min16int2x4",(ShaderTypes::Matrix|ShaderTypes::Min16Int|ShaderTypes::Dim2|ShaderTypes::DimAx4),0u},
+{"min16int3",(ShaderTypes::Vector|ShaderTypes::Min16Int|ShaderTypes::Dim3),0u},
+{"min16int3x2",(ShaderTypes::Matrix|ShaderTypes::Min16Int|ShaderTypes::Dim3|ShaderTypes::DimAx2),0u},
+{"min16int3x3",(ShaderTypes::Matrix|ShaderTypes::Min16Int|ShaderTypes::Dim3|ShaderTypes::DimAx3),0u},
+{"min16int3x4",(ShaderTypes::Matrix|ShaderTypes::Min16Int|ShaderTypes::Dim3|ShaderTypes::DimAx4),0u},
+{"min16int4",(ShaderTypes::Vector|ShaderTypes::Min16Int|ShaderTypes::Dim4),0u},
+{"min16int4x2",(ShaderTypes::Matrix|ShaderTypes::Min16Int|ShaderTypes::Dim4|ShaderTypes::DimAx2),0u},
+{"min16int4x3",(ShaderTypes::Matrix|ShaderTypes::Min16Int|ShaderTypes::Dim4|ShaderTypes::DimAx3),0u},
+{"min16int4x4",(ShaderTypes::Matrix|ShaderTypes::Min16Int|ShaderTypes::Dim4|ShaderTypes::DimAx4),0u},
+{"min10uint",(ShaderTypes::Scalar|ShaderTypes::Min10UInt),0u},
+{"min10uint2",(ShaderTypes::Vector|ShaderTypes::Min10UInt|ShaderTypes::Dim2),0u},
+{"min10uint2x2",(ShaderTypes::Matrix|ShaderTypes::Min10UInt|ShaderTypes::Dim2|ShaderTypes::DimAx2),0u},
+{"min10uint2x3",(ShaderTypes::Matrix|ShaderTypes::Min10UInt|ShaderTypes::Dim2|ShaderTypes::DimAx3),0u},
+{"min10uint2x4",(ShaderTypes::Matrix|ShaderTypes::Min10UInt|ShaderTypes::Dim2|ShaderTypes::DimAx4),0u},
+{"min10uint3",(ShaderTypes::Vector|ShaderTypes::Min10UInt|ShaderTypes::Dim3),0u},
+{"min10uint3x2",(ShaderTypes::Matrix|ShaderTypes::Min10UInt|ShaderTypes::Dim3|ShaderTypes::DimAx2),0u},
+{"min10uint3x3",(ShaderTypes::Matrix|ShaderTypes::Min10UInt|ShaderTypes::Dim3|ShaderTypes::DimAx3),0u},
+{"min10uint3x4",(ShaderTypes::Matrix|ShaderTypes::Min10UInt|ShaderTypes::Dim3|ShaderTypes::DimAx4),0u},
+{"min10uint4",(ShaderTypes::Vector|ShaderTypes::Min10UInt|ShaderTypes::Dim4),0u},
+{"min10uint4x2",(ShaderTypes::Matrix|ShaderTypes::Min10UInt|ShaderTypes::Dim4|ShaderTypes::DimAx2),0u},
+{"min10uint4x3",(ShaderTypes::Matrix|ShaderTypes::Min10UInt|ShaderTypes::Dim4|ShaderTypes::DimAx3),0u},
+{"min10uint4x4",(ShaderTypes::Matrix|ShaderTypes::Min10UInt|ShaderTypes::Dim4|ShaderTypes::DimAx4),0u},
+{"min16uint",(ShaderTypes::Scalar|ShaderTypes::Min16UInt),0u},
+{"min16uint2",(ShaderTypes::Vector|ShaderTypes::Min16UInt|ShaderTypes::Dim2),0u},
+{"min16uint2x2",(ShaderTypes::Matrix|ShaderTypes::Min16UInt|ShaderTypes::Dim2|ShaderTypes::DimAx2),0u},
+{"min16uint2x3",(ShaderTypes::Matrix|ShaderTypes::Min16UInt|ShaderTypes::Dim2|ShaderTypes::DimAx3),0u},
+{"min16uint2x4",(ShaderTypes::Matrix|ShaderTypes::Min16UInt|ShaderTypes::Dim2|ShaderTypes::DimAx4),0u},
+{"min16uint3",(ShaderTypes::Vector|ShaderTypes::Min16UInt|ShaderTypes::Dim3),0u},
+{"min16uint3x2",(ShaderTypes::Matrix|ShaderTypes::Min16UInt|ShaderTypes::Dim3|ShaderTypes::DimAx2),0u},
+{"min16uint3x3",(ShaderTypes::Matrix|ShaderTypes::Min16UInt|ShaderTypes::Dim3|ShaderTypes::DimAx3),0u},
+{"min16uint3x4",(ShaderTypes::Matrix|ShaderTypes::Min16UInt|ShaderTypes::Dim3|ShaderTypes::DimAx4),0u},
+{"min16uint4",(ShaderTypes::Vector|ShaderTypes::Min16UInt|ShaderTypes::Dim4),0u},
+{"min16uint4x2",(ShaderTypes::Matrix|ShaderTypes::Min16UInt|ShaderTypes::Dim4|ShaderTypes::DimAx2),0u},
+{"min16uint4x3",(ShaderTypes::Matrix|ShaderTypes::Min16UInt|ShaderTypes::Dim4|ShaderTypes::DimAx3),0u},
+{"min16uint4x4",(ShaderTypes::Matrix|ShaderTypes::Min16UInt|ShaderTypes::Dim4|ShaderTypes::DimAx4),0u},
 };
 
+// Types by name and by flags. Types sharing flags resolve to the first declared.
+static constexpr ConstPerfectHash s_ShaderTypeNameTable(s_ShaderTypes, [](const ShaderTypeInfo& type) { return GetConstKeyHash(type.name); });
+static constexpr ConstPerfectHash s_ShaderTypeFlagTable(s_ShaderTypes, [](const ShaderTypeInfo& type) { return (ulong)type.flags; });
+
 const ShaderTypeInfo* TryGetShaderTypeInfo(ShaderTypes flags)
 {
-	const auto& pair = s_ShaderTypeMap.find(flags);
+	const int index = s_ShaderTypeFlagTable.TryGetIndex((ulong)flags);
 
-	if (pair != s_ShaderTypeMap.end())
+	if (index != -1 && s_ShaderTypes[index].flags == flags)
 	{
-		return &pair->second;
+		return &s_ShaderTypes[index];
 	}
 	else
 		return nullptr;
@@ -384,11 +208,11 @@ const ShaderTypeInfo* TryGetShaderTypeInfo(ShaderTypes flags)
 
 bool TryGetShaderType(string_view name, ShaderTypes& type)
 {
-	const auto& pair = s_ShaderTypeNameMap.find(name);
+	const int index = s_ShaderTypeNameTable.TryGetIndex(GetConstKeyHash(name));
 
-	if (pair != s_ShaderTypeNameMap.end())
+	if (index != -1 && s_ShaderTypes[index].name == name)
 	{
-		type |= pair->second;
+		type |= s_ShaderTypes[index].flags;
 		return true;
 	}
 	else
@@ -1,16 +1,40 @@
 #include "pch.hpp"
 #include <array>
-#include <unordered_map>
+#include "WeaveUtils/PerfectHash.hpp"
 #include "WeaveEffects/ShaderLibBuilder/ShaderParser/SymbolEnums.hpp"
 
 namespace Weave::Effects
 {
-    static const std::unordered_map<std::string_view, TokenTypes> s_KeywordToTypeMap
+    template<typename T>
+    struct KeywordEntry
+    {
+        string_view name;
+        T value;
+    };
+
+    template<typename T>
+    static constexpr ulong GetKeywordHash(const KeywordEntry<T>& entry) { return GetConstKeyHash(entry.name); }
+
+    /// <summary>
+    /// Looks up a keyword by name in a compile-time perfect hash over the given entries
+    /// </summary>
+    template<typename T, size_t N>
+    static const KeywordEntry<T>* TryGetKeyword(const KeywordEntry<T>(&entries)[N], const ConstPerfectHash<N>& table, string_view name)
+    {
+        const int index = table.TryGetIndex(GetConstKeyHash(name));
+
+        if (index != -1 && entries[index].name == name)
+            return &entries[index];
+        else
+            return nullptr;
+    }
+
+    static constexpr KeywordEntry<TokenTypes> s_KeywordTypes[]
     {
         { "technique", TokenTypes::TechniqueDecl },
         { "effect", TokenTypes::TechniqueDecl },
         { "pass", TokenTypes::PassDecl },
-        { "cbuffer", TokenTypes::ConstBufDecl, },
+        { "cbuffer", TokenTypes::ConstBufDecl },
 
         { "vertex", TokenTypes::VertexShaderDecl },
         { "hull", TokenTypes::HullShaderDecl },
@@ -33,6 +57,8 @@ namespace Weave::Effects
         { "groupshared", TokenTypes::GroupShared }
     };
 
+    static constexpr ConstPerfectHash s_KeywordTypeTable(s_KeywordTypes, GetKeywordHash<TokenTypes>);
+
     bool TryGetShaderKeyword(std::string_view name, TokenTypes& type)
     {
         if (name.length() > 20)
@@ -44,18 +70,18 @@ namespace Weave::Effects
             cpyBuf[i] = std::tolower(name[i]);
 
         string_view nameCpy((char*)&cpyBuf, name.length());
-        auto keywordTypePair = s_KeywordToTypeMap.find(nameCpy);
+        const KeywordEntry<TokenTypes>* pKeyword = TryGetKeyword(s_KeywordTypes, s_KeywordTypeTable, nameCpy);
 
-        if (keywordTypePair != s_KeywordToTypeMap.end())
+        if (pKeyword != nullptr)
         {
-            type |= keywordTypePair->second;
+            type |= pKeyword->value;
             return true;
         }
         else
             return false;
     }
 
-    const std::unordered_map<string_view, ShadeStages> s_StageNameMap
+    static constexpr KeywordEntry<ShadeStages> s_StageNames[]
     {
         { "vertex", ShadeStages::Vertex },
         { "hull", ShadeStages::Hull },
@@ -68,6 +94,8 @@ namespace Weave::Effects
         { "kernel", ShadeStages::Compute }
     };
 
+    static constexpr ConstPerfectHash s_StageNameTable(s_StageNames, GetKeywordHash<ShadeStages>);
+
     bool TryGetShadeStage(string_view name, ShadeStages& stage)
     {
         if (name.length() > 20)
@@ -79,11 +107,11 @@ namespace Weave::Effects
             cpyBuf[i] = std::tolower(name[i]);
 
         string_view nameCpy((char*)&cpyBuf, name.length());
-        auto keywordTypePair = s_StageNameMap.find(nameCpy);
+        const KeywordEntry<ShadeStages>* pKeyword = TryGetKeyword(s_StageNames, s_StageNameTable, nameCpy);
 
-        if (keywordTypePair != s_StageNameMap.end())
+        if (pKeyword != nullptr)
         {
-            stage = keywordTypePair->second;
+            stage = pKeyword->value;
             return true;
         }
         else
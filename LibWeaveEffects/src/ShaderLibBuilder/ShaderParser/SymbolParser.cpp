@@ -8,6 +8,12 @@ namespace Weave::Effects
 {
     const string g_WordBreakFilter = "=,:;[]";
 
+    // Cached matches are discarded once this many accumulate
+    static constexpr int s_MaxMatchCacheEntries = 1 << 14;
+    // Maximum number of cached matches checked for a given start flags and block type. Older 
+    // entries are dropped from the chain when it's full.
+    static constexpr int s_MaxMatchCacheChain = 16;
+
     struct MatchState
     {
         // Match src bounds
@@ -37,7 +43,9 @@ namespace Weave::Effects
 
     SymbolParser::SymbolParser() :
         pSB(nullptr),
-        pAnalyzer(nullptr)
+        pAnalyzer(nullptr),
+        readStart(0),
+        readEnd(0)
     { }
 
     SymbolParser::~SymbolParser() = default;
@@ -102,14 +110,170 @@ namespace Weave::Effects
         }
     }
 
+    static ulong GetMatchCacheKey(const TokenTypes startFlags, const LexBlockTypes startType)
+    {
+        return ((ulong)startFlags << 32u) | (ulong)startType;
+    }
+
     int SymbolParser::TryMatchPatternType(const int start, const TokenTypes startFlags)
     {
+        int length;
+
+        if (TryGetCachedMatch(start, startFlags, length))
+            return length;
+
+        readStart = start;
+        readEnd = start + 1;
+        length = MatchPatternType(start, startFlags);
+        CacheMatch(start, startFlags, length);
+
+        return length;
+    }
+
+    bool SymbolParser::TryGetCachedMatch(const int start, const TokenTypes startFlags, int& length)
+    {
+        const IDynamicArray<LexBlock>& blocks = pAnalyzer->GetBlocks();
+        const auto it = matchCacheHeads.find(GetMatchCacheKey(startFlags, blocks[start].type));
+
+        if (it == matchCacheHeads.end())
+            return false;
+
+        const int blockCount = (int)blocks.GetLength();
+
+        for (int i = it->second.head; i != -1; i = matchCache[i].next)
+        {
+            const MatchCacheEntry& entry = matchCache[i];
+            const int first = start + entry.readStart;
+
+            // Matches that would have reached either end of the source behave differently
+            if (entry.startFlags != startFlags || first <= 0 || (first + entry.readCount) >= blockCount)
+                continue;
+
+            bool isSame = true;
+
+            for (int j = 0; j < entry.readCount && isSame; j++)
+                isSame = blocks[first + j].type == matchCacheTypes[entry.typeStart + j];
+
+            if (!isSame)
+                continue;
+
+            // Replay captures at the new position
+            ClearMatchBuffers();
+
+            if (entry.length != -1)
+            {
+                for (int j = 0; j < entry.groupCount + entry.subGroupCount; j++)
+                {
+                    CaptureGroup group = matchCacheGroups[entry.groupStart + j];
+                    group.srcStart += start;
+
+                    if (j < entry.groupCount)
+                        capGroups.Add(group);
+                    else
+                        capSubGroups.Add(group);
+                }
+
+                for (int j = 0; j < entry.capCount; j++)
+                {
+                    CaptureBlock& cap = captures.EmplaceBack(matchCacheCaptures[entry.capStart + j]);
+                    cap.blockID += start;
+                }
+            }
+
+            length = entry.length;
+            return true;
+        }
+
+        return false;
+    }
+
+    void SymbolParser::CacheMatch(const int start, const TokenTypes startFlags, const int length)
+    {
+        const IDynamicArray<LexBlock>& blocks = pAnalyzer->GetBlocks();
+
+        // Bounds checks at either end of the source aren't reflected in the block types read
+        if (readStart <= 0 || readEnd >= (int)blocks.GetLength())
+            return;
+
+        if ((int)matchCache.GetLength() >= s_MaxMatchCacheEntries)
+            ClearMatchCache();
+
+        const int entryID = (int)matchCache.GetLength();
+        MatchCacheEntry& entry = matchCache.EmplaceBack();
+        entry.startFlags = startFlags;
+        entry.readStart = readStart - start;
+        entry.readCount = readEnd - readStart;
+        entry.typeStart = (int)matchCacheTypes.GetLength();
+        entry.length = length;
+        entry.groupStart = (int)matchCacheGroups.GetLength();
+        entry.groupCount = 0;
+        entry.subGroupCount = 0;
+        entry.capStart = (int)matchCacheCaptures.GetLength();
+        entry.capCount = 0;
+
+        for (int i = readStart; i < readEnd; i++)
+            matchCacheTypes.Add(blocks[i].type);
+
+        if (length != -1)
+        {
+            entry.groupCount = (int)capGroups.GetLength();
+            entry.subGroupCount = (int)capSubGroups.GetLength();
+            entry.capCount = (int)captures.GetLength();
+
+            for (const CaptureGroup& group : capGroups)
+                matchCacheGroups.EmplaceBack(group).srcStart -= start;
+
+            for (const CaptureGroup& group : capSubGroups)
+                matchCacheGroups.EmplaceBack(group).srcStart -= start;
+
+            for (const CaptureBlock& cap : captures)
+                matchCacheCaptures.EmplaceBack(cap).blockID -= start;
+        }
+
+        MatchCacheChain& chain = matchCacheHeads.try_emplace(GetMatchCacheKey(startFlags, blocks[start].type), 
+            MatchCacheChain{ -1, 0 }).first->second;
+
+        // Bounds lookups by unlinking the oldest entry. Its storage is reclaimed on the next reset.
+        if (chain.length == s_MaxMatchCacheChain)
+        {
+            int last = chain.head;
+
+            for (int i = 2; i < s_MaxMatchCacheChain; i++)
+                last = matchCache[last].next;
+
+            matchCache[last].next = -1;
+            chain.length--;
+        }
+
+        entry.next = chain.head;
+        chain.head = entryID;
+        chain.length++;
+    }
+
+    void SymbolParser::ClearMatchCache()
+    {
+        matchCache.Clear();
+        matchCacheTypes.Clear();
+        matchCacheGroups.Clear();
+        matchCacheCaptures.Clear();
+        matchCacheHeads.clear();
+    }
+
+    int SymbolParser::MatchPatternType(const int start, const TokenTypes startFlags)
+    {
+        const LexBlockTypes startType = GetBlock(start).type;
+
         for (const MatchNodeGroup& group : MatchNodeGroup::MatchNodeGroups)
         {
             if (group.GetHasFlags(startFlags))
             {
-                for (const MatchNode& rootPattern : group.rootNodes)
+                for (int i = 0; i < (int)group.rootNodes.GetLength(); i++)
                 {
+                    // Skip roots that can't start on this block without attempting a match
+                    if (!group.rootStarts[i].GetCanStartWith(startType))
+                        continue;
+
+                    const MatchNode& rootPattern = group.rootNodes[i];
                     ClearMatchBuffers();
                     int nextMatch = TryMatchPatternNode(rootPattern, start);
 
@@ -632,7 +796,14 @@ namespace Weave::Effects
         func.signature = pSB->AddGeneratedText(textBuf.str());
     }
 
-    const LexBlock& SymbolParser::GetBlock(ptrdiff_t index) { return pAnalyzer->GetBlocks()[index]; }
+    const LexBlock& SymbolParser::GetBlock(ptrdiff_t index) 
+    { 
+        // Track the range read so matches can be cached by the block types they depend on
+        readStart = std::min(readStart, (int)index);
+        readEnd = std::max(readEnd, (int)index + 1);
+
+        return pAnalyzer->GetBlocks()[index]; 
+    }
 
     size_t SymbolParser::GetBlockCount() { return pAnalyzer->GetBlocks().GetLength(); }
 
@@ -395,13 +395,133 @@ void MatchNode::ReversePattern()
 	}
 }
 
+MatchStartSet::MatchStartSet() :
+	types(),
+	count(0),
+	isAny(true)
+{ }
+
+MatchStartSet::MatchStartSet(const MatchNode& root) :
+	types(),
+	count(0),
+	isAny(false)
+{
+	// Roots that can match without consuming their first block can start anywhere
+	if (AddNode(root))
+		isAny = true;
+}
+
+bool MatchStartSet::GetCanStartWith(LexBlockTypes type) const
+{
+	if (isAny)
+		return true;
+
+	// Same test as BlockQualifier::GetHasFlags(type) in forward matches
+	for (uint i = 0; i < count; i++)
+	{
+		if ((types[i] & type) == type)
+			return true;
+	}
+
+	return false;
+}
+
+void MatchStartSet::AddType(LexBlockTypes type)
+{
+	if (type == LexBlockTypes::Unknown || count >= MaxTypes)
+	{
+		isAny = true;
+		return;
+	}
+
+	for (uint i = 0; i < count; i++)
+	{
+		if (types[i] == type)
+			return;
+	}
+
+	types[count++] = type;
+}
+
+bool MatchStartSet::AddNode(const MatchNode& node)
+{
+	// Backward nodes match blocks before the start, and never consume it
+	if (!node.GetIsForward())
+		return true;
+
+	const bool isAlternation = node.GetHasFlags(MatchQualifiers::Alternation);
+	bool isNullable = true;
+
+	if (node.GetHasMatchPatterns())
+	{
+		// Patterns match in sequence. Alternation only makes all but the last optional.
+		const IDynamicArray<MatchPattern>& patterns = node.GetMatchPatterns();
+		const int last = (int)patterns.GetLength() - 1;
+
+		for (int i = 0; i <= last && isNullable; i++)
+			isNullable = AddPattern(patterns[i], isAlternation && i < last);
+	}
+	else if (node.GetHasMatchNodes())
+	{
+		// Alternate nodes stop on the first success, including empty matches
+		if (isAlternation)
+		{
+			isNullable = false;
+
+			for (const MatchNode& child : node.GetMatchNodes())
+				isNullable |= AddNode(child);
+		}
+		else
+		{
+			for (const MatchNode& child : node.GetMatchNodes())
+			{
+				if (!AddNode(child))
+				{
+					isNullable = false;
+					break;
+				}
+			}
+		}
+	}
+
+	return isNullable || node.GetHasFlags(MatchQualifiers::Optional);
+}
+
+bool MatchStartSet::AddPattern(const MatchPattern& pattern, bool isOptional)
+{
+	const bool isAlternation = pattern.GetHasFlags(MatchQualifiers::Alternation);
+	const int last = (int)pattern.GetLength() - 1;
+	bool isNullable = true;
+
+	for (int i = 0; i <= last; i++)
+	{
+		const BlockQualifier& block = pattern[i];
+		AddType(block.type);
+
+		// Optional qualifiers let the next one match the first block
+		if (!block.GetHasFlags(MatchQualifiers::Optional) && !(isAlternation && i < last))
+		{
+			isNullable = false;
+
+			if (!isAlternation)
+				break;
+		}
+	}
+
+	return isNullable || isOptional || pattern.GetHasFlags(MatchQualifiers::Optional);
+}
+
 MatchNodeGroup::MatchNodeGroup(
 	const std::initializer_list<TokenTypes>& startingTypes, 
 	const std::initializer_list<MatchNode>& patterns
 ) noexcept :
 	symbolTypes(startingTypes),
-	rootNodes(patterns)
-{ }
+	rootNodes(patterns),
+	rootStarts(rootNodes.GetLength())
+{ 
+	for (int i = 0; i < rootNodes.GetLength(); i++)
+		rootStarts[i] = MatchStartSet(rootNodes[i]);
+}
 
 bool MatchNodeGroup::GetHasFlags(TokenTypes flags) const
 {
@@ -16,9 +16,6 @@ void ShaderRegistryBuilder::Clear()
 		"Temporary buffers must be returned before finalizing or exporting shader regsitry.");
 
 	stringIDs.Clear();
-	resourceSet.clear();
-	idBuffer.Clear();
-	byteBuffer.Clear();
 
 	constants.Clear();
 	cbufDefs.Clear();
@@ -39,7 +36,11 @@ int ShaderRegistryBuilder::GetResourceCount() const { return resCount; }
 
 int ShaderRegistryBuilder::GetUniqueResCount() const { return uniqueResCount; }
 
-uint ShaderRegistryBuilder::GetOrAddStringID(string_view str) { return stringIDs.GetOrAddStringID(str); }
+uint ShaderRegistryBuilder::GetOrAddStringID(string_view str) 
+{ 
+	std::lock_guard lock(stringMutex);
+	return stringIDs.GetOrAddStringID(str); 
+}
 
 // Add helpers
 uint ShaderRegistryBuilder::GetOrAddConstant(const ConstDef& constDef) { return GetOrAddValue(ConstDef(constDef), constants); }
@@ -75,15 +76,33 @@ IDSpan ShaderRegistryBuilder::GetIDGroup(const uint id) const { return idGroups.
 
 ByteSpan ShaderRegistryBuilder::GetShaderBin(const uint id) const { return binSpans.GetValue(id); }
 
-Vector<uint> ShaderRegistryBuilder::GetTmpIDBuffer() { return idBufPool.Get(); }
+Vector<uint> ShaderRegistryBuilder::GetTmpIDBuffer() 
+{ 
+	std::lock_guard lock(poolMutex);
+	return idBufPool.Get(); 
+}
 
-Vector<byte> ShaderRegistryBuilder::GetTmpByteBuffer() { return byteCodePool.Get(); }
+Vector<byte> ShaderRegistryBuilder::GetTmpByteBuffer() 
+{ 
+	std::lock_guard lock(poolMutex);
+	return byteCodePool.Get(); 
+}
 
-void ShaderRegistryBuilder::ReturnTmpByteBuffer(Vector<byte>&& buf) { buf.Clear(); byteCodePool.Return(std::move(buf)); }
+void ShaderRegistryBuilder::ReturnTmpByteBuffer(Vector<byte>&& buf) 
+{ 
+	buf.Clear();
+	std::lock_guard lock(poolMutex);
+	byteCodePool.Return(std::move(buf)); 
+}
 
 const StringIDBuilder& ShaderRegistryBuilder::GetStringIDBuilder() const { return stringIDs; }
 
-void ShaderRegistryBuilder::ReturnTmpIDBuffer(Vector<uint>&& buf) { buf.Clear(); idBufPool.Return(std::move(buf)); }
+void ShaderRegistryBuilder::ReturnTmpIDBuffer(Vector<uint>&& buf) 
+{ 
+	buf.Clear();
+	std::lock_guard lock(poolMutex);
+	idBufPool.Return(std::move(buf)); 
+}
 
 ShaderRegistryDef::Handle ShaderRegistryBuilder::GetDefinition() const
 {
@@ -109,31 +128,3 @@ uint ShaderRegistryBuilder::SetResourceType(uint index, ResourceType type) { ret
 ResourceType ShaderRegistryBuilder::GetResourceType(uint id) { return (ResourceType)(id >> 24u); }
 
 uint ShaderRegistryBuilder::GetIndex(uint id) { return (id & 0x00FFFFFFu); }
-
-// Heterogeneous hashing handle
-HashHandle::HashHandle() : id(-1), pGetHash(nullptr), pGetIsEqual(nullptr)
-{
-}
-
-HashHandle::HashHandle(const uint id, const HashFunc& getHash, const IsEqFunc& getIsEq) :
-	id(id), pGetHash(&getHash), pGetIsEqual(&getIsEq)
-{
-}
-
-uint HashHandle::GetID() const { return id; }
-
-uint HashHandle::GetIndex() const { return ShaderRegistryBuilder::GetIndex(id); }
-
-ResourceType HashHandle::GetType() const { return ShaderRegistryBuilder::GetResourceType(id); }
-
-size_t HashHandle::GetHash() const { return (*pGetHash)(*this); }
-
-bool HashHandle::operator==(const HashHandle& rhs) const
-{
-	if (this == &rhs)
-		return true;
-	else if (GetType() == rhs.GetType())
-		return (*pGetIsEqual)(*this, rhs);
-	else
-		return false;
-}
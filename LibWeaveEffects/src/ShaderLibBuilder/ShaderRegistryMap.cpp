@@ -1,19 +1,32 @@
 #include "pch.hpp"
+#include "WeaveUtils/LZ4.hpp"
 #include "WeaveEffects/ShaderDataHandles.hpp"
 #include "WeaveEffects/ShaderLibBuilder/ShaderRegistryMap.hpp"
 #include "WeaveEffects/ShaderLibBuilder/ShaderRegistryBuilder.hpp"
+#include "WeaveEffects/ShaderLibImage.hpp"
 
 using namespace Weave;
 using namespace Weave::Effects;
 
-ShaderRegistryMap::ShaderRegistryMap(const StringIDMapDef& strDef, const ShaderRegistryDef& def) :
-	pRegDef(new ShaderRegistryDef(def)),
-	stringMap(strDef)
-{ }
+static string_view GetStringData(const ShaderLibImage& image)
+{
+	const std::span<const char> data = image.GetSection<char>(LibImageSections::StringData);
+	return string_view(data.data(), data.size());
+}
 
-ShaderRegistryMap::ShaderRegistryMap(StringIDMapDef&& strDef, ShaderRegistryDef&& def) :
-	pRegDef(new ShaderRegistryDef(std::move(def))),
-	stringMap(std::move(strDef))
+ShaderRegistryMap::ShaderRegistryMap(const ShaderLibImage& image) :
+	constants(image.GetSection<ConstDef>(LibImageSections::Constants)),
+	cbufDefs(image.GetSection<ConstBufDef>(LibImageSections::CBufDefs)),
+	ioElements(image.GetSection<IOElementDef>(LibImageSections::IOElements)),
+	resources(image.GetSection<ResourceDef>(LibImageSections::Resources)),
+	shaders(image.GetSection<ShaderDef>(LibImageSections::Shaders)),
+	effects(image.GetSection<EffectDef>(LibImageSections::Effects)),
+	idSpans(image.GetSection<uint>(LibImageSections::IDGroupSpans)),
+	idData(image.GetSection<uint>(LibImageSections::IDGroupData)),
+	binSpans(image.GetSection<uint>(LibImageSections::BinSpans)),
+	binData(image.GetSection<byte>(LibImageSections::BinData)),
+	binRawSizes(image.GetSection<uint>(LibImageSections::BinRawSizes)),
+	stringMap(image.GetSection<uint>(LibImageSections::StringSpans), GetStringData(image), image.GetStringTable())
 { }
 
 const StringIDMap& ShaderRegistryMap::GetStringMap() const { return stringMap; }
@@ -28,25 +41,53 @@ string_view ShaderRegistryMap::GetString(uint id) const { return stringMap.GetSt
 uint ShaderRegistryMap::GetStringCount() const { return stringMap.GetStringCount(); }
 
 const EffectDef& ShaderRegistryMap::GetEffect(uint effectID) const 
-{ return pRegDef->effects[ShaderRegistryBuilder::GetIndex(effectID)]; }
+{ return effects[ShaderRegistryBuilder::GetIndex(effectID)]; }
 
 const ShaderDef& ShaderRegistryMap::GetShader(uint shaderID) const 
-{ return pRegDef->shaders[ShaderRegistryBuilder::GetIndex(shaderID)]; }
+{ return shaders[ShaderRegistryBuilder::GetIndex(shaderID)]; }
+
+ByteView ShaderRegistryMap::GetByteCode(uint byteCodeID) const
+{ 
+	const uint index = ShaderRegistryBuilder::GetIndex(byteCodeID);
+	const uint start = binSpans[2 * index];
+	const uint length = binSpans[2 * index + 1];
+	const uint rawSize = binRawSizes[index];
+
+	if (length == rawSize)
+		return ByteView(const_cast<byte*>(binData.data()), start, length);
+
+	std::lock_guard lock(decodeMutex);
 
-ByteSpan ShaderRegistryMap::GetByteCode(uint byteCodeID) const
-{ return pRegDef->binSpans[ShaderRegistryBuilder::GetIndex(byteCodeID)]; }
+	if (decodedBins.GetLength() == 0)
+		decodedBins = UniqueArray<Vector<byte>>(binRawSizes.size());
 
-IDSpan ShaderRegistryMap::GetIDGroup(uint groupID) const
-{ return pRegDef->idGroups[ShaderRegistryBuilder::GetIndex(groupID)]; }
+	Vector<byte>& bin = decodedBins[index];
+
+	if (bin.GetLength() != rawSize)
+	{
+		Vector<byte> decoded;
+		decoded.Resize(rawSize);
+		DecompressLZ4(binData.subspan(start, length), std::span<byte>(decoded.GetData(), decoded.GetLength()));
+		bin = std::move(decoded);
+	}
+
+	return ByteView(bin.GetData(), 0, bin.GetLength());
+}
+
+IDView ShaderRegistryMap::GetIDGroup(uint groupID) const
+{ 
+	const uint index = ShaderRegistryBuilder::GetIndex(groupID);
+	return IDView(const_cast<uint*>(idData.data()), idSpans[2 * index], idSpans[2 * index + 1]);
+}
 
 const ResourceDef& ShaderRegistryMap::GetResource(const uint resID) const 
-{ return pRegDef->resources[ShaderRegistryBuilder::GetIndex(resID)]; }
+{ return resources[ShaderRegistryBuilder::GetIndex(resID)]; }
 
 const IOElementDef& ShaderRegistryMap::GetIOElement(const uint id) const 
-{ return pRegDef->ioElements[ShaderRegistryBuilder::GetIndex(id)]; }
+{ return ioElements[ShaderRegistryBuilder::GetIndex(id)]; }
 
 const ConstBufDef& ShaderRegistryMap::GetConstBuf(const uint cbufID) const 
-{ return pRegDef->cbufDefs[ShaderRegistryBuilder::GetIndex(cbufID)]; }
+{ return cbufDefs[ShaderRegistryBuilder::GetIndex(cbufID)]; }
 
 const ConstDef& ShaderRegistryMap::GetConstant(const uint constID) const 
-{ return pRegDef->constants[ShaderRegistryBuilder::GetIndex(constID)]; }
+{ return constants[ShaderRegistryBuilder::GetIndex(constID)]; }
@@ -0,0 +1,418 @@
+#include "pch.hpp"
+#include "WeaveEffects/ShaderLibBuilder/ShaderParser/BlockAnalyzer.hpp"
+#include "WeaveEffects/ShaderLibBuilder/ShaderParser/ScopeBuilder.hpp"
+#include "WeaveEffects/ShaderLibBuilder/SymbolTable.hpp"
+#include "WeaveEffects/ShaderLibBuilder/ShaderGenerator.hpp"
+#include "WeaveEffects/ShaderLibBuilder/ShaderCompiler.hpp"
+#include "WeaveEffects/ShaderLibBuilder/VariantPreprocessor.hpp"
+#include "WeaveEffects/ShaderLibBuilder/ShaderRegistryBuilder.hpp"
+#include "WeaveEffects/ShaderLibBuilder/ShaderCache.hpp"
+#include "WeaveEffects/ShaderLibBuilder/BuildProfiler.hpp"
+#include "WeaveEffects/ShaderLibBuilder/VariantBuilder.hpp"
+
+using namespace Weave::Effects;
+
+VariantBuilder::VariantBuilder() :
+	pVariantGen(new VariantPreprocessor()),
+	pAnalyzer(new BlockAnalyzer()),
+	pTable(new SymbolTable()),
+	configID(0),
+	pProfiler(nullptr),
+	epStringCount(0)
+{ }
+
+VariantBuilder::~VariantBuilder() = default;
+
+void VariantBuilder::SetSrc(string_view libPath, string_view libSrc)
+{
+	Clear();
+	this->libPath = libPath;
+	pVariantGen->SetSrc(libPath, libSrc);
+}
+
+void VariantBuilder::SetVariantConfig(const VariantBuilder& other) { pVariantGen->SetVariantConfig(*other.pVariantGen); }
+
+void VariantBuilder::SetProfiler(BuildProfiler* pProfiler) { this->pProfiler = pProfiler; }
+
+const VariantPreprocessor& VariantBuilder::GetPreprocessor() const { return *pVariantGen; }
+
+void VariantBuilder::Preprocess(uint configID, PreprocessorCache* pCache)
+{
+	BuildProfiler::Scope profile(pProfiler, BuildStages::Preprocess, configID);
+	ClearVariant();
+	this->configID = configID;
+	pVariantGen->GetVariant(configID, libText, entrypoints, pCache);
+	profile.SetCounter(0, libText.size());
+}
+
+uint VariantBuilder::GetConfigID() const { return configID; }
+
+string_view VariantBuilder::GetVariantSrc() const { return libText; }
+
+void VariantBuilder::Parse()
+{
+	{
+		BuildProfiler::Scope profile(pProfiler, BuildStages::Analyze, configID);
+		pAnalyzer->AnalyzeSource(libPath, libText);
+		profile.SetCounter(0, pAnalyzer->GetBlocks().GetLength());
+		profile.SetCounter(1, libText.size());
+	}
+	{
+		BuildProfiler::Scope profile(pProfiler, BuildStages::Parse, configID);
+		pTable->ParseBlocks(*pAnalyzer);
+		profile.SetCounter(0, pTable->GetTokenCount());
+		profile.SetCounter(1, pTable->GetSymbolCount());
+	}
+
+	// Shaders
+	GetEntryPoints();
+	epStringCount = stringIDs.GetStringCount();
+	shaderSrcs.Resize(entrypoints.GetLength());
+	shaderKeys.Resize(entrypoints.GetLength());
+	shaderBins.Resize(entrypoints.GetLength());
+	shaderIDs.Resize(entrypoints.GetLength());
+
+	for (uint& shaderID : shaderIDs)
+		shaderID = (uint)-1;
+
+	// Effects
+	GetEffects();
+}
+
+uint VariantBuilder::GetShaderCount() const { return (uint)entrypoints.GetLength(); }
+
+void VariantBuilder::GenerateShader(uint index, const IShaderCompiler& compiler, string_view featureLevel, bool isDebugging)
+{
+	// Generator state is per thread, while the parsed variant is only read
+	static thread_local ShaderGenerator s_ShaderGen;
+
+	BuildProfiler::Scope profile(pProfiler, BuildStages::Generate, configID);
+	const ShaderEntrypoint& ep = entrypoints[index];
+	string& hlsl = shaderSrcs[index];
+	hlsl.clear();
+
+	s_ShaderGen.GetShaderSource(*pTable, pAnalyzer->GetBlocks(), ep, entrypoints, hlsl);
+	shaderKeys[index] = ShaderCache::GetKey(libPath, hlsl, ep.stage, ep.name, 
+		featureLevel, isDebugging, compiler.GetCompilerVersion());
+	profile.SetCounter(0, hlsl.size());
+}
+
+const Hash128& VariantBuilder::GetShaderKey(uint index) const { return shaderKeys[index]; }
+
+void VariantBuilder::CompileShader(uint index, const IShaderCompiler& compiler, string_view featureLevel, bool isDebugging, 
+	ShaderCache* pCache)
+{
+	BuildProfiler::Scope profile(pProfiler, BuildStages::Compile, configID);
+	const ShaderEntrypoint& ep = entrypoints[index];
+	Vector<byte>& byteCode = shaderBins[index];
+	byteCode.Clear();
+
+	const ShaderSourceDesc src
+	{
+		.srcFile = libPath,
+		.srcText = shaderSrcs[index],
+		.mainName = ep.name,
+		.stage = ep.stage,
+		.pTable = pTable.get(),
+		.mainID = ep.symbolID
+	};
+
+	if (pCache != nullptr)
+	{
+		if (!pCache->TryGetShader(shaderKeys[index], byteCode))
+		{
+			compiler.GetPrecompShader(src, featureLevel, byteCode, isDebugging);
+			pCache->AddShader(shaderKeys[index], byteCode);
+		}
+		else
+			profile.SetCounter(1, 1);
+	}
+	else
+		compiler.GetPrecompShader(src, featureLevel, byteCode, isDebugging);
+
+	profile.SetCounter(0, byteCode.GetLength());
+}
+
+void VariantBuilder::SetShaderID(uint index, uint shaderID) { shaderIDs[index] = shaderID; }
+
+uint VariantBuilder::GetShaderID(uint index) const { return shaderIDs[index]; }
+
+void VariantBuilder::Commit(const IShaderCompiler& compiler, ShaderRegistryBuilder& registry, VariantDef& variant, uint vID)
+{
+	BuildProfiler::Scope profile(pProfiler, BuildStages::Commit, configID);
+	const int resCount = registry.GetResourceCount();
+	const int uniqueResCount = registry.GetUniqueResCount();
+	stringIDMap.Clear();
+
+	// Shader names precede reflected metadata
+	MapStringIDs(registry, 0, epStringCount);
+	variant.shaders = DynamicArray<ShaderVariantDef>(entrypoints.GetLength());
+	GetShaderDefs(compiler, registry, variant.shaders, vID);
+
+	// Effect and pass names follow
+	MapStringIDs(registry, epStringCount, stringIDs.GetStringCount());
+	variant.effects = DynamicArray<EffectVariantDef>(effectBlocks.GetLength());
+	GetEffectDefs(registry, variant.effects, vID);
+
+	const int misses = registry.GetUniqueResCount() - uniqueResCount;
+	profile.SetCounter(0, (registry.GetResourceCount() - resCount) - misses);
+	profile.SetCounter(1, misses);
+}
+
+void VariantBuilder::MapStringIDs(ShaderRegistryBuilder& registry, uint start, uint end)
+{
+	for (uint i = start; i < end; i++)
+		stringIDMap.EmplaceBack(registry.GetOrAddStringID(stringIDs.GetString(i)));
+}
+
+void VariantBuilder::GetEntryPoints()
+{
+	// Attribute tags
+	for (int i = 0; i < pTable->GetSymbolCount(); i++)
+	{
+		SymbolHandle symbol = pTable->GetSymbol(i);
+
+		if (symbol.GetHasFlags(SymbolTypes::FuncDefinition))
+		{
+			TokenNodeHandle funcIdent = symbol.GetIdent();
+
+			for (int j = 0; j < funcIdent.GetChildCount(); j++)
+			{
+				if (funcIdent[j].GetHasFlags(TokenTypes::AttribShaderDecl))
+				{
+					string_view name = funcIdent.GetValue();
+					const uint nameID = stringIDs.GetOrAddStringID(name);
+
+					if (!epNameShaderIDMap.contains(nameID))
+					{
+						ShaderEntrypoint& ep = entrypoints.EmplaceBack();
+						epNameShaderIDMap.emplace(nameID, -1);
+						ep.name = name;
+						ep.stage = GetStageFromFlags(funcIdent[j].GetFlags());
+						ep.symbolID = i;
+					}
+
+					break;
+				}
+			}
+		}
+	}
+
+	// Pragma shaders
+	for (int i = 0; i < entrypoints.GetLength(); i++)
+	{
+		ShaderEntrypoint& ep = entrypoints[i];
+		ScopeHandle global = pTable->GetScope(0);
+		const IDList* pFuncs = global.TryGetFuncOverloads(ep.name);
+
+		if (pFuncs != nullptr && !pFuncs->IsEmpty())
+		{
+			const uint nameID = stringIDs.GetOrAddStringID(ep.name);
+
+			if (!epNameShaderIDMap.contains(nameID))
+			{
+				epNameShaderIDMap.emplace(nameID, -1);
+				ep.symbolID = pFuncs->GetFront();
+			}
+		}
+		else
+			FXBLOCK_THROW(*pAnalyzer, global.GetBlockStart(),
+				"Definition for shader '{}' declared in pragma not found", ep.name);
+	}
+
+	// Shader blocks
+	for (int i = 0; i < pTable->GetSymbolCount(); i++)
+	{
+		SymbolHandle symbol = pTable->GetSymbol(i);
+
+		if (symbol.GetHasFlags(SymbolTypes::ShaderDef))
+		{
+			ScopeHandle scope = *symbol.GetScope();
+			string_view name = symbol.GetName();
+			const IDList* pFuncs = scope.TryGetFuncOverloads(name);
+
+			if (pFuncs != nullptr && !pFuncs->IsEmpty())
+			{
+				const uint nameID = stringIDs.GetOrAddStringID(name);
+
+				if (!epNameShaderIDMap.contains(nameID))
+				{
+					ShaderEntrypoint& ep = entrypoints.EmplaceBack();
+					epNameShaderIDMap.emplace(nameID, -1);
+					ep.name = name;
+					ep.stage = GetStageFromFlags(symbol.GetFlags());
+					ep.symbolID = pFuncs->GetFront();
+				}
+			}
+			else
+				FXBLOCK_THROW(*pAnalyzer, symbol.GetIdent().GetBlockStart(),
+					"Could not find entrypoint for shader block '{}'", name);
+		}
+	}
+}
+
+void VariantBuilder::GetEffects()
+{
+	for (int i = 0; i < pTable->GetSymbolCount(); i++)
+	{
+		SymbolHandle symbol = pTable->GetSymbol(i);
+
+		if (symbol.GetIsScope() && symbol.GetHasFlags(SymbolTypes::TechniqueDef))
+		{
+			ScopeHandle effectScope = *symbol.GetScope();
+			EffectBlock& effect = effectBlocks.EmplaceBack();
+			effect.nameID = stringIDs.GetOrAddStringID(symbol.GetName());
+			effect.passStart = (uint)effectPasses.GetLength();
+			effect.passCount = 0;
+			bool isPassDefaulted = false;
+
+			for (int j = 0; j < effectScope.GetChildCount(); j++)
+			{
+				SymbolHandle effectChild = effectScope[j];
+
+				if (!isPassDefaulted && effectChild.GetHasFlags(SymbolTypes::TechniqueShaderDecl))
+					isPassDefaulted = true;
+
+				if (effectChild.GetHasFlags(SymbolTypes::TechniquePassDecl))
+				{
+					FXBLOCK_CHECK_MSG(!isPassDefaulted, *pAnalyzer, symbol.GetIdent().GetBlockStart(),
+						"Illegal use of defaulted and explicit passes in the same effect '{}'", symbol.GetName());
+
+					effect.passCount++;
+				}
+			}
+
+			if (isPassDefaulted)
+			{
+				AddPass(effectScope, "DefaultedPass");
+				effect.passCount = 1;
+			}
+			else
+			{
+				for (int j = 0; j < effectScope.GetChildCount(); j++)
+				{
+					SymbolHandle effectChild = effectScope[j];
+
+					if (effectChild.GetHasFlags(SymbolTypes::TechniquePassDecl))
+					{
+						ScopeHandle passScope = *effectChild.GetScope();
+						AddPass(passScope, effectChild.GetName());
+					}
+				}
+			}
+		}
+	}
+}
+
+void VariantBuilder::AddPass(const ScopeHandle& passScope, string_view name)
+{
+	PassBlock& pass = effectPasses.EmplaceBack();
+	pass.nameID = stringIDs.GetOrAddStringID(name);
+	pass.shaderStart = (uint)effectShaders.GetLength();
+
+	for (int j = 0; j < passScope.GetChildCount(); j++)
+	{
+		SymbolHandle effectChild = passScope[j];
+
+		if (effectChild.GetHasFlags(SymbolTypes::TechniqueShaderDecl))
+		{
+			string_view shaderName = effectChild.GetName();
+			const uint stringID = stringIDs.GetOrAddStringID(shaderName);
+
+			FXBLOCK_CHECK_MSG(epNameShaderIDMap.contains(stringID), *pAnalyzer, effectChild.GetIdent().GetBlockStart(),
+				"Unrecognised shader name '{}' declared in effect pass", shaderName);
+
+			// Resolved to a shaderID on commit
+			effectShaders.EmplaceBack(stringID);
+		}
+	}
+
+	pass.shaderCount = (uint)effectShaders.GetLength() - pass.shaderStart;
+}
+
+void VariantBuilder::GetShaderDefs(const IShaderCompiler& compiler, ShaderRegistryBuilder& registry, 
+	DynamicArray<ShaderVariantDef>& variants, uint vID)
+{
+	for (int i = 0; i < entrypoints.GetLength(); i++)
+	{
+		const ShaderEntrypoint& ep = entrypoints[i];
+
+		// Shaders reused from an earlier variant were never compiled
+		if (shaderIDs[i] == -1)
+			shaderIDs[i] = compiler.GetShaderDef(libPath, shaderBins[i], ep.stage, ep.name, registry);
+
+		const uint shaderID = shaderIDs[i];
+		uint nameID;
+		stringIDs.TryGetStringID(ep.name, nameID);
+
+		variants[i].shaderID = shaderID;
+		variants[i].variantID = vID;
+		// Update name -> shader ID key
+		epNameShaderIDMap[nameID] = shaderID;
+	}
+}
+
+void VariantBuilder::GetEffectDefs(ShaderRegistryBuilder& registry, DynamicArray<EffectVariantDef>& effects, uint vID)
+{
+	// Effects
+	for (uint i = 0; i < (uint)effectBlocks.GetLength(); i++)
+	{
+		const EffectBlock& block = effectBlocks[i];
+		EffectDef effect;
+		effect.nameID = stringIDMap[block.nameID];
+		Vector<uint> passBuf = registry.GetTmpIDBuffer();
+
+		// Passes
+		for (uint j = 0; j < block.passCount; j++)
+		{
+			PassBlock& pass = effectPasses[block.passStart + j];
+			Vector<uint> idBuf = registry.GetTmpIDBuffer();
+
+			// Shaders
+			for (uint k = 0; k < pass.shaderCount; k++)
+			{
+				const uint shaderIndex = pass.shaderStart + k;
+				idBuf.EmplaceBack(epNameShaderIDMap[effectShaders[shaderIndex]]);
+			}
+
+			passBuf.EmplaceBack(registry.GetOrAddIDGroup(idBuf));
+			registry.ReturnTmpIDBuffer(std::move(idBuf));
+		}
+
+		effect.passGroupID = registry.GetOrAddIDGroup(passBuf);
+		registry.ReturnTmpIDBuffer(std::move(passBuf));
+
+		effects[i] = EffectVariantDef
+		{
+			.effectID = registry.GetOrAddEffect(effect),
+			.variantID = vID
+		};
+	}
+}
+
+void VariantBuilder::ClearVariant()
+{
+	pTable->Clear();
+	pAnalyzer->Clear();
+
+	libText.clear();
+
+	stringIDs.Clear();
+	stringIDMap.Clear();
+	epStringCount = 0;
+
+	entrypoints.Clear();
+	epNameShaderIDMap.clear();
+
+	effectBlocks.Clear();
+	effectPasses.Clear();
+	effectShaders.Clear();
+}
+
+void VariantBuilder::Clear()
+{
+	ClearVariant();
+	pVariantGen->Clear();
+	libPath = string_view();
+	configID = 0;
+}
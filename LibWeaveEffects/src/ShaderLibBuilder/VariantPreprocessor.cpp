@@ -1,5 +1,8 @@
 #include "pch.hpp"
+#include <fstream>
+#include "WeaveUtils/Span.hpp"
 #include "WeaveEffects/ShaderLibBuilder/VariantPreprocessor.hpp"
+#include "WeaveEffects/ShaderLibBuilder/PreprocessorCache.hpp"
 
 namespace Weave::Effects
 { 
@@ -18,9 +21,46 @@ namespace Weave::Effects
 		return spanBuf.EmplaceBack(textBuf, bufStart, subLen);
 	}
 
+	/// <summary>
+	/// Returns flag or mode name without null terminator
+	/// </summary>
+	static string_view GetDefineName(const StringSpan& define)
+	{
+		string_view name = define;
+
+		if (!name.empty() && name.back() == '\0')
+			name.remove_suffix(1);
+
+		return name;
+	}
+
+	/// <summary>
+	/// Reads a file in text mode, matching Wave's default include loader
+	/// </summary>
+	static bool TryReadFile(const string& path, string& dst)
+	{
+		std::ifstream file(path);
+
+		if (!file.is_open())
+			return false;
+
+		file.unsetf(std::ios::skipws);
+		dst.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+		return true;
+	}
+
+	/// <summary>
+	/// Returns true if the character can appear in an identifier
+	/// </summary>
+	static bool GetIsIdentChar(char c)
+	{
+		return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_';
+	}
+
 	VariantPreprocessor::VariantPreprocessor() : 
 		isInitialized(false), 
-		pEntrypoints(nullptr)
+		pEntrypoints(nullptr),
+		pCache(nullptr)
 	{ }
 
 	void VariantPreprocessor::SetSrc(string_view filePath, string_view src)
@@ -32,6 +72,37 @@ namespace Weave::Effects
 
 	bool VariantPreprocessor::GetIsInitialized() const { return isInitialized; }
 
+	void VariantPreprocessor::SetVariantConfig(const VariantPreprocessor& other)
+	{
+		FX_ASSERT_MSG(this != &other, "Cannot copy variant configuration from self");
+
+		variantDefineSet.clear();
+		variantModes.Clear();
+		variantFlags.Clear();
+
+		textBuf.clear();
+		macroStarts.Clear();
+		sysIncludeStarts.Clear();
+		includeStarts.Clear();
+
+		for (const StringSpan& macro : other.macroStarts)
+			AddStringSpan(macro, macroStarts, textBuf);
+
+		for (const StringSpan& sysInclude : other.sysIncludeStarts)
+			AddStringSpan(sysInclude, sysIncludeStarts, textBuf);
+
+		for (const StringSpan& include : other.includeStarts)
+			AddStringSpan(include, includeStarts, textBuf);
+
+		for (const StringSpan& flag : other.variantFlags)
+			variantDefineSet.emplace(AddStringSpan(flag, variantFlags, textBuf));
+
+		for (const StringSpan& mode : other.variantModes)
+			variantDefineSet.emplace(AddStringSpan(mode, variantModes, textBuf));
+
+		isInitialized = other.isInitialized;
+	}
+
 	void VariantPreprocessor::AddMacro(std::string_view macro) { AddStringSpan(macro, macroStarts, textBuf); }
 
 	void VariantPreprocessor::AddSystemIncludePath(std::string_view path) { AddStringSpan(path, sysIncludeStarts, textBuf); }
@@ -54,16 +125,31 @@ namespace Weave::Effects
 		includeStarts.Clear();
 	
 		pEntrypoints = nullptr;
+		pCache = nullptr;
+		macroQueries.clear();
+		includedFiles.clear();
 
 		AddVariantMode("__DEFAULT_SHADER_MODE__");
 	}
 
 	std::string VariantPreprocessor::GetWaveVerString() { return WaveContext::get_version_string(); }
 
-	void VariantPreprocessor::GetVariant(const uint configID, string& dst, Vector<ShaderEntrypoint>& entrypoints)
+	void VariantPreprocessor::GetVariant(const uint configID, string& dst, Vector<ShaderEntrypoint>& entrypoints, 
+		PreprocessorCache* pCache)
 	{
 		FX_ASSERT_MSG(configID != -1 && configID < std::max<uint>(1u, GetVariantCount()), "Invalid variant ID");
+		const uint flagID = configID % GetFlagVariantCount();
+		const uint enumID = configID / GetFlagVariantCount();
+
+		// Flags and modes are only known after the first pass
+		if (isInitialized && pCache != nullptr && pCache->TryGetVariant(flagID, enumID, dst, entrypoints))
+			return;
+
+		const size_t srcStart = dst.length();
+		const size_t epStart = entrypoints.GetLength();
 		pEntrypoints = &entrypoints;
+		this->pCache = pCache;
+		macroQueries.clear();
 
 		// Initialize context to source
 		WaveStringView str(src.data(), src.length());
@@ -82,8 +168,6 @@ namespace Weave::Effects
 			ctx.add_macro_definition(macro);
 
 		// Convert ID into bit flags and set defines
-		const uint flagID = configID % GetFlagVariantCount();
-
 		for (int i = 0; i < variantFlags.GetLength(); i++)
 		{
 			const uint id = 1u << i;
@@ -93,8 +177,6 @@ namespace Weave::Effects
 		}
 
 		// Set mode define
-		const uint enumID = configID / GetFlagVariantCount();
-
 		if (enumID > 0)
 			ctx.add_macro_definition(variantModes[enumID]);
 
@@ -126,6 +208,82 @@ namespace Weave::Effects
 
 		isInitialized = true;
 		pEntrypoints = nullptr;
+		this->pCache = nullptr;
+
+		// Store output for reuse by variants that agree on every flag and mode it tested
+		if (pCache != nullptr)
+		{
+			const string_view varSrc = string_view(dst).substr(srcStart);
+			const Span<ShaderEntrypoint> varEntrypoints(entrypoints.GetData() + epStart, entrypoints.GetLength() - epStart);
+			VariantMacroDeps deps;
+
+			GetMacroDeps(varSrc, deps);
+			pCache->AddVariant(flagID, enumID, deps, varSrc, varEntrypoints);
+		}
+	}
+
+	void VariantPreprocessor::GetMacroDeps(string_view varSrc, VariantMacroDeps& deps) const
+	{
+		std::unordered_map<string_view, uint> defineIDs;
+		const uint flagCount = (uint)variantFlags.GetLength();
+		deps.flagMask = 0;
+		deps.modeMask.reset();
+
+		for (uint i = 0; i < flagCount; i++)
+			defineIDs.emplace(GetDefineName(variantFlags[i]), i);
+
+		// The default mode has no define
+		for (uint i = 1; i < (uint)variantModes.GetLength(); i++)
+			defineIDs.emplace(GetDefineName(variantModes[i]), flagCount + i);
+
+		const auto addDep = [&](string_view name)
+		{
+			const auto it = defineIDs.find(name);
+
+			if (it != defineIDs.end())
+			{
+				if (it->second < flagCount)
+					deps.flagMask |= (1u << it->second);
+				else
+					deps.modeMask.set(it->second - flagCount);
+			}
+		};
+
+		// Tested in directives or expanded
+		for (const string& name : macroQueries)
+			addDep(name);
+
+		// Undefined variant macros are copied to the output instead of expanded
+		for (size_t i = 0; i < varSrc.length();)
+		{
+			if (GetIsIdentChar(varSrc[i]))
+			{
+				const size_t start = i;
+
+				while (i < varSrc.length() && GetIsIdentChar(varSrc[i]))
+					i++;
+
+				if (varSrc[start] < '0' || varSrc[start] > '9')
+					addDep(varSrc.substr(start, i - start));
+			}
+			else
+				i++;
+		}
+	}
+
+	bool VariantPreprocessor::TryGetEquivalentVariant(const uint configID, const PreprocessorCache& cache, uint& equivID) const
+	{
+		FX_ASSERT_MSG(isInitialized, "Variant equivalence requires flags and modes from the first variant");
+		const uint flagCount = GetFlagVariantCount();
+		uint equivFlagID, equivModeID;
+
+		if (cache.TryGetEquivalent(configID % flagCount, configID / flagCount, equivFlagID, equivModeID))
+		{
+			equivID = equivFlagID + equivModeID * flagCount;
+			return equivID != configID;
+		}
+
+		return false;
 	}
 
 	uint VariantPreprocessor::GetFlagVariantCount() const { return 1u << (variantFlags.GetLength()); }
@@ -171,6 +329,24 @@ namespace Weave::Effects
 		pEntrypoints->EmplaceBack(string(shaderName), stage);
 	}
 
+	void VariantPreprocessor::AddMacroQuery(string_view name)
+	{
+		if (pCache != nullptr)
+			macroQueries.emplace(name);
+	}
+
+	bool VariantPreprocessor::TryGetFile(const string& path, string& dst)
+	{
+		includedFiles.emplace(path);
+
+		if (pCache != nullptr)
+			return pCache->TryGetFile(path, dst);
+		else
+			return TryReadFile(path, dst);
+	}
+
+	const std::unordered_set<string>& VariantPreprocessor::GetIncludedFiles() const { return includedFiles; }
+
 	const IDynamicArray<StringSpan>& VariantPreprocessor::GetVariantFlags() const { return variantFlags; }
 
 	const IDynamicArray<StringSpan>& VariantPreprocessor::GetVariantModes() const { return variantModes; }
@@ -181,6 +357,23 @@ namespace Weave::Effects
 	WaveContextPolicy::WaveContextPolicy(VariantPreprocessor & procMain) : pMain(&procMain)
 	{ }
 
+	void WaveContextPolicy::AddMacroQuery(WaveLexToken const& token)
+	{
+		if (pMain != nullptr)
+		{
+			const WaveString& value = token.get_value();
+			pMain->AddMacroQuery(string_view(value.begin(), value.end()));
+		}
+	}
+
+	bool WaveContextPolicy::TryGetFile(const std::string& path, std::string& dst)
+	{
+		if (pMain != nullptr)
+			return pMain->TryGetFile(path, dst);
+		else
+			return TryReadFile(path, dst);
+	}
+
 	template<>
 	bool WaveContextPolicy::interpret_pragma(
 		WaveContext const& ctx,
@@ -0,0 +1,662 @@
+#include "pch.hpp"
+#include "WeaveUtils/Hash.hpp"
+#include "WeaveUtils/LZ4.hpp"
+#include "WeaveEffects/ShaderLibImage.hpp"
+#include "WeaveEffects/ShaderLibBuilder/ShaderRegistryBuilder.hpp"
+
+using namespace Weave;
+using namespace Weave::Effects;
+
+// Image arrays are accessed in place, so their layout is part of the format. Changing any of
+// these requires a version increment.
+static_assert(g_LibImageVersion == 3u && (uint)LibImageSections::Count == 22 && sizeof(LibImageHeader) == 220);
+static_assert(sizeof(ConstDef) == 12 && sizeof(ConstBufDef) == 12 && sizeof(IOElementDef) == 20);
+static_assert(sizeof(ResourceDef) == 24 && sizeof(ShaderDef) == 44 && sizeof(EffectDef) == 8);
+static_assert(sizeof(ShaderVariantDef) == 8 && sizeof(EffectVariantDef) == 8);
+static_assert(sizeof(LibImageRepo) == 48 && sizeof(LibImageVariant) == 24);
+static_assert(sizeof(LibImageHashTable) == 20 && sizeof(PerfectHashSlot) == 8);
+static_assert(std::is_trivially_copyable_v<ResourceDef> && std::is_trivially_copyable_v<ShaderDef>);
+
+namespace
+{
+	/// <summary>
+	/// Appends sections to an image buffer in order
+	/// </summary>
+	class LibImageWriter
+	{
+	public:
+		LibImageWriter(Vector<byte>& dst) :
+			dst(dst)
+		{
+			dst.Clear();
+			dst.Resize(sizeof(LibImageHeader));
+		}
+
+		LibImageHeader& GetHeader() { return *reinterpret_cast<LibImageHeader*>(dst.GetData()); }
+
+		/// <summary>
+		/// Copies an array into a new section. Types with padding are copied member-wise into
+		/// zeroed memory, keeping the output deterministic.
+		/// </summary>
+		template <typename T>
+		void AddSection(LibImageSections section, const T* pSrc, size_t length)
+		{
+			// Pad to alignment with zeroes
+			const size_t start = (dst.GetLength() + g_LibImageAlignment - 1) & ~(size_t)(g_LibImageAlignment - 1);
+			const size_t byteSize = sizeof(T) * length;
+			dst.Resize(start + byteSize);
+
+			GetHeader().sections[(uint)section] = { .start = (uint)start, .length = (uint)length };
+
+			if constexpr (std::has_unique_object_representations_v<T>)
+			{
+				if (byteSize > 0)
+					memcpy(dst.GetData() + start, pSrc, byteSize);
+			}
+			else
+			{
+				T* pDst = reinterpret_cast<T*>(dst.GetData() + start);
+
+				for (size_t i = 0; i < length; i++)
+					CopyMembers(pSrc[i], pDst[i]);
+			}
+		}
+
+		template <typename T>
+		void AddSection(LibImageSections section, const IDynamicArray<T>& src)
+		{
+			AddSection(section, src.GetData(), src.GetLength());
+		}
+
+		void AddSection(LibImageSections section, string_view src)
+		{
+			AddSection(section, src.data(), src.length());
+		}
+
+		void Finalize()
+		{
+			dst.Resize((dst.GetLength() + g_LibImageAlignment - 1) & ~(size_t)(g_LibImageAlignment - 1));
+			FX_CHECK_MSG(dst.GetLength() <= std::numeric_limits<uint>::max(), "Library image exceeds the 4GB size limit");
+
+			LibImageHeader& header = GetHeader();
+			header.magic = g_LibImageMagic;
+			header.version = g_LibImageVersion;
+			header.byteSize = (uint)dst.GetLength();
+		}
+
+	private:
+		Vector<byte>& dst;
+
+		static void CopyMembers(const ResourceDef& src, ResourceDef& dst)
+		{
+			dst.stringID = src.stringID;
+			dst.type = src.type;
+			dst.slot = src.slot;
+		}
+
+		static void CopyMembers(const ShaderDef& src, ShaderDef& dst)
+		{
+			dst.fileStringID = src.fileStringID;
+			dst.byteCodeID = src.byteCodeID;
+			dst.nameID = src.nameID;
+			dst.stage = src.stage;
+			dst.threadGroupSize = src.threadGroupSize;
+			dst.inLayoutID = src.inLayoutID;
+			dst.outLayoutID = src.outLayoutID;
+			dst.resLayoutID = src.resLayoutID;
+			dst.cbufGroupID = src.cbufGroupID;
+		}
+	};
+
+	LibImageSpan AddText(string_view str, string& text)
+	{
+		const LibImageSpan span = { .start = (uint)text.length(), .length = (uint)str.length() };
+		text.append(str);
+		return span;
+	}
+
+	template <typename T>
+	LibImageSpan AddRange(const IDynamicArray<T>& src, Vector<T>& dst)
+	{
+		const LibImageSpan span = { .start = (uint)dst.GetLength(), .length = (uint)src.GetLength() };
+		dst.AddRange(src);
+		return span;
+	}
+
+	/// <summary>
+	/// Generates the perfect hash tables stored in an image. Tables with identical contents are
+	/// only stored once, which is common for variants that differ only in unused flags.
+	/// </summary>
+	class LibImageTableWriter
+	{
+	public:
+		Vector<LibImageHashTable> tables;
+		Vector<uint> displacements;
+		Vector<PerfectHashSlot> slots;
+
+		/// <summary>
+		/// Adds a table mapping integer keys to values and returns its index. Later duplicate
+		/// keys are ignored.
+		/// </summary>
+		uint AddTable(Vector<PerfectHashSlot>& entries)
+		{
+			std::stable_sort(entries.begin(), entries.end(), [](const PerfectHashSlot& a, const PerfectHashSlot& b)
+			{
+				return a.key < b.key;
+			});
+
+			const auto& last = std::unique(entries.begin(), entries.end(), [](const PerfectHashSlot& a, const PerfectHashSlot& b)
+			{
+				return a.key == b.key;
+			});
+			entries.Resize(last - entries.begin());
+
+			keyHashes.Clear();
+
+			for (const PerfectHashSlot& entry : entries)
+				keyHashes.EmplaceBack(PerfectHashTable::GetKeyHash(entry.key));
+
+			return AddTable(entries, keyHashes);
+		}
+
+		/// <summary>
+		/// Adds a table with the given unique key hashes and returns its index
+		/// </summary>
+		uint AddTable(const IDynamicArray<PerfectHashSlot>& entries, const IDynamicArray<ulong>& hashes)
+		{
+			const Hash128 contentHash = GetHash128(hashes, GetHash128(entries).low);
+			const auto& it = tableIDs.find(contentHash);
+
+			if (it != tableIDs.end())
+				return it->second;
+
+			const uint tableID = (uint)tables.GetLength();
+			LibImageHashTable& table = tables.EmplaceBack();
+			table.seed = BuildPerfectHash(std::span(hashes.GetData(), hashes.GetLength()), tableDisplacements, slotIndices);
+			table.displacements = AddRange(tableDisplacements, displacements);
+			table.slots = { .start = (uint)slots.GetLength(), .length = (uint)entries.GetLength() };
+			slots.Resize(slots.GetLength() + entries.GetLength());
+
+			for (uint i = 0; i < entries.GetLength(); i++)
+				slots[table.slots.start + slotIndices[i]] = entries[i];
+
+			tableIDs.emplace(contentHash, tableID);
+			return tableID;
+		}
+
+	private:
+		std::unordered_map<Hash128, uint> tableIDs;
+		Vector<ulong> keyHashes;
+		Vector<uint> tableDisplacements;
+		Vector<uint> slotIndices;
+	};
+
+	/// <summary>
+	/// LZ4 compresses each binary in src into dst. Binaries that don't shrink are stored as-is.
+	/// </summary>
+	void CompressBins(const SpanVector<byte>& src, SpanVector<byte>& dst)
+	{
+		const uint binCount = (uint)(src.spans.GetLength() / 2);
+		dst.spans.Reserve(src.spans.GetLength());
+
+		for (uint i = 0; i < binCount; i++)
+		{
+			const std::span<const byte> rawBin(src.data.GetData() + src.spans[2 * i], src.spans[2 * i + 1]);
+			const size_t start = dst.data.GetLength();
+			CompressLZ4(rawBin, dst.data);
+
+			if ((dst.data.GetLength() - start) >= rawBin.size())
+			{
+				dst.data.Resize(start);
+				dst.data.InsertRange(start, rawBin.begin(), rawBin.end());
+			}
+
+			dst.spans.EmplaceBack((uint)start);
+			dst.spans.EmplaceBack((uint)(dst.data.GetLength() - start));
+		}
+	}
+
+	/// <summary>
+	/// Adds the string -> string ID table
+	/// </summary>
+	uint AddStringTable(const StringIDMapDef::Handle& strings, LibImageTableWriter& tableWriter)
+	{
+		const IDynamicArray<uint>& substrings = *strings.pSubstrings;
+		const uint stringCount = (uint)(substrings.GetLength() / 2);
+		Vector<PerfectHashSlot> entries;
+		Vector<ulong> keyHashes;
+
+		entries.Reserve(stringCount);
+		keyHashes.Reserve(stringCount);
+
+		for (uint id = 0; id < stringCount; id++)
+		{
+			const string_view str(strings.pStringData->data() + substrings[2 * id], substrings[2 * id + 1]);
+			const ulong keyHash = PerfectHashTable::GetKeyHash(str);
+			keyHashes.EmplaceBack(keyHash);
+			entries.EmplaceBack(PerfectHashSlot{ .key = (uint)keyHash, .value = id });
+		}
+
+		return tableWriter.AddTable(entries, keyHashes);
+	}
+}
+
+void Weave::Effects::WriteShaderLibImage(const ShaderLibDef::Handle& def, Vector<byte>& dst, bool isCompressingBins)
+{
+	const IDynamicArray<VariantRepoDef>& repos = *def.pRepos;
+	string text;
+	Vector<LibImageRepo> imgRepos;
+	Vector<LibImageVariant> imgVariants;
+	Vector<uint> repoIDs;
+	Vector<ShaderVariantDef> shaderVariants;
+	Vector<EffectVariantDef> effectVariants;
+	LibImageTableWriter tableWriter;
+	Vector<PerfectHashSlot> entries;
+	const ShaderRegistryDef::Handle& reg = def.regHandle;
+	// Shader and effect name ID -> default vID, last repo wins
+	std::unordered_map<uint, uint> defaultShaders;
+	std::unordered_map<uint, uint> defaultEffects;
+
+	// Flatten nested repo arrays into ranges
+	const LibImageSpan compilerVersion = AddText(def.pPlatform->compilerVersion, text);
+	const LibImageSpan featureLevel = AddText(def.pPlatform->featureLevel, text);
+	imgRepos.Reserve(repos.GetLength());
+
+	for (uint repoIndex = 0; repoIndex < repos.GetLength(); repoIndex++)
+	{
+		const VariantRepoDef& repo = repos[repoIndex];
+		LibImageRepo& imgRepo = imgRepos.EmplaceBack();
+		imgRepo.name = AddText(repo.src.name, text);
+		imgRepo.path = AddText(repo.src.path, text);
+		imgRepo.flagIDs = AddRange(repo.flagIDs, repoIDs);
+		imgRepo.modeIDs = AddRange(repo.modeIDs, repoIDs);
+		imgRepo.variants = { .start = (uint)imgVariants.GetLength(), .length = (uint)repo.variants.GetLength() };
+
+		// Flag name -> flag bit
+		entries.Clear();
+
+		for (uint i = 0; i < repo.flagIDs.GetLength(); i++)
+			entries.EmplaceBack(PerfectHashSlot{ .key = repo.flagIDs[i], .value = 1u << i });
+
+		imgRepo.flagTable = tableWriter.AddTable(entries);
+
+		// Mode name -> modeID
+		entries.Clear();
+
+		for (uint i = 0; i < repo.modeIDs.GetLength(); i++)
+			entries.EmplaceBack(PerfectHashSlot{ .key = repo.modeIDs[i], .value = i });
+
+		imgRepo.modeTable = tableWriter.AddTable(entries);
+
+		for (const VariantDef& variant : repo.variants)
+		{
+			LibImageVariant& imgVariant = imgVariants.EmplaceBack(LibImageVariant
+			{
+				.effects = AddRange(variant.effects, effectVariants),
+				.shaders = AddRange(variant.shaders, shaderVariants)
+			});
+
+			// Effect name -> effectID
+			entries.Clear();
+
+			for (const EffectVariantDef& effect : variant.effects)
+			{
+				const uint nameID = (*reg.pEffects)[ShaderRegistryBuilder::GetIndex(effect.effectID)].nameID;
+				entries.EmplaceBack(PerfectHashSlot{ .key = nameID, .value = effect.effectID });
+			}
+
+			imgVariant.effectTable = tableWriter.AddTable(entries);
+
+			// Shader name -> shaderID
+			entries.Clear();
+
+			for (const ShaderVariantDef& shader : variant.shaders)
+			{
+				const uint nameID = (*reg.pShaders)[ShaderRegistryBuilder::GetIndex(shader.shaderID)].nameID;
+				entries.EmplaceBack(PerfectHashSlot{ .key = nameID, .value = shader.shaderID });
+			}
+
+			imgVariant.shaderTable = tableWriter.AddTable(entries);
+		}
+
+		// Default variants use the base configuration of the last repo defining each name
+		const uint baseID = (repoIndex << g_VariantGroupOffset);
+		const VariantDef& baseVariant = repo.variants[0];
+
+		for (const ShaderVariantDef& shader : baseVariant.shaders)
+			defaultShaders[(*reg.pShaders)[ShaderRegistryBuilder::GetIndex(shader.shaderID)].nameID] = baseID;
+
+		for (const EffectVariantDef& effect : baseVariant.effects)
+			defaultEffects[(*reg.pEffects)[ShaderRegistryBuilder::GetIndex(effect.effectID)].nameID] = baseID;
+	}
+
+	entries.Clear();
+
+	for (const auto& [nameID, vID] : defaultShaders)
+		entries.EmplaceBack(PerfectHashSlot{ .key = nameID, .value = vID });
+
+	const uint defaultShaderTable = tableWriter.AddTable(entries);
+	entries.Clear();
+
+	for (const auto& [nameID, vID] : defaultEffects)
+		entries.EmplaceBack(PerfectHashSlot{ .key = nameID, .value = vID });
+
+	const uint defaultEffectTable = tableWriter.AddTable(entries);
+	const uint stringTable = AddStringTable(def.strMapHandle, tableWriter);
+
+	// Raw sizes are stored for every binary, so compressed binaries are identified by a
+	// stored length mismatch
+	const SpanVector<byte>& rawBins = *reg.pBinSpans;
+	SpanVector<byte> compressedBins;
+	Vector<uint> binRawSizes;
+	binRawSizes.Reserve(rawBins.spans.GetLength() / 2);
+
+	for (uint i = 1; i < rawBins.spans.GetLength(); i += 2)
+		binRawSizes.EmplaceBack(rawBins.spans[i]);
+
+	if (isCompressingBins)
+		CompressBins(rawBins, compressedBins);
+
+	const SpanVector<byte>& bins = isCompressingBins ? compressedBins : rawBins;
+
+	LibImageWriter writer(dst);
+
+	writer.AddSection(LibImageSections::Text, text);
+	writer.AddSection(LibImageSections::StringSpans, *def.strMapHandle.pSubstrings);
+	writer.AddSection(LibImageSections::StringData, *def.strMapHandle.pStringData);
+	writer.AddSection(LibImageSections::Constants, *reg.pConstants);
+	writer.AddSection(LibImageSections::CBufDefs, *reg.pCBufDefs);
+	writer.AddSection(LibImageSections::IOElements, *reg.pIOElements);
+	writer.AddSection(LibImageSections::Resources, *reg.pResources);
+	writer.AddSection(LibImageSections::Shaders, *reg.pShaders);
+	writer.AddSection(LibImageSections::Effects, *reg.pEffects);
+	writer.AddSection(LibImageSections::IDGroupSpans, reg.pIDGroups->spans);
+	writer.AddSection(LibImageSections::IDGroupData, reg.pIDGroups->data);
+	writer.AddSection(LibImageSections::BinSpans, bins.spans);
+	writer.AddSection(LibImageSections::BinData, bins.data);
+	writer.AddSection(LibImageSections::BinRawSizes, binRawSizes);
+	writer.AddSection(LibImageSections::Repos, imgRepos);
+	writer.AddSection(LibImageSections::Variants, imgVariants);
+	writer.AddSection(LibImageSections::RepoIDs, repoIDs);
+	writer.AddSection(LibImageSections::ShaderVariants, shaderVariants);
+	writer.AddSection(LibImageSections::EffectVariants, effectVariants);
+	writer.AddSection(LibImageSections::HashTables, tableWriter.tables);
+	writer.AddSection(LibImageSections::HashDisplacements, tableWriter.displacements);
+	writer.AddSection(LibImageSections::HashSlots, tableWriter.slots);
+
+	LibImageHeader& header = writer.GetHeader();
+	header.target = (uint)def.pPlatform->target;
+	header.compilerVersion = compilerVersion;
+	header.featureLevel = featureLevel;
+	header.stringTable = stringTable;
+	header.shaderTable = defaultShaderTable;
+	header.effectTable = defaultEffectTable;
+
+	writer.Finalize();
+}
+
+ShaderLibImage::ShaderLibImage() :
+	pHeader(nullptr)
+{ }
+
+ShaderLibImage::ShaderLibImage(string_view data) :
+	pHeader(reinterpret_cast<const LibImageHeader*>(data.data())),
+	data(data)
+{
+	FX_CHECK_MSG(GetIsImage(data), "Shader library image header invalid");
+	FX_CHECK_MSG(((uintptr_t)data.data() % g_LibImageAlignment) == 0,
+		"Shader library image must be {}-byte aligned", g_LibImageAlignment);
+	FX_CHECK_MSG(pHeader->version == g_LibImageVersion,
+		"Shader library image version {} unsupported. Expected {}.", pHeader->version, g_LibImageVersion);
+	FX_CHECK_MSG(pHeader->byteSize >= sizeof(LibImageHeader) && pHeader->byteSize <= data.length(),
+		"Shader library image truncated");
+
+	// Trailing padding from header arrays is excluded
+	this->data = data.substr(0, pHeader->byteSize);
+
+	ValidateSection<char>(LibImageSections::Text);
+	ValidateSection<uint>(LibImageSections::StringSpans);
+	ValidateSection<char>(LibImageSections::StringData);
+	ValidateSection<ConstDef>(LibImageSections::Constants);
+	ValidateSection<ConstBufDef>(LibImageSections::CBufDefs);
+	ValidateSection<IOElementDef>(LibImageSections::IOElements);
+	ValidateSection<ResourceDef>(LibImageSections::Resources);
+	ValidateSection<ShaderDef>(LibImageSections::Shaders);
+	ValidateSection<EffectDef>(LibImageSections::Effects);
+	ValidateSection<uint>(LibImageSections::IDGroupSpans);
+	ValidateSection<uint>(LibImageSections::IDGroupData);
+	ValidateSection<uint>(LibImageSections::BinSpans);
+	ValidateSection<byte>(LibImageSections::BinData);
+	ValidateSection<uint>(LibImageSections::BinRawSizes);
+	ValidateSection<LibImageRepo>(LibImageSections::Repos);
+	ValidateSection<LibImageVariant>(LibImageSections::Variants);
+	ValidateSection<uint>(LibImageSections::RepoIDs);
+	ValidateSection<ShaderVariantDef>(LibImageSections::ShaderVariants);
+	ValidateSection<EffectVariantDef>(LibImageSections::EffectVariants);
+	ValidateSection<LibImageHashTable>(LibImageSections::HashTables);
+	ValidateSection<uint>(LibImageSections::HashDisplacements);
+	ValidateSection<PerfectHashSlot>(LibImageSections::HashSlots);
+
+	ValidateSpans(LibImageSections::StringSpans, pHeader->sections[(uint)LibImageSections::StringData].length);
+	ValidateSpans(LibImageSections::IDGroupSpans, pHeader->sections[(uint)LibImageSections::IDGroupData].length);
+	ValidateSpans(LibImageSections::BinSpans, pHeader->sections[(uint)LibImageSections::BinData].length);
+	FX_CHECK_MSG(pHeader->sections[(uint)LibImageSections::BinRawSizes].length == GetBinCount(),
+		"Shader library image binary sizes invalid");
+
+	// Ranges referenced by repos and variants
+	const size_t textLength = pHeader->sections[(uint)LibImageSections::Text].length;
+	const size_t variantCount = pHeader->sections[(uint)LibImageSections::Variants].length;
+	const size_t repoIDCount = pHeader->sections[(uint)LibImageSections::RepoIDs].length;
+	const size_t shaderCount = pHeader->sections[(uint)LibImageSections::ShaderVariants].length;
+	const size_t effectCount = pHeader->sections[(uint)LibImageSections::EffectVariants].length;
+
+	ValidateRange(pHeader->compilerVersion, textLength);
+	ValidateRange(pHeader->featureLevel, textLength);
+	ValidateHashTable(pHeader->stringTable);
+	ValidateHashTable(pHeader->shaderTable);
+	ValidateHashTable(pHeader->effectTable);
+
+	// String lookups dereference the IDs stored in the table
+	const uint stringCount = pHeader->sections[(uint)LibImageSections::StringSpans].length / 2;
+
+	for (const PerfectHashSlot& slot : GetHashTable(pHeader->stringTable).GetSlots())
+		FX_CHECK_MSG(slot.value < stringCount, "Shader library image string table invalid");
+
+	for (const LibImageRepo& repo : GetSection<LibImageRepo>(LibImageSections::Repos))
+	{
+		ValidateRange(repo.name, textLength);
+		ValidateRange(repo.path, textLength);
+		ValidateRange(repo.flagIDs, repoIDCount);
+		ValidateRange(repo.modeIDs, repoIDCount);
+		ValidateRange(repo.variants, variantCount);
+		FX_CHECK_MSG(repo.variants.length > 0 && repo.variants.length <= (g_VariantMask + 1),
+			"Shader library image repo variant count invalid");
+		ValidateHashTable(repo.flagTable);
+		ValidateHashTable(repo.modeTable);
+	}
+
+	for (const LibImageVariant& variant : GetSection<LibImageVariant>(LibImageSections::Variants))
+	{
+		ValidateRange(variant.effects, effectCount);
+		ValidateRange(variant.shaders, shaderCount);
+		ValidateHashTable(variant.effectTable);
+		ValidateHashTable(variant.shaderTable);
+	}
+}
+
+bool ShaderLibImage::GetIsImage(string_view data)
+{
+	uint magic;
+
+	if (data.length() < sizeof(LibImageHeader))
+		return false;
+
+	memcpy(&magic, data.data(), sizeof(uint));
+	return magic == g_LibImageMagic;
+}
+
+string_view ShaderLibImage::GetData() const { return data; }
+
+PlatformDef ShaderLibImage::GetPlatform() const
+{
+	return PlatformDef
+	{
+		.compilerVersion = string(GetText(pHeader->compilerVersion)),
+		.featureLevel = string(GetText(pHeader->featureLevel)),
+		.target = (PlatformTargets)pHeader->target
+	};
+}
+
+uint ShaderLibImage::GetRepoCount() const
+{
+	return (pHeader != nullptr) ? pHeader->sections[(uint)LibImageSections::Repos].length : 0u;
+}
+
+string_view ShaderLibImage::GetRepoName(uint repoIndex) const { return GetText(GetRepo(repoIndex).name); }
+
+string_view ShaderLibImage::GetRepoPath(uint repoIndex) const { return GetText(GetRepo(repoIndex).path); }
+
+std::span<const uint> ShaderLibImage::GetFlagIDs(uint repoIndex) const
+{
+	const LibImageSpan& span = GetRepo(repoIndex).flagIDs;
+	return GetSection<uint>(LibImageSections::RepoIDs).subspan(span.start, span.length);
+}
+
+std::span<const uint> ShaderLibImage::GetModeIDs(uint repoIndex) const
+{
+	const LibImageSpan& span = GetRepo(repoIndex).modeIDs;
+	return GetSection<uint>(LibImageSections::RepoIDs).subspan(span.start, span.length);
+}
+
+uint ShaderLibImage::GetVariantCount(uint repoIndex) const { return GetRepo(repoIndex).variants.length; }
+
+std::span<const ShaderVariantDef> ShaderLibImage::GetShaderVariants(uint repoIndex, uint configID) const
+{
+	const LibImageSpan& span = GetVariant(repoIndex, configID).shaders;
+	return GetSection<ShaderVariantDef>(LibImageSections::ShaderVariants).subspan(span.start, span.length);
+}
+
+std::span<const EffectVariantDef> ShaderLibImage::GetEffectVariants(uint repoIndex, uint configID) const
+{
+	const LibImageSpan& span = GetVariant(repoIndex, configID).effects;
+	return GetSection<EffectVariantDef>(LibImageSections::EffectVariants).subspan(span.start, span.length);
+}
+
+uint ShaderLibImage::GetBinCount() const
+{
+	return (pHeader != nullptr) ? pHeader->sections[(uint)LibImageSections::BinSpans].length / 2 : 0u;
+}
+
+std::span<const byte> ShaderLibImage::GetBin(uint binIndex) const
+{
+	FX_ASSERT_MSG(binIndex < GetBinCount(), "Shader binary index out of range");
+	const std::span<const uint> spans = GetSection<uint>(LibImageSections::BinSpans);
+	return GetSection<byte>(LibImageSections::BinData).subspan(spans[2 * binIndex], spans[2 * binIndex + 1]);
+}
+
+uint ShaderLibImage::GetBinRawSize(uint binIndex) const
+{
+	FX_ASSERT_MSG(binIndex < GetBinCount(), "Shader binary index out of range");
+	return GetSection<uint>(LibImageSections::BinRawSizes)[binIndex];
+}
+
+bool ShaderLibImage::GetIsBinCompressed(uint binIndex) const
+{
+	return GetBin(binIndex).size() != GetBinRawSize(binIndex);
+}
+
+void ShaderLibImage::GetDecompressedBin(uint binIndex, Vector<byte>& dst) const
+{
+	const std::span<const byte> bin = GetBin(binIndex);
+	dst.Clear();
+	dst.Resize(GetBinRawSize(binIndex));
+
+	if (GetIsBinCompressed(binIndex))
+		DecompressLZ4(bin, std::span<byte>(dst.GetData(), dst.GetLength()));
+	else if (!bin.empty())
+		memcpy(dst.GetData(), bin.data(), bin.size());
+}
+
+PerfectHashTable ShaderLibImage::GetStringTable() const { return GetHashTable(pHeader->stringTable); }
+
+PerfectHashTable ShaderLibImage::GetDefaultShaderTable() const { return GetHashTable(pHeader->shaderTable); }
+
+PerfectHashTable ShaderLibImage::GetDefaultEffectTable() const { return GetHashTable(pHeader->effectTable); }
+
+PerfectHashTable ShaderLibImage::GetFlagTable(uint repoIndex) const { return GetHashTable(GetRepo(repoIndex).flagTable); }
+
+PerfectHashTable ShaderLibImage::GetModeTable(uint repoIndex) const { return GetHashTable(GetRepo(repoIndex).modeTable); }
+
+PerfectHashTable ShaderLibImage::GetShaderTable(uint repoIndex, uint configID) const
+{
+	return GetHashTable(GetVariant(repoIndex, configID).shaderTable);
+}
+
+PerfectHashTable ShaderLibImage::GetEffectTable(uint repoIndex, uint configID) const
+{
+	return GetHashTable(GetVariant(repoIndex, configID).effectTable);
+}
+
+string_view ShaderLibImage::GetText(const LibImageSpan& span) const
+{
+	return string_view(GetSection<char>(LibImageSections::Text).data() + span.start, span.length);
+}
+
+const LibImageRepo& ShaderLibImage::GetRepo(uint repoIndex) const
+{
+	FX_ASSERT_MSG(repoIndex < GetRepoCount(), "Repo index out of range");
+	return GetSection<LibImageRepo>(LibImageSections::Repos)[repoIndex];
+}
+
+const LibImageVariant& ShaderLibImage::GetVariant(uint repoIndex, uint configID) const
+{
+	const LibImageSpan& variants = GetRepo(repoIndex).variants;
+	FX_ASSERT_MSG(configID < variants.length, "Variant config ID out of range");
+	return GetSection<LibImageVariant>(LibImageSections::Variants)[variants.start + configID];
+}
+
+PerfectHashTable ShaderLibImage::GetHashTable(uint tableIndex) const
+{
+	const LibImageHashTable& table = GetSection<LibImageHashTable>(LibImageSections::HashTables)[tableIndex];
+	return PerfectHashTable(table.seed,
+		GetSection<uint>(LibImageSections::HashDisplacements).subspan(table.displacements.start, table.displacements.length),
+		GetSection<PerfectHashSlot>(LibImageSections::HashSlots).subspan(table.slots.start, table.slots.length)
+	);
+}
+
+template <typename T>
+void ShaderLibImage::ValidateSection(LibImageSections section) const
+{
+	const LibImageSpan& span = pHeader->sections[(uint)section];
+	FX_CHECK_MSG(span.start >= sizeof(LibImageHeader) && (span.start % g_LibImageAlignment) == 0,
+		"Shader library image section {} misaligned", (uint)section);
+	FX_CHECK_MSG(span.start <= data.length() && span.length <= (data.length() - span.start) / sizeof(T),
+		"Shader library image section {} out of bounds", (uint)section);
+}
+
+void ShaderLibImage::ValidateRange(const LibImageSpan& span, size_t length)
+{
+	FX_CHECK_MSG(span.start <= length && span.length <= (length - span.start),
+		"Shader library image range out of bounds");
+}
+
+void ShaderLibImage::ValidateSpans(LibImageSections spanSection, size_t dataLength) const
+{
+	const std::span<const uint> spans = GetSection<uint>(spanSection);
+	FX_CHECK_MSG((spans.size() % 2) == 0, "Shader library image section {} invalid", (uint)spanSection);
+
+	for (size_t i = 0; i < spans.size(); i += 2)
+		ValidateRange(LibImageSpan{ .start = spans[i], .length = spans[i + 1] }, dataLength);
+}
+
+void ShaderLibImage::ValidateHashTable(uint tableIndex) const
+{
+	const std::span<const LibImageHashTable> tables = GetSection<LibImageHashTable>(LibImageSections::HashTables);
+	FX_CHECK_MSG(tableIndex < tables.size(), "Shader library image hash table index out of bounds");
+
+	const LibImageHashTable& table = tables[tableIndex];
+	ValidateRange(table.displacements, pHeader->sections[(uint)LibImageSections::HashDisplacements].length);
+	ValidateRange(table.slots, pHeader->sections[(uint)LibImageSections::HashSlots].length);
+	FX_CHECK_MSG(table.slots.length == 0 || table.displacements.length > 0,
+		"Shader library image hash table invalid");
+}
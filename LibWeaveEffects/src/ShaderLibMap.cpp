@@ -50,96 +50,32 @@ ShaderLibMap::~ShaderLibMap() = default;
 
 const StringIDMap& ShaderLibMap::GetStringMap() const { return pRegMap->GetStringMap(); }
 
-ShaderLibMap::ShaderLibMap(const ShaderLibDef& def) :
-	platform(def.platform),
-	variantShaderMaps(def.repos.GetLength()),
-	variantFlagMaps(def.repos.GetLength()),
-	variantModeMaps(def.repos.GetLength()),
-	variantRepos(def.repos),
-	pRegMap(new ShaderRegistryMap(def.stringIDs, def.regData))
+ShaderLibMap::ShaderLibMap(const ShaderLibDef& def)
 {
-	InitMaps();
+	WriteShaderLibImage(def.GetHandle(), imageBuf);
+	Init(string_view(reinterpret_cast<const char*>(imageBuf.GetData()), imageBuf.GetLength()));
 }
 
 ShaderLibMap::ShaderLibMap(ShaderLibDef&& def) :
-	platform(std::move(def.platform)),
-	variantShaderMaps(def.repos.GetLength()),
-	variantFlagMaps(def.repos.GetLength()),
-	variantModeMaps(def.repos.GetLength()),
-	variantRepos(std::move(def.repos)),
-	pRegMap(new ShaderRegistryMap(std::move(def.stringIDs), std::move(def.regData)))
+	ShaderLibMap(static_cast<const ShaderLibDef&>(def))
+{ }
+
+ShaderLibMap::ShaderLibMap(const ShaderLibImage& image)
 {
-	InitMaps();
+	Init(image.GetData());
 }
 
-void ShaderLibMap::InitMaps()
+ShaderLibMap::ShaderLibMap(MappedFile&& file) :
+	mappedFile(std::move(file))
 {
-	const uint groupCount = (uint)variantRepos.GetLength();
+	Init(mappedFile.GetData());
+}
 
-	for (uint repoIndex = 0; repoIndex < groupCount; repoIndex++)
-	{
-		const VariantRepoDef& repoDef = variantRepos[repoIndex];
-		// map[repoIndex][nameID] -> flag/modeID
-		NameIndexMap& flagNameMap = variantFlagMaps[repoIndex];
-		NameIndexMap& modeNameMap = variantModeMaps[repoIndex];
-
-		// Shader flags
-		for (uint i = 0; i < repoDef.flagIDs.GetLength(); i++)
-		{
-			const uint flagID = 1u << i;
-			flagNameMap.emplace(repoDef.flagIDs[i], flagID);
-		}
-
-		// Shader modes
-		for (uint i = 0; i < repoDef.modeIDs.GetLength(); i++)
-			modeNameMap.emplace(repoDef.modeIDs[i], i);
-
-		// Default global name -> variant mapping
-		// sharedVariantMap[nameID] -> vID
-		const VariantDef& baseVariant = repoDef.variants[0];
-		const uint baseID = PackVariantID(repoIndex, 0);
-
-		// Shaders
-		for (const ShaderVariantDef& varShaderPair : baseVariant.shaders)
-		{
-			const ShaderDef& shader = pRegMap->GetShader(varShaderPair.shaderID);
-			sharedVariantMap.shaders[shader.nameID] = baseID;
-		}
-
-		// Effects
-		for (const EffectVariantDef& varEffectPair : baseVariant.effects)
-		{
-			const EffectDef& effect = pRegMap->GetEffect(varEffectPair.effectID);
-			sharedVariantMap.effects[effect.nameID] = baseID;
-		}
-
-		// vID ~= (repoIndex << 16) | flagID
-		// variantMap[repoIndex][flagID][nameID] -> shader/effectID
-		UniqueArray<VariantNameMap>& variantMap = variantShaderMaps[repoIndex];
-		variantMap = UniqueArray<VariantNameMap>(repoDef.variants.GetLength());
-
-		for (uint flagID = 0; flagID < repoDef.variants.GetLength(); flagID++)
-		{
-			const VariantDef& variant = repoDef.variants[flagID];
-			variantMap[flagID] = VariantNameMap();
-
-			// Shaders
-			for (const ShaderVariantDef& varShaderPair : variant.shaders)
-			{
-				const ShaderDef& shader = pRegMap->GetShader(varShaderPair.shaderID);
-				NameIndexMap& map = variantMap[flagID].shaders;
-				map.emplace(shader.nameID, varShaderPair.shaderID);
-			}
-
-			// Effects
-			for (const EffectVariantDef& varEffectPair : variant.effects)
-			{
-				const EffectDef& effect = pRegMap->GetEffect(varEffectPair.effectID);
-				NameIndexMap& map = variantMap[flagID].effects;
-				map.emplace(effect.nameID, varEffectPair.effectID);
-			}
-		}
-	}
+void ShaderLibMap::Init(string_view imageData)
+{
+	image = ShaderLibImage(imageData);
+	platform = image.GetPlatform();
+	pRegMap.reset(new ShaderRegistryMap(image));
 }
 
 ShaderDefHandle ShaderLibMap::GetShader(uint shaderID) const
@@ -157,23 +93,13 @@ EffectDefHandle ShaderLibMap::GetEffect(uint effectID) const
 uint ShaderLibMap::TryGetDefaultShaderVariant(uint nameID) const
 {
 	FX_CHECK_MSG(nameID != -1, "Name ID invalid");
-	const auto& it = sharedVariantMap.shaders.find(nameID);
-
-	if (it != sharedVariantMap.shaders.end())
-		return it->second;
-	else
-		return -1;
+	return image.GetDefaultShaderTable().TryGetValue(nameID);
 }
 
 uint ShaderLibMap::TryGetDefaultEffectVariant(uint nameID) const
 {
 	FX_CHECK_MSG(nameID != -1, "Name ID invalid");
-	const auto& it = sharedVariantMap.effects.find(nameID);
-
-	if (it != sharedVariantMap.effects.end())
-		return it->second;
-	else
-		return -1;
+	return image.GetDefaultEffectTable().TryGetValue(nameID);
 }
 
 uint ShaderLibMap::TryGetShaderID(uint nameID, uint vID) const 
@@ -181,18 +107,9 @@ uint ShaderLibMap::TryGetShaderID(uint nameID, uint vID) const
 	FX_CHECK_MSG(vID != -1 && nameID != -1, "Specified shader invalid");
 	const uint repoIndex = GetRepoIndex(vID);
 	const uint cfgIndex = GetConfigIndex(vID);
-	FX_CHECK_MSG(repoIndex >= 0 && cfgIndex >= 0
-		&& repoIndex < variantShaderMaps.GetLength() 
-		&& cfgIndex < variantShaderMaps[repoIndex].GetLength(),
-	"Shader variant ID invalid");
-
-	const NameIndexMap& nameMap = variantShaderMaps[repoIndex][cfgIndex].shaders;
-	const auto& it = nameMap.find(nameID);
+	FX_CHECK_MSG(GetIsValid(repoIndex, cfgIndex), "Shader variant ID invalid");
 
-	if (it != nameMap.end())
-		return it->second;
-	else
-		return -1;
+	return image.GetShaderTable(repoIndex, cfgIndex).TryGetValue(nameID);
 }
 
 uint ShaderLibMap::TryGetEffectID(uint nameID, uint vID) const 
@@ -200,33 +117,18 @@ uint ShaderLibMap::TryGetEffectID(uint nameID, uint vID) const
 	FX_CHECK_MSG(vID != -1 && nameID != -1, "Specified effect invalid");
 	const uint repoIndex = GetRepoIndex(vID);
 	const uint cfgIndex = GetConfigIndex(vID);
-	FX_CHECK_MSG(repoIndex >= 0 && cfgIndex >= 0
-		&& repoIndex < variantShaderMaps.GetLength()
-		&& cfgIndex < variantShaderMaps[repoIndex].GetLength(),
-		"Effect variant ID invalid");
-
-	const NameIndexMap& nameMap = variantShaderMaps[repoIndex][cfgIndex].effects;
-	const auto& it = nameMap.find(nameID);
+	FX_CHECK_MSG(GetIsValid(repoIndex, cfgIndex), "Effect variant ID invalid");
 
-	if (it != nameMap.end())
-		return it->second;
-	else
-		return -1;
+	return image.GetEffectTable(repoIndex, cfgIndex).TryGetValue(nameID);
 }
 
 uint ShaderLibMap::TryGetModeID(uint nameID, uint vID) const 
 {
 	FX_CHECK_MSG(vID != -1 && nameID != -1, "Specified mode invalid");
 	const uint repoIndex = GetRepoIndex(vID);
-	FX_CHECK_MSG(repoIndex >= 0 && repoIndex < variantShaderMaps.GetLength(), "Mode variant ID invalid");
+	FX_CHECK_MSG(repoIndex < image.GetRepoCount(), "Mode variant ID invalid");
 
-	const NameIndexMap& modeMap = variantModeMaps[repoIndex];
-	const auto& it = modeMap.find(nameID);
-
-	if (it != modeMap.end())
-		return it->second;
-	else
-		return -1;
+	return image.GetModeTable(repoIndex).TryGetValue(nameID);
 }
 
 uint ShaderLibMap::TryGetFlags(const std::initializer_list<string_view>& defines, uint vID) const { return TryGetFlags(defines.begin(), defines.end(), vID); }
@@ -241,15 +143,9 @@ uint ShaderLibMap::TryGetFlag(uint nameID, uint vID) const
 {
 	FX_CHECK_MSG(vID != -1 && nameID != -1, "Specified flag invalid");
 	const uint repoIndex = GetRepoIndex(vID);
-	FX_CHECK_MSG(repoIndex >= 0 && repoIndex < variantShaderMaps.GetLength(), "Flag variant ID invalid");
+	FX_CHECK_MSG(repoIndex < image.GetRepoCount(), "Flag variant ID invalid");
 
-	const NameIndexMap& flagMap = variantFlagMaps[repoIndex];
-	const auto& it = flagMap.find(nameID);
-
-	if (it != flagMap.end())
-		return it->second;
-	else
-		return -1;
+	return image.GetFlagTable(repoIndex).TryGetValue(nameID);
 }
 
 bool ShaderLibMap::GetIsDefined(uint nameID, uint vID) const 
@@ -258,21 +154,20 @@ bool ShaderLibMap::GetIsDefined(uint nameID, uint vID) const
 	FX_CHECK_MSG(vID != -1, "Variant ID invalid");
 	const uint repoIndex = GetRepoIndex(vID);
 	const uint cfgIndex = GetConfigIndex(vID);
-	const auto& flagIt = variantFlagMaps[repoIndex].find(nameID);
+	const uint flag = image.GetFlagTable(repoIndex).TryGetValue(nameID);
 	
-	if (flagIt != variantFlagMaps[repoIndex].end())
+	if (flag != -1)
 	{
 		const uint flags = GetConfigFlags(cfgIndex, GetFlagVariantCount(repoIndex));
-		const uint flag = flagIt->second;
 		return (flags & flag) == flag;
 	}
 	else
 	{
 		const uint mode = GetModeIndex(repoIndex, cfgIndex);
-		const auto& modeIt = variantModeMaps[repoIndex].find(nameID);
+		const uint modeID = image.GetModeTable(repoIndex).TryGetValue(nameID);
 
-		if (modeIt != variantModeMaps[repoIndex].end())
-			return mode == modeIt->second;
+		if (modeID != -1)
+			return mode == modeID;
 		else
 			return false;
 	}
@@ -294,8 +189,8 @@ void ShaderLibMap::GetDefines(uint vID, Vector<uint>& defines) const
 	const uint repoIndex = GetRepoIndex(vID);
 	const uint configIndex = GetConfigIndex(vID);
 	const uint modeID = GetModeIndex(repoIndex, configIndex);
-	const IDynamicArray<uint>& modeIDs = variantRepos[repoIndex].modeIDs;
-	const IDynamicArray<uint>& flagIDs = variantRepos[repoIndex].flagIDs;
+	const std::span<const uint> modeIDs = image.GetModeIDs(repoIndex);
+	const std::span<const uint> flagIDs = image.GetFlagIDs(repoIndex);
 	uint flagID = GetFlags(repoIndex, configIndex);
 
 	if (modeID != 0)
@@ -319,8 +214,8 @@ void ShaderLibMap::GetDefines(uint vID, Vector<string_view>& defines) const
 	const uint repoIndex = GetRepoIndex(vID);
 	const uint configIndex = GetConfigIndex(vID);
 	const uint modeID = GetModeIndex(repoIndex, configIndex);
-	const IDynamicArray<uint>& modeIDs = variantRepos[repoIndex].modeIDs;
-	const IDynamicArray<uint>& flagIDs = variantRepos[repoIndex].flagIDs;
+	const std::span<const uint> modeIDs = image.GetModeIDs(repoIndex);
+	const std::span<const uint> flagIDs = image.GetFlagIDs(repoIndex);
 	uint flagID = GetFlags(repoIndex, configIndex);
 
 	if (modeID != 0)
@@ -396,25 +291,30 @@ uint ShaderLibMap::GetShaderCount(uint vID) const
 {
 	const uint repoIndex = GetRepoIndex(vID);
 	const uint configIndex = GetConfigIndex(vID);
-	return (uint)variantRepos[repoIndex].variants[configIndex].shaders.GetLength();
+	return (uint)image.GetShaderVariants(repoIndex, configIndex).size();
 }
 
 uint ShaderLibMap::GetEffectCount(uint vID) const 
 {
 	const uint repoIndex = GetRepoIndex(vID);
 	const uint configIndex = GetConfigIndex(vID);
-	return (uint)variantRepos[repoIndex].variants[configIndex].effects.GetLength();
+	return (uint)image.GetEffectVariants(repoIndex, configIndex).size();
+}
+
+bool ShaderLibMap::GetIsValid(uint repoIndex, uint configIndex) const
+{
+	return repoIndex < image.GetRepoCount() && configIndex < image.GetVariantCount(repoIndex);
 }
 
 uint ShaderLibMap::GetFlagVariantCount(uint repoIndex) const
 {
-	const uint flagCount = (uint)variantRepos[repoIndex].flagIDs.GetLength();
+	const uint flagCount = (uint)image.GetFlagIDs(repoIndex).size();
 	return 1u << flagCount;
 }
 
 uint ShaderLibMap::GetModeCount(uint repoIndex) const
 {
-	const uint modeCount = (uint)variantRepos[repoIndex].modeIDs.GetLength();
+	const uint modeCount = (uint)image.GetModeIDs(repoIndex).size();
 	return modeCount;
 }
 
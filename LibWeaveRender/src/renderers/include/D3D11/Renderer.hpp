@@ -201,6 +201,17 @@ namespace Weave::D3D11
 		/// </summary>
 		ShaderLibrary CreateShaderLibrary(ShaderLibDef&& def);
 
+		/// <summary>
+		/// Creates a shader library using the given flat library image in place. The image
+		/// must outlive the library.
+		/// </summary>
+		ShaderLibrary CreateShaderLibrary(const ShaderLibImage& image);
+
+		/// <summary>
+		/// Creates a shader library from a memory mapped library image file
+		/// </summary>
+		ShaderLibrary CreateShaderLibrary(MappedFile&& file);
+
 		/// <summary>
 		/// Returns reference to a default material
 		/// </summary>
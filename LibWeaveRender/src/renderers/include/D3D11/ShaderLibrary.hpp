@@ -6,6 +6,7 @@
 namespace Weave::D3D11
 {
 	using Effects::ShaderLibDef;
+	using Effects::ShaderLibImage;
 
 	class Renderer;
 	class ShaderVariantManager;
@@ -21,6 +22,10 @@ namespace Weave::D3D11
 
 		ShaderLibrary(Renderer& renderer, ShaderLibDef&& def);
 
+		ShaderLibrary(Renderer& renderer, const ShaderLibImage& image);
+
+		ShaderLibrary(Renderer& renderer, MappedFile&& file);
+
 		/// <summary>
 		/// Retrieves interface for querying string IDs used in library resources
 		/// </summary>
@@ -7,6 +7,7 @@ namespace Weave::D3D11
 {
 	using Effects::ShaderLibDef;
 	using Effects::ShaderLibMap;
+	using Effects::ShaderLibImage;
 	using Effects::ShadeStages;
 	using Effects::EffectDef;
 
@@ -21,6 +22,10 @@ namespace Weave::D3D11
 
 		ShaderVariantManager(Device& device, ShaderLibDef&& def);
 
+		ShaderVariantManager(Device& device, const ShaderLibImage& image);
+
+		ShaderVariantManager(Device& device, MappedFile&& file);
+
 		/// <summary>
 		/// Retrieves interface for querying string IDs used in library resources
 		/// </summary>
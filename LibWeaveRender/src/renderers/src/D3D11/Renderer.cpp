@@ -93,6 +93,10 @@ ShaderLibrary Renderer::CreateShaderLibrary(const ShaderLibDef& def) { return Sh
 
 ShaderLibrary Renderer::CreateShaderLibrary(ShaderLibDef&& def) { return ShaderLibrary(*this, std::move(def)); }
 
+ShaderLibrary Renderer::CreateShaderLibrary(const ShaderLibImage& image) { return ShaderLibrary(*this, image); }
+
+ShaderLibrary Renderer::CreateShaderLibrary(MappedFile&& file) { return ShaderLibrary(*this, std::move(file)); }
+
 uivec2 Renderer::GetOutputResolution() const { return outputRes; }
 
 void Renderer::SetOutputResolution(ivec2 res) 
@@ -21,6 +21,14 @@ ShaderLibrary::ShaderLibrary(Renderer& renderer, ShaderLibDef&& def) :
 	pManager(new ShaderVariantManager(renderer.GetDevice(), std::move(def)))
 { }
 
+ShaderLibrary::ShaderLibrary(Renderer& renderer, const ShaderLibImage& image) :
+	pManager(new ShaderVariantManager(renderer.GetDevice(), image))
+{ }
+
+ShaderLibrary::ShaderLibrary(Renderer& renderer, MappedFile&& file) :
+	pManager(new ShaderVariantManager(renderer.GetDevice(), std::move(file)))
+{ }
+
 const StringIDMap& ShaderLibrary::GetStringMap() const { return pManager->GetStringMap(); }
 
 Material ShaderLibrary::GetMaterial(uint effectNameID) const
@@ -19,6 +19,16 @@ ShaderVariantManager::ShaderVariantManager(Device& device, ShaderLibDef&& def) :
 	libMap(std::move(def))
 { }
 
+ShaderVariantManager::ShaderVariantManager(Device& device, const ShaderLibImage& image) :
+	pDev(&device),
+	libMap(image)
+{ }
+
+ShaderVariantManager::ShaderVariantManager(Device& device, MappedFile&& file) :
+	pDev(&device),
+	libMap(std::move(file))
+{ }
+
 const StringIDMap& ShaderVariantManager::GetStringMap() const { return libMap.GetStringMap(); }
 
 bool ShaderVariantManager::TryGetShader(uint shaderID, const VertexShaderVariant*& pVS)
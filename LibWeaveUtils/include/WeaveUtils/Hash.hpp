@@ -0,0 +1,66 @@
+#pragma once
+#include <string_view>
+#include "WeaveUtils/GlobalUtils.hpp"
+#include "WeaveUtils/DynamicCollections.hpp"
+
+namespace Weave
+{
+	/// <summary>
+	/// 128-bit non-cryptographic content hash
+	/// </summary>
+	struct Hash128
+	{
+		ulong low;
+		ulong high;
+
+		USE_DEFAULT_CMP(Hash128)
+	};
+
+	/// <summary>
+	/// Calculates a 128-bit hash of the given bytes using MurmurHash3 (x64, 128-bit variant)
+	/// </summary>
+	Hash128 GetHash128(const void* pData, size_t size, ulong seed = 0);
+
+	/// <summary>
+	/// Calculates a 128-bit hash of the given text
+	/// </summary>
+	inline Hash128 GetHash128(std::string_view text, ulong seed = 0)
+	{
+		return GetHash128(text.data(), text.size(), seed);
+	}
+
+	/// <summary>
+	/// Calculates a 128-bit hash of the contents of the given array
+	/// </summary>
+	template<typename T> requires std::is_trivially_copyable_v<T>
+	Hash128 GetHash128(const IDynamicArray<T>& arr, ulong seed = 0)
+	{
+		return GetHash128(arr.GetData(), GetArrSize(arr), seed);
+	}
+
+	/// <summary>
+	/// Calculates a 64-bit hash of the given bytes. Input is consumed in 64 byte stripes by 
+	/// eight independent multiply-accumulate lanes, in the style of XXH3, so large inputs 
+	/// hash several times faster than with GetHash128. Not compatible with XXH3 output.
+	/// </summary>
+	ulong GetHash64(const void* pData, size_t size, ulong seed = 0);
+
+	/// <summary>
+	/// Calculates a 64-bit hash of the contents of the given array
+	/// </summary>
+	template<typename T> requires std::is_trivially_copyable_v<T>
+	ulong GetHash64(const IDynamicArray<T>& arr, ulong seed = 0)
+	{
+		return GetHash64(arr.GetData(), GetArrSize(arr), seed);
+	}
+}
+
+namespace std
+{
+	template<>
+	struct hash<Weave::Hash128>
+	{
+		// Bits are already well distributed
+		size_t operator()(const Weave::Hash128& hash) const noexcept { return (size_t)(hash.low ^ hash.high); }
+	};
+}
@@ -0,0 +1,25 @@
+#pragma once
+#include <span>
+#include "WeaveUtils/GlobalUtils.hpp"
+#include "WeaveUtils/DynamicCollections.hpp"
+
+namespace Weave
+{
+	/// <summary>
+	/// Returns the largest possible size of the given number of bytes compressed with CompressLZ4
+	/// </summary>
+	constexpr size_t GetMaxCompressedSizeLZ4(size_t srcSize) { return srcSize + (srcSize / 255) + 16; }
+
+	/// <summary>
+	/// Compresses the given bytes into a single LZ4 block and appends it to dst. The block
+	/// format is compatible with the reference LZ4 decoder. The uncompressed size is not stored
+	/// and must be tracked separately.
+	/// </summary>
+	void CompressLZ4(std::span<const byte> src, Vector<byte>& dst);
+
+	/// <summary>
+	/// Decompresses an LZ4 block into dst. The destination must be exactly the uncompressed size.
+	/// Throws if the block is malformed or doesn't match the destination size.
+	/// </summary>
+	void DecompressLZ4(std::span<const byte> src, std::span<byte> dst);
+}
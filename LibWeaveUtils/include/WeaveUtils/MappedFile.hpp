@@ -0,0 +1,53 @@
+#pragma once
+#include <string_view>
+#include "WeaveUtils/GlobalUtils.hpp"
+
+namespace Weave
+{
+	/// <summary>
+	/// Read-only view of a file mapped into memory. Pages are loaded by the OS on first access
+	/// and shared with other processes mapping the same file.
+	/// </summary>
+	class MappedFile
+	{
+	public:
+		MAKE_NO_COPY(MappedFile)
+
+		MappedFile();
+
+		/// <summary>
+		/// Maps the entire file at the given path. Throws if the file can't be opened or mapped.
+		/// </summary>
+		explicit MappedFile(std::string_view path);
+
+		MappedFile(MappedFile&& other) noexcept;
+
+		MappedFile& operator=(MappedFile&& other) noexcept;
+
+		~MappedFile();
+
+		/// <summary>
+		/// Returns the contents of the file. Aligned to at least the system page size.
+		/// </summary>
+		std::string_view GetData() const;
+
+		/// <summary>
+		/// Returns the size of the mapped file in bytes
+		/// </summary>
+		size_t GetSize() const;
+
+		/// <summary>
+		/// Returns true if a file is mapped
+		/// </summary>
+		bool GetIsOpen() const;
+
+		/// <summary>
+		/// Unmaps the file, if one is mapped
+		/// </summary>
+		void Close();
+
+	private:
+		const char* pData;
+		size_t size;
+	};
+}
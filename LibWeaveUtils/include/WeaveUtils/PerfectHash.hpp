@@ -0,0 +1,321 @@
+#pragma once
+#include <algorithm>
+#include <span>
+#include <string_view>
+#include "WeaveUtils/GlobalUtils.hpp"
+#include "WeaveUtils/DynamicCollections.hpp"
+
+namespace Weave
+{
+	/// <summary>
+	/// Key/value pair stored in a perfect hash table
+	/// </summary>
+	struct PerfectHashSlot
+	{
+		uint key;
+		uint value;
+	};
+
+	/// <summary>
+	/// Read-only view of a minimal perfect hash table generated by BuildPerfectHash. Every key
+	/// in the table maps to a unique slot using one displacement lookup, so lookups are two array
+	/// reads and a key comparison with no probing. Non-owning.
+	/// </summary>
+	class PerfectHashTable
+	{
+	public:
+		MAKE_DEF_MOVE_COPY(PerfectHashTable)
+
+		PerfectHashTable() :
+			seed(0)
+		{ }
+
+		PerfectHashTable(uint seed, std::span<const uint> displacements, std::span<const PerfectHashSlot> slots) :
+			seed(seed),
+			displacements(displacements),
+			slots(slots)
+		{ }
+
+		/// <summary>
+		/// Mixes the bits of a 64-bit value. Shared by the table builder and lookups.
+		/// </summary>
+		static constexpr ulong Mix(ulong x)
+		{
+			x ^= x >> 33;
+			x *= 0xff51afd7ed558ccdull;
+			x ^= x >> 33;
+			x *= 0xc4ceb9fe1a85ec53ull;
+			x ^= x >> 33;
+			return x;
+		}
+
+		/// <summary>
+		/// Maps the high 32 bits of a mixed hash to [0, length) without division
+		/// </summary>
+		static constexpr uint Reduce(ulong hash, size_t length)
+		{
+			return (uint)(((hash >> 32) * (ulong)length) >> 32);
+		}
+
+		/// <summary>
+		/// Returns the key hash used for integer keys
+		/// </summary>
+		static constexpr ulong GetKeyHash(uint key) { return key; }
+
+		/// <summary>
+		/// Returns the key hash used for string keys
+		/// </summary>
+		static ulong GetKeyHash(std::string_view key);
+
+		/// <summary>
+		/// Returns the slot the given key hash maps to. Only meaningful for keys in the table.
+		/// Null if the table is empty.
+		/// </summary>
+		const PerfectHashSlot* GetSlot(ulong keyHash) const
+		{
+			if (slots.empty())
+				return nullptr;
+
+			const ulong hash = Mix(keyHash ^ seed);
+			const uint displacement = displacements[Reduce(hash, displacements.size())];
+			return &slots[Reduce(Mix(hash ^ displacement), slots.size())];
+		}
+
+		/// <summary>
+		/// Returns the value of the given integer key, -1 if it's not in the table
+		/// </summary>
+		uint TryGetValue(uint key) const
+		{
+			const PerfectHashSlot* pSlot = GetSlot(GetKeyHash(key));
+			return (pSlot != nullptr && pSlot->key == key) ? pSlot->value : -1;
+		}
+
+		/// <summary>
+		/// Returns the number of keys in the table
+		/// </summary>
+		uint GetLength() const { return (uint)slots.size(); }
+
+		/// <summary>
+		/// Returns the key/value pairs in the table in slot order
+		/// </summary>
+		std::span<const PerfectHashSlot> GetSlots() const { return slots; }
+
+	private:
+		uint seed;
+		std::span<const uint> displacements;
+		std::span<const PerfectHashSlot> slots;
+	};
+
+	/// <summary>
+	/// Returns the key hash used for string keys in tables built at compile time (FNV-1a)
+	/// </summary>
+	constexpr ulong GetConstKeyHash(std::string_view key)
+	{
+		const char* pChar = key.data();
+		const char* pEnd = pChar + key.size();
+		ulong hash = 0xcbf29ce484222325ull;
+
+		for (; pChar != pEnd; pChar++)
+			hash = (hash ^ (byte)*pChar) * 0x100000001b3ull;
+
+		return hash;
+	}
+
+	/// <summary>
+	/// Perfect hash over a fixed set of keys, built during constant evaluation with the same
+	/// displacement scheme as BuildPerfectHash. Maps each key hash to the index of the entry it
+	/// was built from. Slots outnumber keys two to one, keeping displacement searches short enough
+	/// for compile-time evaluation. Entries repeating an earlier key are unreachable.
+	/// </summary>
+	template<size_t KeyCount>
+	class ConstPerfectHash
+	{
+	public:
+		static_assert(KeyCount > 0, "Perfect hash tables must have at least one key");
+
+		static constexpr uint SlotCount = 2 * (uint)KeyCount;
+		static constexpr uint BucketCount = ((uint)KeyCount + 1) / 2;
+
+		/// <summary>
+		/// Builds a table over the given entries using the key hashes returned by getKeyHash
+		/// </summary>
+		template<typename T, typename KeyFunc>
+		consteval ConstPerfectHash(const T(&entries)[KeyCount], KeyFunc getKeyHash) :
+			seed(0),
+			displacements(),
+			slotIndices()
+		{
+			ulong keyHashes[KeyCount];
+
+			for (uint i = 0; i < KeyCount; i++)
+				keyHashes[i] = getKeyHash(entries[i]);
+
+			// Slots are only cleared again when a seed fails. Displacements aren't reset, as every 
+			// non-empty bucket is assigned one when it's placed.
+			ClearSlots();
+
+			for (; seed < s_MaxSeedAttempts; seed++)
+			{
+				if (TryPlaceBuckets(keyHashes))
+					return;
+			}
+
+			// Fails constant evaluation
+			throw "Failed to generate a perfect hash";
+		}
+
+		/// <summary>
+		/// Returns the index of the entry that would hold the given key hash, or -1 if the slot is
+		/// empty. Keys outside the table can map to any entry, so callers must compare keys.
+		/// </summary>
+		constexpr int TryGetIndex(ulong keyHash) const
+		{
+			const ulong hash = PerfectHashTable::Mix(keyHash ^ seed);
+			const uint displacement = displacements[PerfectHashTable::Reduce(hash, BucketCount)];
+			return slotIndices[PerfectHashTable::Reduce(PerfectHashTable::Mix(hash ^ displacement), SlotCount)];
+		}
+
+	private:
+		// Limits are kept low enough for compilers' default constant evaluation step limits. 
+		// With twice as many slots as keys, buckets rarely need more than a few hundred 
+		// displacements, and a seed that fails early is cheaper to replace than to search.
+		static constexpr uint s_MaxSeedAttempts = 64;
+		static constexpr uint s_MaxDisplacements = 1u << 10;
+
+		uint seed;
+		// Plain arrays, as std::array indexing is a function call per access during constant 
+		// evaluation and counts against the compiler's step limit
+		uint displacements[BucketCount];
+		int slotIndices[SlotCount];
+
+		constexpr void ClearSlots()
+		{
+			for (uint i = 0; i < SlotCount; i++)
+				slotIndices[i] = -1;
+		}
+
+		/// <summary>
+		/// Tries to place every bucket with the current seed, largest first. Leaves every slot 
+		/// empty on failure.
+		/// </summary>
+		constexpr bool TryPlaceBuckets(const ulong* pKeyHashes)
+		{
+			ulong hashes[KeyCount];
+			uint keyBuckets[KeyCount];
+			uint bucketStarts[BucketCount + 1] = {};
+			uint bucketEnds[BucketCount] = {};
+			uint bucketKeys[KeyCount];
+			uint sizeStarts[KeyCount + 1] = {};
+			uint bucketOrder[BucketCount];
+			uint maxBucketSize = 0;
+
+			// Group keys by bucket
+			for (uint i = 0; i < KeyCount; i++)
+			{
+				hashes[i] = PerfectHashTable::Mix(pKeyHashes[i] ^ seed);
+				keyBuckets[i] = PerfectHashTable::Reduce(hashes[i], BucketCount);
+				bucketStarts[keyBuckets[i] + 1]++;
+			}
+
+			for (uint i = 0; i < BucketCount; i++)
+			{
+				const uint size = bucketStarts[i + 1];
+				maxBucketSize = std::max(maxBucketSize, size);
+				sizeStarts[size]++;
+
+				bucketStarts[i + 1] += bucketStarts[i];
+				bucketEnds[i] = bucketStarts[i];
+			}
+
+			for (uint i = 0; i < KeyCount; i++)
+				bucketKeys[bucketEnds[keyBuckets[i]]++] = i;
+
+			// Larger buckets are harder to place and go first, while the table is mostly empty. 
+			// Sorted by counting, with ties kept in bucket order.
+			for (uint size = maxBucketSize, start = 0; size > 0; size--)
+			{
+				const uint count = sizeStarts[size];
+				sizeStarts[size] = start;
+				start += count;
+			}
+
+			uint placeCount = 0;
+
+			for (uint bucket = 0; bucket < BucketCount; bucket++)
+			{
+				const uint size = bucketStarts[bucket + 1] - bucketStarts[bucket];
+
+				if (size > 0)
+				{
+					bucketOrder[sizeStarts[size]++] = bucket;
+					placeCount++;
+				}
+			}
+
+			for (uint i = 0; i < placeCount; i++)
+			{
+				const uint bucket = bucketOrder[i];
+				const uint start = bucketStarts[bucket];
+
+				if (!TryPlaceBucket(pKeyHashes, hashes, bucket, bucketKeys + start, bucketStarts[bucket + 1] - start))
+				{
+					ClearSlots();
+					return false;
+				}
+			}
+
+			return true;
+		}
+
+		/// <summary>
+		/// Searches for a displacement mapping every key in the bucket to an empty slot
+		/// </summary>
+		constexpr bool TryPlaceBucket(const ulong* pKeyHashes, const ulong* pHashes, uint bucket, const uint* pKeys, uint keyCount)
+		{
+			for (uint disp = 0; disp < s_MaxDisplacements; disp++)
+			{
+				uint placed = 0;
+
+				for (; placed < keyCount; placed++)
+				{
+					const uint key = pKeys[placed];
+					const uint slot = PerfectHashTable::Reduce(PerfectHashTable::Mix(pHashes[key] ^ disp), SlotCount);
+					const int occupant = slotIndices[slot];
+
+					// Equal keys always share a bucket and slot. Only the first is kept.
+					if (occupant != -1 && pKeyHashes[occupant] == pKeyHashes[key])
+						continue;
+					else if (occupant != -1)
+						break;
+
+					slotIndices[slot] = (int)key;
+				}
+
+				if (placed == keyCount)
+				{
+					displacements[bucket] = disp;
+					return true;
+				}
+
+				// Release partially placed keys
+				for (uint i = 0; i < placed; i++)
+				{
+					const uint key = pKeys[i];
+					const uint slot = PerfectHashTable::Reduce(PerfectHashTable::Mix(pHashes[key] ^ disp), SlotCount);
+
+					if (slotIndices[slot] == (int)key)
+						slotIndices[slot] = -1;
+				}
+			}
+
+			return false;
+		}
+	};
+
+	/// <summary>
+	/// Generates a minimal perfect hash over the given unique key hashes for use with
+	/// PerfectHashTable. Writes the slot assigned to each key to slotIndices and returns the
+	/// table seed. Output depends only on the key hashes and their order.
+	/// </summary>
+	uint BuildPerfectHash(std::span<const ulong> keyHashes, Vector<uint>& displacements, Vector<uint>& slotIndices);
+}
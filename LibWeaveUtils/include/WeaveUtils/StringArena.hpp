@@ -0,0 +1,37 @@
+#pragma once
+#include <string_view>
+#include "WeaveUtils/GlobalUtils.hpp"
+#include "WeaveUtils/DynamicCollections.hpp"
+
+namespace Weave
+{
+	/// <summary>
+	/// Monotonic allocator for strings with stable addresses. Strings are copied into large
+	/// blocks that are kept between clears, so a cleared arena can be refilled without
+	/// reallocating.
+	/// </summary>
+	class StringArena
+	{
+	public:
+		MAKE_MOVE_ONLY(StringArena)
+
+		explicit StringArena(size_t blockSize = 16 * 1024);
+
+		/// <summary>
+		/// Copies the given string into the arena and returns a view to the copy. The view 
+		/// remains valid until the arena is cleared or destroyed. Empty strings return an empty view.
+		/// </summary>
+		std::string_view Add(std::string_view str);
+
+		/// <summary>
+		/// Releases all strings in the arena without freeing its blocks
+		/// </summary>
+		void Clear();
+
+	private:
+		UniqueVector<UniqueArray<char>> blocks;
+		size_t blockSize;
+		size_t blockIndex;
+		size_t blockPos;
+	};
+}
@@ -1,8 +1,10 @@
 #pragma once
 #include "WeaveUtils/GlobalUtils.hpp"
 #include "WeaveUtils/DynamicCollections.hpp"
+#include "WeaveUtils/PerfectHash.hpp"
 #include <unordered_map>
 #include <limits>
+#include <span>
 
 namespace Weave
 {
@@ -59,6 +61,19 @@ namespace Weave
 
         explicit StringIDMap(StringIDMapDef&& def);
 
+        /// <summary>
+        /// Initializes a map over externally owned string data without copying it. The data 
+        /// must outlive the map.
+        /// </summary>
+        StringIDMap(std::span<const uint> substrings, std::string_view stringData);
+
+        /// <summary>
+        /// Initializes a map over externally owned string data using a precomputed perfect hash
+        /// table for lookup. Slot keys hold the low 32 bits of each string's key hash and values
+        /// hold string IDs. Nothing is allocated or hashed on construction.
+        /// </summary>
+        StringIDMap(std::span<const uint> substrings, std::string_view stringData, const PerfectHashTable& idTable);
+
         /// <summary>
         /// Returns true if the string exists in the map and retrieves its ID
         /// </summary>
@@ -75,7 +90,13 @@ namespace Weave
         uint GetStringCount() const;
 
     private:
+        // Owned string data, null if the map was initialized over external data
         std::unique_ptr<StringIDMapDef> pDef;
+        // Alternating starting indices + string length
+        std::span<const uint> substrings;
+        std::string_view stringData;
+        // String -> ID perfect hash table, empty if idMap is used instead
+        PerfectHashTable idTable;
         // String -> ID map
         std::unordered_map<std::string_view, uint> idMap;
 
@@ -0,0 +1,69 @@
+#pragma once
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <functional>
+#include <exception>
+#include "WeaveUtils/DynamicCollections.hpp"
+
+namespace Weave
+{
+	/// <summary>
+	/// Fixed-size pool of worker threads used to run batches of indexed tasks in parallel
+	/// </summary>
+	class WorkerPool
+	{
+	public:
+		using TaskFunc = std::function<void(uint index)>;
+
+		MAKE_IMMOVABLE(WorkerPool)
+
+		/// <summary>
+		/// Initializes a pool with the given total concurrency, including the calling thread.
+		/// A count of zero uses the number of hardware threads available.
+		/// </summary>
+		explicit WorkerPool(uint threadCount = 0);
+
+		~WorkerPool();
+
+		/// <summary>
+		/// Returns the maximum number of tasks that can run concurrently, including the
+		/// calling thread
+		/// </summary>
+		uint GetThreadCount() const;
+
+		/// <summary>
+		/// Invokes the given function once for every index on [0, count) and blocks until
+		/// all invocations return. The calling thread participates. The first exception thrown
+		/// by a task is rethrown on the calling thread after the batch completes.
+		/// </summary>
+		void ParallelFor(uint count, const TaskFunc& func);
+
+	private:
+		UniqueVector<std::jthread> threads;
+
+		std::mutex poolMutex;
+		std::condition_variable batchStart;
+		std::condition_variable batchEnd;
+
+		const TaskFunc* pFunc;
+		uint taskCount;
+		std::atomic<uint> nextTask;
+		uint activeWorkers;
+		ulong batchID;
+		bool canRun;
+
+		std::exception_ptr pTaskErr;
+
+		/// <summary>
+		/// Claims and runs tasks from the current batch until none remain
+		/// </summary>
+		void RunTasks();
+
+		/// <summary>
+		/// Worker thread loop
+		/// </summary>
+		void WorkerMain();
+	};
+}
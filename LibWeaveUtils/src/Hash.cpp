@@ -0,0 +1,174 @@
+#include "pch.hpp"
+#include <bit>
+#include <cstring>
+#include "WeaveUtils/Hash.hpp"
+
+using namespace Weave;
+
+static constexpr ulong s_C1 = 0x87c37b91114253d5ull;
+static constexpr ulong s_C2 = 0x4cf5ad432745937full;
+
+/// <summary>
+/// Final avalanche mix for a 64-bit lane
+/// </summary>
+static ulong FMix64(ulong k)
+{
+	k ^= k >> 33;
+	k *= 0xff51afd7ed558ccdull;
+	k ^= k >> 33;
+	k *= 0xc4ceb9fe1a85ec53ull;
+	k ^= k >> 33;
+	return k;
+}
+
+/// <summary>
+/// Reads 8 bytes as an integer. Safe for unaligned addresses.
+/// </summary>
+static ulong LoadULong(const byte* pSrc)
+{
+	static_assert(std::endian::native == std::endian::little, "Big endian hashing not implemented");
+	ulong value;
+	memcpy(&value, pSrc, sizeof(ulong));
+	return value;
+}
+
+Hash128 Weave::GetHash128(const void* pData, size_t size, ulong seed)
+{
+	const byte* pSrc = static_cast<const byte*>(pData);
+	const size_t blockCount = size / 16;
+	ulong h1 = seed;
+	ulong h2 = seed;
+
+	// Body
+	for (size_t i = 0; i < blockCount; i++)
+	{
+		ulong k1 = LoadULong(pSrc + 16 * i);
+		ulong k2 = LoadULong(pSrc + 16 * i + 8);
+
+		k1 *= s_C1; k1 = std::rotl(k1, 31); k1 *= s_C2; h1 ^= k1;
+		h1 = std::rotl(h1, 27); h1 += h2; h1 = h1 * 5 + 0x52dce729;
+
+		k2 *= s_C2; k2 = std::rotl(k2, 33); k2 *= s_C1; h2 ^= k2;
+		h2 = std::rotl(h2, 31); h2 += h1; h2 = h2 * 5 + 0x38495ab5;
+	}
+
+	// Tail
+	const byte* pTail = pSrc + 16 * blockCount;
+	const size_t tailSize = size & 15;
+	ulong k1 = 0;
+	ulong k2 = 0;
+
+	for (size_t i = tailSize; i > 8; i--)
+		k2 |= (ulong)pTail[i - 1] << (8 * (i - 9));
+
+	for (size_t i = std::min(tailSize, (size_t)8); i > 0; i--)
+		k1 |= (ulong)pTail[i - 1] << (8 * (i - 1));
+
+	if (tailSize > 8)
+	{
+		k2 *= s_C2; k2 = std::rotl(k2, 33); k2 *= s_C1; h2 ^= k2;
+	}
+
+	if (tailSize > 0)
+	{
+		k1 *= s_C1; k1 = std::rotl(k1, 31); k1 *= s_C2; h1 ^= k1;
+	}
+
+	// Finalization
+	h1 ^= (ulong)size;
+	h2 ^= (ulong)size;
+
+	h1 += h2;
+	h2 += h1;
+
+	h1 = FMix64(h1);
+	h2 = FMix64(h2);
+
+	h1 += h2;
+	h2 += h1;
+
+	return { .low = h1, .high = h2 };
+}
+
+static constexpr uint s_LaneCount = 8;
+static constexpr size_t s_StripeSize = sizeof(ulong) * s_LaneCount;
+static constexpr size_t s_StripesPerBlock = 16;
+static constexpr ulong s_P1 = 0x9e3779b185ebca87ull;
+static constexpr ulong s_P2 = 0xc2b2ae3d27d4eb4full;
+static constexpr ulong s_P3 = 0x165667b19e3779f9ull;
+static constexpr ulong s_P32 = 0x9e3779b1ull;
+
+/// <summary>
+/// Per-lane keys mixed into each stripe. First 64 bytes of the XXH3 default secret.
+/// </summary>
+static constexpr ulong s_LaneKeys[s_LaneCount]
+{
+	0xbe4ba423396cfeb8ull, 0x1cad21f72c81017cull, 0xdb979083e96dd4deull, 0x1f67b3b7a4a44072ull,
+	0x78e5c0cc4ee679cbull, 0x2172ffcc7dd05a82ull, 0x8e2443f7744608b8ull, 0x4c263a81e69035e0ull,
+};
+
+ulong Weave::GetHash64(const void* pData, size_t size, ulong seed)
+{
+	const byte* pSrc = static_cast<const byte*>(pData);
+	ulong acc[s_LaneCount] { s_P32, s_P1, s_P2, s_P3, s_P2 ^ seed, s_P32 ^ seed, s_P1, s_P3 };
+
+	// The last stripe always ends on the last byte, overlapping the one before it if the 
+	// size isn't a multiple of the stripe size. Inputs shorter than a stripe are zero padded.
+	const size_t stripeCount = (size > 0) ? (size - 1) / s_StripeSize : 0;
+	const byte* pLast;
+	byte paddedStripe[s_StripeSize];
+
+	if (size >= s_StripeSize)
+		pLast = pSrc + (size - s_StripeSize);
+	else
+	{
+		memset(paddedStripe, 0, s_StripeSize);
+
+		if (size > 0)
+			memcpy(paddedStripe, pSrc, size);
+
+		pLast = paddedStripe;
+	}
+
+	for (size_t i = 0; i <= stripeCount; i++)
+	{
+		const byte* pStripe = (i < stripeCount) ? (pSrc + s_StripeSize * i) : pLast;
+		// Offsetting keys by stripe index keeps identical words in different stripes from 
+		// cancelling out, e.g. ID spans that only differ by which pair of IDs is swapped
+		const ulong stripeKey = seed + i * s_P2;
+
+		// Lanes are updated in pairs, each taking its neighbor's input word, so every 
+		// accumulator is written once per stripe and the loop stays in registers. Lanes are 
+		// independent of each other and vectorize under SSE2/AVX2.
+		for (uint j = 0; j < s_LaneCount; j += 2)
+		{
+			const ulong v0 = LoadULong(pStripe + sizeof(ulong) * j);
+			const ulong v1 = LoadULong(pStripe + sizeof(ulong) * (j + 1));
+			const ulong k0 = v0 ^ (s_LaneKeys[j] + stripeKey);
+			const ulong k1 = v1 ^ (s_LaneKeys[j + 1] + stripeKey);
+
+			acc[j] += v1 + (k0 & 0xFFFFFFFFull) * (k0 >> 32);
+			acc[j + 1] += v0 + (k1 & 0xFFFFFFFFull) * (k1 >> 32);
+		}
+
+		// Scramble accumulators at the end of each block to keep high bits from saturating
+		if ((i + 1) % s_StripesPerBlock == 0)
+		{
+			for (uint j = 0; j < s_LaneCount; j++)
+			{
+				ulong lane = acc[j];
+				lane ^= lane >> 47;
+				lane ^= s_LaneKeys[j];
+				acc[j] = lane * s_P32;
+			}
+		}
+	}
+
+	// Merge lanes
+	ulong hash = (ulong)size * s_P1;
+
+	for (uint i = 0; i < s_LaneCount; i += 2)
+		hash += FMix64(acc[i] ^ s_LaneKeys[i]) ^ std::rotl(acc[i + 1] ^ s_LaneKeys[i + 1], 29);
+
+	return FMix64(hash ^ (hash >> 37));
+}
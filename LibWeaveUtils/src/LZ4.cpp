@@ -0,0 +1,197 @@
+#include "pch.hpp"
+#include <cstring>
+#include "WeaveUtils/LZ4.hpp"
+
+using namespace Weave;
+
+// Shortest match encoded by the format
+static constexpr size_t s_MinMatch = 4;
+// The last 5 bytes of a block are always literals
+static constexpr size_t s_LastLiterals = 5;
+// The last match must start at least 12 bytes before the end of the block
+static constexpr size_t s_MFLimit = 12;
+// Largest offset a match can reference
+static constexpr size_t s_MaxOffset = 0xFFFF;
+// Length values of 15 in a token are continued in the following bytes
+static constexpr uint s_RunMask = 15;
+// Size of the match finder hash table in bits
+static constexpr uint s_HashLog = 14;
+
+static uint Load32(const byte* pSrc)
+{
+	uint value;
+	memcpy(&value, pSrc, sizeof(uint));
+	return value;
+}
+
+static uint GetSequenceHash(uint sequence) { return (sequence * 2654435761u) >> (32 - s_HashLog); }
+
+/// <summary>
+/// Writes the remainder of a length that didn't fit in its token nibble
+/// </summary>
+static void WriteLength(Vector<byte>& dst, size_t length)
+{
+	for (; length >= 255; length -= 255)
+		dst.EmplaceBack((byte)255);
+
+	dst.EmplaceBack((byte)length);
+}
+
+/// <summary>
+/// Writes a token followed by literals and, if matchLength is nonzero, a match
+/// </summary>
+static void WriteSequence(Vector<byte>& dst, const byte* pLiterals, size_t litLength, size_t offset, size_t matchLength)
+{
+	const size_t matchCode = (matchLength > 0) ? (matchLength - s_MinMatch) : 0;
+	dst.EmplaceBack((byte)((std::min(litLength, (size_t)s_RunMask) << 4) | std::min(matchCode, (size_t)s_RunMask)));
+
+	if (litLength >= s_RunMask)
+		WriteLength(dst, litLength - s_RunMask);
+
+	dst.InsertRange(dst.GetLength(), pLiterals, pLiterals + litLength);
+
+	if (matchLength > 0)
+	{
+		dst.EmplaceBack((byte)(offset & 0xFF));
+		dst.EmplaceBack((byte)(offset >> 8));
+
+		if (matchCode >= s_RunMask)
+			WriteLength(dst, matchCode - s_RunMask);
+	}
+}
+
+/// <summary>
+/// Reads the remainder of a length that didn't fit in its token nibble
+/// </summary>
+static size_t ReadLength(const byte*& pIn, const byte* pInEnd)
+{
+	size_t length = 0;
+	byte next;
+
+	do
+	{
+		WV_CHECK_MSG(pIn < pInEnd, "LZ4 block truncated");
+		next = *pIn++;
+		length += next;
+	} while (next == 255);
+
+	return length;
+}
+
+void Weave::CompressLZ4(std::span<const byte> src, Vector<byte>& dst)
+{
+	const byte* const pSrc = src.data();
+	const size_t srcSize = src.size();
+	size_t anchor = 0;
+
+	dst.Reserve(dst.GetLength() + GetMaxCompressedSizeLZ4(srcSize));
+
+	// Blocks too short to hold a match are stored as literals
+	if (srcSize > s_MFLimit)
+	{
+		// Most recent position of each hashed 4-byte sequence
+		Vector<uint> table;
+		table.Resize(1u << s_HashLog);
+
+		const size_t matchLimit = srcSize - s_LastLiterals;
+		const size_t mfLimit = srcSize - s_MFLimit;
+		size_t pos = 1;
+
+		while (pos < mfLimit)
+		{
+			const uint sequence = Load32(pSrc + pos);
+			uint& entry = table[GetSequenceHash(sequence)];
+			size_t match = entry;
+			entry = (uint)pos;
+
+			if ((pos - match) > s_MaxOffset || Load32(pSrc + match) != sequence)
+			{
+				pos++;
+				continue;
+			}
+
+			// Extend backwards into pending literals, then forwards
+			while (pos > anchor && match > 0 && pSrc[pos - 1] == pSrc[match - 1])
+			{
+				pos--;
+				match--;
+			}
+
+			size_t matchLength = s_MinMatch;
+
+			while ((pos + matchLength) < matchLimit && pSrc[pos + matchLength] == pSrc[match + matchLength])
+				matchLength++;
+
+			WriteSequence(dst, pSrc + anchor, pos - anchor, pos - match, matchLength);
+			pos += matchLength;
+			anchor = pos;
+		}
+	}
+
+	WriteSequence(dst, pSrc + anchor, srcSize - anchor, 0, 0);
+}
+
+void Weave::DecompressLZ4(std::span<const byte> src, std::span<byte> dst)
+{
+	const byte* pIn = src.data();
+	const byte* const pInEnd = pIn + src.size();
+	byte* const pOutStart = dst.data();
+	byte* const pOutEnd = pOutStart + dst.size();
+	byte* pOut = pOutStart;
+
+	while (true)
+	{
+		WV_CHECK_MSG(pIn < pInEnd, "LZ4 block truncated");
+		const uint token = *pIn++;
+
+		// Literals
+		size_t litLength = token >> 4;
+
+		if (litLength == s_RunMask)
+			litLength += ReadLength(pIn, pInEnd);
+
+		WV_CHECK_MSG(litLength <= (size_t)(pInEnd - pIn) && litLength <= (size_t)(pOutEnd - pOut),
+			"LZ4 literals out of bounds");
+
+		if (litLength > 0)
+			memcpy(pOut, pIn, litLength);
+
+		pIn += litLength;
+		pOut += litLength;
+
+		// The last sequence has no match
+		if (pIn == pInEnd)
+			break;
+
+		// Match
+		WV_CHECK_MSG((pInEnd - pIn) >= 2, "LZ4 block truncated");
+		const size_t offset = (size_t)pIn[0] | ((size_t)pIn[1] << 8);
+		pIn += 2;
+
+		size_t matchLength = (token & s_RunMask);
+
+		if (matchLength == s_RunMask)
+			matchLength += ReadLength(pIn, pInEnd);
+
+		matchLength += s_MinMatch;
+
+		WV_CHECK_MSG(offset > 0 && offset <= (size_t)(pOut - pOutStart), "LZ4 match offset invalid");
+		WV_CHECK_MSG(matchLength <= (size_t)(pOutEnd - pOut), "LZ4 match out of bounds");
+
+		const byte* pMatch = pOut - offset;
+
+		// Overlapping matches repeat the last offset bytes and must be copied in order
+		if (offset >= matchLength)
+			memcpy(pOut, pMatch, matchLength);
+		else
+		{
+			for (size_t i = 0; i < matchLength; i++)
+				pOut[i] = pMatch[i];
+		}
+
+		pOut += matchLength;
+	}
+
+	WV_CHECK_MSG(pOut == pOutEnd, "LZ4 block size mismatch. Expected {} bytes, got {}.",
+		dst.size(), (size_t)(pOut - pOutStart));
+}
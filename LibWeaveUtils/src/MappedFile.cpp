@@ -0,0 +1,138 @@
+#include "pch.hpp"
+#include "WeaveUtils/MappedFile.hpp"
+
+#ifdef _WIN32
+#include "WeaveUtils/Win32.hpp"
+#include "WeaveUtils/WeaveWinException.hpp"
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace Weave;
+
+MappedFile::MappedFile() :
+	pData(nullptr),
+	size(0)
+{ }
+
+MappedFile::MappedFile(std::string_view path) :
+	MappedFile()
+{
+	const std::filesystem::path filePath(path);
+
+#ifdef _WIN32
+	HANDLE hFile = CreateFileW(filePath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+		OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	WIN_CHECK_LAST_MSG(hFile != INVALID_HANDLE_VALUE, "Failed to open file: {}", path);
+
+	LARGE_INTEGER fileSize;
+	HANDLE hMapping = nullptr;
+	DWORD lastError = 0;
+
+	if (!GetFileSizeEx(hFile, &fileSize))
+		lastError = GetLastError();
+	else if (fileSize.QuadPart > 0) // Empty files can't be mapped
+	{
+		hMapping = CreateFileMappingW(hFile, nullptr, PAGE_READONLY, 0, 0, nullptr);
+
+		if (hMapping == nullptr)
+			lastError = GetLastError();
+	}
+
+	CloseHandle(hFile);
+
+	if (lastError != 0)
+		WIN_THROW_HR_MSG(lastError, "Failed to map file: {}", path);
+
+	if (hMapping != nullptr)
+	{
+		// The view keeps the mapping alive after its handle is closed
+		pData = static_cast<const char*>(MapViewOfFile(hMapping, FILE_MAP_READ, 0, 0, 0));
+		lastError = GetLastError();
+		CloseHandle(hMapping);
+
+		if (pData == nullptr)
+			WIN_THROW_HR_MSG(lastError, "Failed to map file view: {}", path);
+
+		size = (size_t)fileSize.QuadPart;
+	}
+#else
+	const int fd = open(filePath.c_str(), O_RDONLY);
+	WV_CHECK_MSG(fd != -1, "Failed to open file: {}", path);
+
+	struct stat fileStat;
+
+	if (fstat(fd, &fileStat) != 0)
+	{
+		close(fd);
+		WV_THROW("Failed to get file size: {}", path);
+	}
+
+	size = (size_t)fileStat.st_size;
+
+	// Empty files can't be mapped
+	if (size > 0)
+	{
+		void* pMap = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+		close(fd);
+
+		if (pMap == MAP_FAILED)
+		{
+			size = 0;
+			WV_THROW("Failed to map file: {}", path);
+		}
+
+		pData = static_cast<const char*>(pMap);
+	}
+	else
+		close(fd);
+#endif
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept :
+	pData(other.pData),
+	size(other.size)
+{
+	other.pData = nullptr;
+	other.size = 0;
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept
+{
+	if (this != &other)
+	{
+		Close();
+		pData = other.pData;
+		size = other.size;
+		other.pData = nullptr;
+		other.size = 0;
+	}
+
+	return *this;
+}
+
+MappedFile::~MappedFile() { Close(); }
+
+std::string_view MappedFile::GetData() const { return std::string_view(pData, size); }
+
+size_t MappedFile::GetSize() const { return size; }
+
+bool MappedFile::GetIsOpen() const { return pData != nullptr; }
+
+void MappedFile::Close()
+{
+	if (pData != nullptr)
+	{
+#ifdef _WIN32
+		UnmapViewOfFile(pData);
+#else
+		munmap(const_cast<char*>(pData), size);
+#endif
+	}
+
+	pData = nullptr;
+	size = 0;
+}
@@ -0,0 +1,131 @@
+#include "pch.hpp"
+#include "WeaveUtils/PerfectHash.hpp"
+#include "WeaveUtils/Hash.hpp"
+
+using namespace Weave;
+
+// Number of table seeds tried before giving up
+static constexpr uint s_MaxSeedAttempts = 64;
+// Number of displacements tried per bucket before trying the next seed
+static constexpr uint s_MaxDisplacements = 1u << 24;
+
+ulong PerfectHashTable::GetKeyHash(std::string_view key) { return GetHash128(key).low; }
+
+/// <summary>
+/// Tries to place every bucket with the given seed, largest first. Returns false if any
+/// bucket can't be placed.
+/// </summary>
+static bool TryPlaceBuckets(std::span<const ulong> keyHashes, uint seed, Vector<uint>& displacements,
+	Vector<uint>& slotIndices)
+{
+	const uint keyCount = (uint)keyHashes.size();
+	const uint bucketCount = (uint)displacements.GetLength();
+	Vector<ulong> hashes;
+	Vector<uint> bucketStarts;
+	Vector<uint> bucketKeys;
+	Vector<uint> bucketOrder;
+	std::vector<bool> isOccupied(keyCount, false);
+
+	hashes.Resize(keyCount);
+	bucketStarts.Resize(bucketCount + 1);
+	bucketKeys.Resize(keyCount);
+	bucketOrder.Resize(bucketCount);
+
+	// Group keys by bucket
+	for (uint i = 0; i < keyCount; i++)
+	{
+		hashes[i] = PerfectHashTable::Mix(keyHashes[i] ^ seed);
+		bucketStarts[PerfectHashTable::Reduce(hashes[i], bucketCount) + 1]++;
+	}
+
+	for (uint i = 0; i < bucketCount; i++)
+	{
+		bucketStarts[i + 1] += bucketStarts[i];
+		bucketOrder[i] = i;
+	}
+
+	Vector<uint> bucketEnds(bucketStarts);
+
+	for (uint i = 0; i < keyCount; i++)
+	{
+		const uint bucket = PerfectHashTable::Reduce(hashes[i], bucketCount);
+		bucketKeys[bucketEnds[bucket]++] = i;
+	}
+
+	// Larger buckets are harder to place and go first, while the table is mostly empty
+	std::stable_sort(bucketOrder.begin(), bucketOrder.end(), [&](uint a, uint b)
+	{
+		return (bucketStarts[a + 1] - bucketStarts[a]) > (bucketStarts[b + 1] - bucketStarts[b]);
+	});
+
+	for (const uint bucket : bucketOrder)
+	{
+		const uint start = bucketStarts[bucket];
+		const uint end = bucketStarts[bucket + 1];
+		bool isPlaced = (start == end);
+
+		for (uint disp = 0; disp < s_MaxDisplacements && !isPlaced; disp++)
+		{
+			uint placed = start;
+
+			for (; placed < end; placed++)
+			{
+				const uint key = bucketKeys[placed];
+				const uint slot = PerfectHashTable::Reduce(PerfectHashTable::Mix(hashes[key] ^ disp), keyCount);
+
+				if (isOccupied[slot])
+					break;
+
+				isOccupied[slot] = true;
+				slotIndices[key] = slot;
+			}
+
+			if (placed == end)
+			{
+				displacements[bucket] = disp;
+				isPlaced = true;
+			}
+			else
+			{
+				// Release partially placed keys
+				for (uint i = start; i < placed; i++)
+					isOccupied[slotIndices[bucketKeys[i]]] = false;
+			}
+		}
+
+		if (!isPlaced)
+			return false;
+	}
+
+	return true;
+}
+
+uint Weave::BuildPerfectHash(std::span<const ulong> keyHashes, Vector<uint>& displacements, Vector<uint>& slotIndices)
+{
+	const uint keyCount = (uint)keyHashes.size();
+	displacements.Clear();
+	slotIndices.Clear();
+
+	if (keyCount == 0)
+		return 0;
+
+	// Duplicate keys can never be separated
+	Vector<ulong> sortedHashes(keyHashes.begin(), keyHashes.end());
+	std::sort(sortedHashes.begin(), sortedHashes.end());
+	WV_CHECK_MSG(std::adjacent_find(sortedHashes.begin(), sortedHashes.end()) == sortedHashes.end(),
+		"Perfect hash keys must be unique");
+
+	// Two keys per bucket on average keeps displacement searches short
+	displacements.Resize((keyCount + 1) / 2);
+	slotIndices.Resize(keyCount);
+
+	for (uint seed = 0; seed < s_MaxSeedAttempts; seed++)
+	{
+		if (TryPlaceBuckets(keyHashes, seed, displacements, slotIndices))
+			return seed;
+
+		std::fill(displacements.begin(), displacements.end(), 0u);
+	}
+
+	WV_THROW("Failed to generate a perfect hash for {} keys", keyCount);
+}
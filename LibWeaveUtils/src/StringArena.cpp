@@ -0,0 +1,43 @@
+#include "pch.hpp"
+#include <cstring>
+#include "WeaveUtils/StringArena.hpp"
+
+using namespace Weave;
+
+StringArena::StringArena(size_t blockSize) :
+	blockSize(blockSize),
+	blockIndex(0),
+	blockPos(0)
+{ }
+
+std::string_view StringArena::Add(std::string_view str)
+{
+	// Empty strings don't need storage, and the current block may already be full
+	if (str.empty())
+		return std::string_view();
+
+	// Find the next block with enough space, reusing blocks from before the last clear
+	while (blockIndex < blocks.GetLength() && (blockPos + str.length()) > blocks[blockIndex].GetLength())
+	{
+		blockIndex++;
+		blockPos = 0;
+	}
+
+	if (blockIndex == blocks.GetLength())
+	{
+		blocks.EmplaceBack(std::max(blockSize, str.length()));
+		blockPos = 0;
+	}
+
+	char* pDst = &blocks[blockIndex][blockPos];
+	memcpy(pDst, str.data(), str.length());
+
+	blockPos += str.length();
+	return std::string_view(pDst, str.length());
+}
+
+void StringArena::Clear()
+{
+	blockIndex = 0;
+	blockPos = 0;
+}
@@ -10,19 +10,51 @@ void StringIDMapDef::Clear()
 }
 
 StringIDMap::StringIDMap(const StringIDMapDef& def) :
-    pDef(new StringIDMapDef(def))
+    pDef(new StringIDMapDef(def)),
+    substrings(pDef->substrings.GetData(), pDef->substrings.GetLength()),
+    stringData(pDef->stringData)
 {
     InitMapData();
 }
 
 StringIDMap::StringIDMap(StringIDMapDef&& def) :
-    pDef(new StringIDMapDef(std::move(def)))
+    pDef(new StringIDMapDef(std::move(def))),
+    substrings(pDef->substrings.GetData(), pDef->substrings.GetLength()),
+    stringData(pDef->stringData)
 {
     InitMapData();
 }
 
+StringIDMap::StringIDMap(std::span<const uint> substrings, std::string_view stringData) :
+    substrings(substrings),
+    stringData(stringData)
+{
+    InitMapData();
+}
+
+StringIDMap::StringIDMap(std::span<const uint> substrings, std::string_view stringData, const PerfectHashTable& idTable) :
+    substrings(substrings),
+    stringData(stringData),
+    idTable(idTable)
+{ }
+
 bool StringIDMap::TryGetStringID(std::string_view str, uint& id) const
 {
+    if (idTable.GetLength() > 0)
+    {
+        const ulong keyHash = PerfectHashTable::GetKeyHash(str);
+        const PerfectHashSlot* pSlot = idTable.GetSlot(keyHash);
+
+        if (pSlot->key == (uint)keyHash && GetString(pSlot->value) == str)
+        {
+            id = pSlot->value;
+            return true;
+        }
+
+        id = StringIDMap::INVALID_ID;
+        return false;
+    }
+
     auto it = idMap.find(str);
 
     if (it != idMap.end())
@@ -37,16 +69,16 @@ bool StringIDMap::TryGetStringID(std::string_view str, uint& id) const
 
 std::string_view StringIDMap::GetString(uint id) const 
 { 
-    size_t start = pDef->substrings[id * 2];
-    size_t length = pDef->substrings[id * 2 + 1];
-    return string_view(&pDef->stringData[start], length); 
+    size_t start = substrings[id * 2];
+    size_t length = substrings[id * 2 + 1];
+    return string_view(stringData.data() + start, length); 
 }
 
-uint StringIDMap::GetStringCount() const { return (uint)(pDef->substrings.GetLength() / 2); }
+uint StringIDMap::GetStringCount() const { return (uint)(substrings.size() / 2); }
 
 void StringIDMap::InitMapData()
 {
-    const uint strCount = (uint)(pDef->substrings.GetLength() / 2);
+    const uint strCount = GetStringCount();
     idMap.reserve(strCount);
 
     for (uint i = 0; i < strCount; i++)
@@ -0,0 +1,129 @@
+#include "pch.hpp"
+#include "WeaveUtils/WorkerPool.hpp"
+
+using namespace Weave;
+
+WorkerPool::WorkerPool(uint threadCount) :
+	pFunc(nullptr),
+	taskCount(0),
+	nextTask(0),
+	activeWorkers(0),
+	batchID(0),
+	canRun(true)
+{
+	if (threadCount == 0)
+		threadCount = std::max(1u, std::thread::hardware_concurrency());
+
+	// The calling thread counts toward the total
+	threads.Reserve(threadCount - 1);
+
+	for (uint i = 1; i < threadCount; i++)
+		threads.EmplaceBack([this] { WorkerMain(); });
+}
+
+WorkerPool::~WorkerPool()
+{
+	{
+		std::lock_guard<std::mutex> lock(poolMutex);
+		canRun = false;
+	}
+
+	batchStart.notify_all();
+	threads.Clear();
+}
+
+uint WorkerPool::GetThreadCount() const { return (uint)threads.GetLength() + 1; }
+
+void WorkerPool::ParallelFor(uint count, const TaskFunc& func)
+{
+	if (count == 0)
+		return;
+
+	// Nothing to distribute
+	if (count == 1 || threads.IsEmpty())
+	{
+		for (uint i = 0; i < count; i++)
+			func(i);
+
+		return;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(poolMutex);
+		pFunc = &func;
+		taskCount = count;
+		nextTask = 0;
+		activeWorkers = (uint)threads.GetLength();
+		pTaskErr = nullptr;
+		batchID++;
+	}
+
+	batchStart.notify_all();
+	RunTasks();
+
+	std::exception_ptr pErr;
+
+	{
+		std::unique_lock<std::mutex> lock(poolMutex);
+		batchEnd.wait(lock, [this] { return activeWorkers == 0; });
+		pFunc = nullptr;
+		taskCount = 0;
+		std::swap(pErr, pTaskErr);
+	}
+
+	if (pErr != nullptr)
+		std::rethrow_exception(pErr);
+}
+
+void WorkerPool::RunTasks()
+{
+	while (true)
+	{
+		const uint index = nextTask.fetch_add(1);
+
+		if (index >= taskCount)
+			break;
+
+		try
+		{
+			(*pFunc)(index);
+		}
+		catch (...)
+		{
+			std::lock_guard<std::mutex> lock(poolMutex);
+
+			if (pTaskErr == nullptr)
+				pTaskErr = std::current_exception();
+
+			// Skip remaining tasks
+			nextTask = taskCount;
+		}
+	}
+}
+
+void WorkerPool::WorkerMain()
+{
+	ulong lastBatch = 0;
+
+	while (true)
+	{
+		{
+			std::unique_lock<std::mutex> lock(poolMutex);
+			batchStart.wait(lock, [&] { return !canRun || batchID != lastBatch; });
+
+			if (!canRun)
+				return;
+
+			lastBatch = batchID;
+		}
+
+		RunTasks();
+
+		{
+			std::lock_guard<std::mutex> lock(poolMutex);
+			activeWorkers--;
+		}
+
+		batchEnd.notify_one();
+	}
+}